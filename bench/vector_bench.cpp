@@ -0,0 +1,682 @@
+#include <vector>
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <chrono>
+#include <map>
+
+#include "benchmark/benchmark.h"  // google benchmark lib
+#include "vector.h"               // header file for benchmarked container
+#include "concurrent_vector.h"    // header file for benchmarked container
+#include "soa_vector.h"           // header file for benchmarked container
+#include "segmented_vector.h"     // header file for benchmarked container
+#include "flat_map.h"             // header file for benchmarked container
+#include "packed_int_vector.h"    // header file for benchmarked container
+
+// ============================================================================
+// BENCHMARKING sc::vector AGAINST std::vector
+//
+// Every operation runs for sc::vector and std::vector over the same element
+// types and sizes. Results are printed as JSON unless another
+// --benchmark_format is given.
+// ============================================================================
+
+namespace {
+
+    /// Element of 64 bytes, trivially copyable.
+    struct Record
+    {
+        long key;
+        double values[7];
+    };
+
+    //=== Element factories
+    template< typename T > T make( size_t i );
+
+    template<> int make<int>( size_t i )
+    { return (int) i; }
+
+    // Long enough to skip the small string optimization.
+    template<> std::string make<std::string>( size_t i )
+    { return std::string( 32, char( 'a' + i % 26 ) ); }
+
+    template<> Record make<Record>( size_t i )
+    {
+        Record r;
+        r.key = (long) i;
+        for( auto & v : r.values )
+            v = i * 0.5;
+        return r;
+    }
+
+    //=== Operations that differ between the containers
+    template< typename T >
+    void push_front( std::vector<T> & c, const T & value )
+    { c.insert( c.begin(), value ); }
+
+    template< typename T >
+    void push_front( sc::vector<T> & c, const T & value )
+    { c.push_front( value ); }
+
+    template< typename T >
+    void pop_front( std::vector<T> & c )
+    { c.erase( c.begin() ); }
+
+    template< typename T >
+    void pop_front( sc::vector<T> & c )
+    { c.pop_front(); }
+
+    template< typename T, typename It >
+    void append( std::vector<T> & c, It first, It last )
+    { c.insert( c.end(), first, last ); }
+
+    template< typename T, typename It >
+    void append( sc::vector<T> & c, It first, It last )
+    { c.push_back( first, last ); }
+
+    template< typename T >
+    bool contains( const std::vector<T> & c, const T & value )
+    { return std::find( c.begin(), c.end(), value ) != c.end(); }
+
+    template< typename T >
+    bool contains( const sc::vector<T> & c, const T & value )
+    { return c.contains( value ); }
+
+    /// Container holding n elements.
+    template< typename C >
+    C filled( size_t n )
+    {
+        C c;
+        for( size_t i{0u} ; i < n ; ++i )
+            c.push_back( make<typename C::value_type>( i ) );
+        return c;
+    }
+
+    const size_t batch = 64; //!< Elements inserted or erased per iteration.
+
+    //=== Benchmarks
+    template< typename C >
+    void bm_push_back( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        auto value = make<typename C::value_type>( 1 );
+        for( auto _ : state )
+        {
+            C c;
+            for( size_t i{0u} ; i < n ; ++i )
+                c.push_back( value );
+            benchmark::DoNotOptimize( c );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    template< typename C >
+    void bm_push_front( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        auto value = make<typename C::value_type>( 1 );
+        for( auto _ : state )
+        {
+            C c;
+            for( size_t i{0u} ; i < n ; ++i )
+                push_front( c, value );
+            benchmark::DoNotOptimize( c );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    template< typename C >
+    void bm_pop_front( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        for( auto _ : state )
+        {
+            state.PauseTiming();
+            C c = filled<C>( n );
+            state.ResumeTiming();
+
+            while( c.size() != 0 )
+                pop_front( c );
+            benchmark::DoNotOptimize( c );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    template< typename C >
+    void bm_insert( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        auto value = make<typename C::value_type>( 1 );
+        for( auto _ : state )
+        {
+            state.PauseTiming();
+            C c = filled<C>( n );
+            state.ResumeTiming();
+
+            for( size_t i{0u} ; i < batch ; ++i )
+                c.insert( c.begin() + c.size() / 2, value );
+            benchmark::DoNotOptimize( c );
+        }
+        state.SetItemsProcessed( state.iterations() * batch );
+    }
+
+    /// Builds a list of n elements by appending batches.
+    template< typename C >
+    void bm_append( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        std::vector<typename C::value_type> source( batch, make<typename C::value_type>( 1 ) );
+        for( auto _ : state )
+        {
+            C c;
+            for( size_t i{0u} ; i < n ; i += batch )
+                append( c, source.data(), source.data() + batch );
+            benchmark::DoNotOptimize( c );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    template< typename C >
+    void bm_erase( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        for( auto _ : state )
+        {
+            state.PauseTiming();
+            C c = filled<C>( n + batch );
+            state.ResumeTiming();
+
+            for( size_t i{0u} ; i < batch ; ++i )
+                c.erase( c.begin() + c.size() / 2 );
+            benchmark::DoNotOptimize( c );
+        }
+        state.SetItemsProcessed( state.iterations() * batch );
+    }
+
+    template< typename C >
+    void bm_reserve( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        for( auto _ : state )
+        {
+            C c;
+            c.reserve( n );
+            benchmark::DoNotOptimize( c );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    template< typename C >
+    void bm_copy( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        C source = filled<C>( n );
+        for( auto _ : state )
+        {
+            C c( source );
+            benchmark::DoNotOptimize( c );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    template< typename C >
+    void bm_assign( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        C source = filled<C>( n );
+        C c;
+        for( auto _ : state )
+        {
+            c.assign( source.begin(), source.end() );
+            benchmark::DoNotOptimize( c );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    /// Reads every element: the key of a Record, the size of a string.
+    inline long weight( int v ) { return v; }
+    inline long weight( const std::string & v ) { return (long) v.size(); }
+    inline long weight( const Record & v ) { return v.key; }
+
+    template< typename C >
+    void bm_iterate( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        const C c = filled<C>( n );
+        for( auto _ : state )
+        {
+            long sum{0};
+            for( const auto & e : c )
+                sum += weight( e );
+            benchmark::DoNotOptimize( sum );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    /// Searches a value that is not there: the whole list is scanned.
+    template< typename C >
+    void bm_find( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        const C c = filled<C>( n );
+        auto missing = make<typename C::value_type>( n + 1 );
+        for( auto _ : state )
+            benchmark::DoNotOptimize( contains( c, missing ) );
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    template< typename C >
+    void bm_equal( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        const C a = filled<C>( n );
+        const C b = filled<C>( n );
+        for( auto _ : state )
+            benchmark::DoNotOptimize( a == b );
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    //=== One field of wide records
+    /// The fields of a Record, one array each.
+    typedef sc::soa_vector<long, double, double, double, double, double, double, double> RecordColumns;
+
+    /// Sums the keys of n Records stored as structs.
+    void bm_scan_structs( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        const auto c = filled< sc::vector<Record> >( n );
+        for( auto _ : state )
+        {
+            long sum{0};
+            for( const auto & r : c )
+                sum += r.key;
+            benchmark::DoNotOptimize( sum );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    /// Sums the keys of n Records stored as arrays.
+    void bm_scan_columns( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        RecordColumns c;
+        for( size_t i{0u} ; i < n ; ++i )
+            c.emplace_back( (long) i, i * 0.5, i * 0.5, i * 0.5, i * 0.5, i * 0.5, i * 0.5, i * 0.5 );
+        for( auto _ : state )
+        {
+            long sum{0};
+            for( long key : c.column<0>() )
+                sum += key;
+            benchmark::DoNotOptimize( sum );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    //=== Growth latency
+    /// Appends n elements, timing each push_back: the slowest one is reported as worst_us.
+    template< typename C >
+    void bm_worst_push_back( benchmark::State & state )
+    {
+        typedef std::chrono::steady_clock clock;
+        size_t n = state.range( 0 );
+        double worst{0.0};
+        for( auto _ : state )
+        {
+            C c;
+            for( size_t i{0u} ; i < n ; ++i )
+            {
+                clock::time_point start = clock::now();
+                c.push_back( (int) i );
+                std::chrono::duration<double, std::micro> took = clock::now() - start;
+                worst = took.count() > worst ? took.count() : worst;
+            }
+            benchmark::DoNotOptimize( c );
+        }
+        state.counters["worst_us"] = worst;
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    //=== Pruning
+    /// Drops about 30% of n elements, one erase() at a time or in one remove_if() pass.
+    template< bool OnePass >
+    void bm_prune( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        const auto full = filled< sc::vector<int> >( n );
+        auto doomed = []( int v ) { return v % 10 < 3; };
+        for( auto _ : state )
+        {
+            state.PauseTiming();
+            sc::vector<int> c( full );
+            state.ResumeTiming();
+            if( OnePass )
+                c.remove_if( doomed );
+            else
+                for( auto it = c.begin() ; it != c.end() ; )
+                    it = doomed( *it ) ? c.erase( it ) : it + 1;
+            benchmark::DoNotOptimize( c );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    //=== Flags
+    /// n flags, one in every 7 set.
+    template< typename C >
+    C flags( size_t n )
+    {
+        C c;
+        for( size_t i{0u} ; i < n ; ++i )
+            c.push_back( i % 7 == 0 );
+        return c;
+    }
+
+    inline size_t count_set( const std::vector<bool> & c )
+    { return std::count( c.begin(), c.end(), true ); }
+
+    inline size_t count_set( const sc::vector<bool> & c )
+    { return c.count( true ); }
+
+    /// Sums the indexes of the set flags, visiting them one by one.
+    inline size_t visit_set( const std::vector<bool> & c )
+    {
+        size_t sum{0u};
+        for( size_t i{0u} ; i < c.size() ; ++i )
+            if( c[i] )
+                sum += i;
+        return sum;
+    }
+
+    inline size_t visit_set( const sc::vector<bool> & c )
+    {
+        size_t sum{0u};
+        for( size_t i = c.find_first() ; i != c.size() ; i = c.find_next( i ) )
+            sum += i;
+        return sum;
+    }
+
+    /// Counts the set flags of n.
+    template< typename C >
+    void bm_flags_count( benchmark::State & state )
+    {
+        const C c = flags<C>( state.range( 0 ) );
+        for( auto _ : state )
+            benchmark::DoNotOptimize( count_set( c ) );
+        state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+    }
+
+    /// Visits the set flags of n.
+    template< typename C >
+    void bm_flags_scan( benchmark::State & state )
+    {
+        const C c = flags<C>( state.range( 0 ) );
+        for( auto _ : state )
+            benchmark::DoNotOptimize( visit_set( c ) );
+        state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+    }
+
+    //=== Packed integers
+    typedef sc::packed_int_vector<uint64_t> FramePacked;
+    typedef sc::packed_int_vector<uint64_t, sc::packing::delta> DeltaPacked;
+
+    /// n millisecond timestamps, 1 to 64 ms apart.
+    template< typename C >
+    C stamps( size_t n )
+    {
+        C c;
+        uint64_t now = 1700000000000u;
+        for( size_t i{0u} ; i < n ; ++i )
+            c.push_back( now += 1 + ( i * 2654435761u ) % 64 );
+        return c;
+    }
+
+    inline size_t storage_bytes( const sc::vector<uint64_t> & c )
+    { return c.capacity() * sizeof(uint64_t); }
+
+    template< typename P, typename A >
+    size_t storage_bytes( const sc::packed_int_vector<uint64_t, P, A> & c )
+    { return c.storage_bytes(); }
+
+    /// Sums n timestamps through the iterators.
+    template< typename C >
+    void bm_stamps_iterate( benchmark::State & state )
+    {
+        C c = stamps<C>( state.range( 0 ) );
+        c.shrink_to_fit();
+        for( auto _ : state )
+        {
+            uint64_t sum{0u};
+            for( auto it = c.begin() ; it != c.end() ; ++it )
+                sum += *it;
+            benchmark::DoNotOptimize( sum );
+        }
+        state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+        state.counters["bits_per_value"] = 8.0 * storage_bytes( c ) / state.range( 0 );
+    }
+
+    /// Sums n timestamps with for_each(), a block decoded at a time.
+    template< typename C >
+    void bm_stamps_for_each( benchmark::State & state )
+    {
+        C c = stamps<C>( state.range( 0 ) );
+        for( auto _ : state )
+        {
+            uint64_t sum{0u};
+            c.for_each( [&sum]( uint64_t value ) { sum += value; } );
+            benchmark::DoNotOptimize( sum );
+        }
+        state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+    }
+
+    /// Reads n timestamps at scattered indexes.
+    template< typename C >
+    void bm_stamps_random( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        const C c = stamps<C>( n );
+        for( auto _ : state )
+        {
+            uint64_t sum{0u};
+            for( size_t i{0u} ; i < n ; ++i )
+                sum += c[( i * 7919 ) % n];
+            benchmark::DoNotOptimize( sum );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    //=== Sorted lookup tables
+    typedef sc::flat_map<int, int> FlatTable;
+    typedef std::map<int, int> NodeTable;
+
+    /// Table of n even keys.
+    template< typename C >
+    C table( size_t n )
+    {
+        std::vector< std::pair<int, int> > pairs;
+        for( size_t i{0u} ; i < n ; ++i )
+            pairs.emplace_back( (int) ( 2 * i ), (int) i );
+        return C( pairs.begin(), pairs.end() );
+    }
+
+    inline void insert_all( FlatTable & c, const std::vector< std::pair<int, int> > & batch )
+    { c.insert_batch( batch.begin(), batch.end() ); }
+
+    inline void insert_all( NodeTable & c, const std::vector< std::pair<int, int> > & batch )
+    { c.insert( batch.begin(), batch.end() ); }
+
+    /// Inserts a batch of n / 16 new odd keys into a table of n keys: one insert() per key, or one
+    /// insert_batch() for the flat table when Batched.
+    template< typename C, bool Batched >
+    void bm_batch_update( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        const C full = table<C>( n );
+        std::vector< std::pair<int, int> > batch;
+        for( size_t i{0u} ; i < n / 16 ; ++i )
+            batch.emplace_back( (int) ( ( i * 7919 ) % n * 2 + 1 ), 0 );
+
+        for( auto _ : state )
+        {
+            state.PauseTiming();
+            C c( full );
+            state.ResumeTiming();
+            if( Batched )
+                insert_all( c, batch );
+            else
+                for( const auto & p : batch )
+                    c.insert( p );
+            benchmark::DoNotOptimize( c );
+        }
+        state.SetItemsProcessed( state.iterations() * batch.size() );
+    }
+
+    /// Looks up every key of a table of n keys, in a scattered order.
+    template< typename C >
+    void bm_lookup( benchmark::State & state )
+    {
+        size_t n = state.range( 0 );
+        const C c = table<C>( n );
+        for( auto _ : state )
+        {
+            long sum{0};
+            for( size_t i{0u} ; i < n ; ++i )
+                sum += c.find( (int) ( ( i * 7919 ) % n * 2 ) )->second;
+            benchmark::DoNotOptimize( sum );
+        }
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    //=== Shared appends
+    /// List every thread of bm_ingest appends to.
+    sc::vector<int> locked_list;
+    std::mutex locked_lock;
+    sc::concurrent_vector<int> shared_list;
+
+    inline void ingest( sc::vector<int> & list, int value )
+    {
+        std::lock_guard<std::mutex> guard( locked_lock );
+        list.push_back( value );
+    }
+
+    inline void ingest( sc::concurrent_vector<int> & list, int value )
+    { list.push_back( value ); }
+
+    /// Every thread appends n elements per iteration to the same list.
+    template< typename C >
+    void bm_ingest( benchmark::State & state, C & list )
+    {
+        size_t n = state.range( 0 );
+        if( state.thread_index() == 0 )
+            list = C();
+        for( auto _ : state )
+            for( size_t i{0u} ; i < n ; ++i )
+                ingest( list, (int) i );
+        state.SetItemsProcessed( state.iterations() * n );
+    }
+
+    //=== Registration
+    /// Registers every benchmark of container C, labelled name, e.g. "sc::vector<int>".
+    template< typename C >
+    void register_container( const std::string & name )
+    {
+        // Front operations are quadratic on std::vector: they stop at a smaller size.
+        benchmark::RegisterBenchmark( ( "push_back/" + name ).c_str(), &bm_push_back<C> )->Range( 16, 1 << 16 );
+        benchmark::RegisterBenchmark( ( "push_front/" + name ).c_str(), &bm_push_front<C> )->Range( 16, 1 << 14 );
+        benchmark::RegisterBenchmark( ( "pop_front/" + name ).c_str(), &bm_pop_front<C> )->Range( 16, 1 << 14 );
+        benchmark::RegisterBenchmark( ( "insert/" + name ).c_str(), &bm_insert<C> )->Range( 16, 1 << 14 );
+        benchmark::RegisterBenchmark( ( "append/" + name ).c_str(), &bm_append<C> )->Range( 64, 1 << 16 );
+        benchmark::RegisterBenchmark( ( "erase/" + name ).c_str(), &bm_erase<C> )->Range( 16, 1 << 14 );
+        benchmark::RegisterBenchmark( ( "reserve/" + name ).c_str(), &bm_reserve<C> )->Range( 16, 1 << 20 );
+        benchmark::RegisterBenchmark( ( "copy/" + name ).c_str(), &bm_copy<C> )->Range( 16, 1 << 16 );
+        benchmark::RegisterBenchmark( ( "assign/" + name ).c_str(), &bm_assign<C> )->Range( 16, 1 << 16 );
+        benchmark::RegisterBenchmark( ( "iterate/" + name ).c_str(), &bm_iterate<C> )->Range( 16, 1 << 16 );
+    }
+
+    /// Registers the search benchmarks of container C, for element types that have operator==.
+    template< typename C >
+    void register_search( const std::string & name )
+    {
+        benchmark::RegisterBenchmark( ( "find/" + name ).c_str(), &bm_find<C> )->Range( 16, 1 << 20 );
+        benchmark::RegisterBenchmark( ( "equal/" + name ).c_str(), &bm_equal<C> )->Range( 16, 1 << 20 );
+    }
+
+    /// Registers the benchmarks of sc::vector<T> and std::vector<T>, next to each other.
+    template< typename T >
+    void register_type( const std::string & type )
+    {
+        register_container< sc::vector<T> >( "sc::vector<" + type + ">" );
+        register_container< std::vector<T> >( "std::vector<" + type + ">" );
+    }
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+    // glibc serves large blocks with mmap until one of them is freed, then raises the threshold.
+    // Freeing one up front puts both containers under the same allocator state, instead of
+    // charging the page faults to whichever container runs first.
+    void * volatile block = std::malloc( 16 << 20 );
+    std::free( block );
+
+    register_type<int>( "int" );
+    register_type<std::string>( "string" );
+    register_type<Record>( "Record" );
+    register_search< sc::vector<int> >( "sc::vector<int>" );
+    register_search< std::vector<int> >( "std::vector<int>" );
+    register_search< sc::vector<std::string> >( "sc::vector<string>" );
+    register_search< std::vector<std::string> >( "std::vector<string>" );
+
+    benchmark::RegisterBenchmark( "scan_key/sc::vector<Record>", &bm_scan_structs )->Range( 1 << 10, 1 << 22 );
+    benchmark::RegisterBenchmark( "scan_key/sc::soa_vector<Record fields>", &bm_scan_columns )->Range( 1 << 10, 1 << 22 );
+
+    benchmark::RegisterBenchmark( "push_back/sc::segmented_vector<int>", &bm_push_back< sc::segmented_vector<int> > )->Range( 16, 1 << 16 );
+    benchmark::RegisterBenchmark( "iterate/sc::segmented_vector<int>", &bm_iterate< sc::segmented_vector<int> > )->Range( 16, 1 << 16 );
+    benchmark::RegisterBenchmark( "worst_push_back/sc::vector<int>", &bm_worst_push_back< sc::vector<int> > )->Range( 1 << 16, 1 << 24 );
+    benchmark::RegisterBenchmark( "worst_push_back/sc::segmented_vector<int>", &bm_worst_push_back< sc::segmented_vector<int> > )->Range( 1 << 16, 1 << 24 );
+    benchmark::RegisterBenchmark( "prune/erase each sc::vector<int>", &bm_prune<false> )->Range( 1 << 10, 1 << 16 );
+    benchmark::RegisterBenchmark( "prune/remove_if sc::vector<int>", &bm_prune<true> )->Range( 1 << 10, 1 << 16 );
+    benchmark::RegisterBenchmark( "flags_count/std::vector<bool>", &bm_flags_count< std::vector<bool> > )->Range( 1 << 10, 1 << 24 );
+    benchmark::RegisterBenchmark( "flags_count/sc::vector<bool>", &bm_flags_count< sc::vector<bool> > )->Range( 1 << 10, 1 << 24 );
+    benchmark::RegisterBenchmark( "flags_scan/std::vector<bool>", &bm_flags_scan< std::vector<bool> > )->Range( 1 << 10, 1 << 24 );
+    benchmark::RegisterBenchmark( "flags_scan/sc::vector<bool>", &bm_flags_scan< sc::vector<bool> > )->Range( 1 << 10, 1 << 24 );
+    benchmark::RegisterBenchmark( "stamps_iterate/sc::vector<uint64_t>", &bm_stamps_iterate< sc::vector<uint64_t> > )->Range( 1 << 12, 1 << 24 );
+    benchmark::RegisterBenchmark( "stamps_iterate/packed frame", &bm_stamps_iterate<FramePacked> )->Range( 1 << 12, 1 << 24 );
+    benchmark::RegisterBenchmark( "stamps_iterate/packed delta", &bm_stamps_iterate<DeltaPacked> )->Range( 1 << 12, 1 << 24 );
+    benchmark::RegisterBenchmark( "stamps_for_each/packed frame", &bm_stamps_for_each<FramePacked> )->Range( 1 << 12, 1 << 24 );
+    benchmark::RegisterBenchmark( "stamps_for_each/packed delta", &bm_stamps_for_each<DeltaPacked> )->Range( 1 << 12, 1 << 24 );
+    benchmark::RegisterBenchmark( "stamps_random/sc::vector<uint64_t>", &bm_stamps_random< sc::vector<uint64_t> > )->Range( 1 << 12, 1 << 24 );
+    benchmark::RegisterBenchmark( "stamps_random/packed delta", &bm_stamps_random<DeltaPacked> )->Range( 1 << 12, 1 << 24 );
+    benchmark::RegisterBenchmark( "batch_update/sc::flat_map insert", &bm_batch_update<FlatTable, false> )->Range( 1 << 10, 1 << 18 );
+    benchmark::RegisterBenchmark( "batch_update/sc::flat_map insert_batch", &bm_batch_update<FlatTable, true> )->Range( 1 << 10, 1 << 18 );
+    benchmark::RegisterBenchmark( "batch_update/std::map insert", &bm_batch_update<NodeTable, true> )->Range( 1 << 10, 1 << 18 );
+    benchmark::RegisterBenchmark( "lookup/sc::flat_map", &bm_lookup<FlatTable> )->Range( 1 << 10, 1 << 20 );
+    benchmark::RegisterBenchmark( "lookup/std::map", &bm_lookup<NodeTable> )->Range( 1 << 10, 1 << 20 );
+
+    // The lists keep growing, so the iterations are fixed to bound their memory.
+    benchmark::RegisterBenchmark( "ingest/locked sc::vector<int>", &bm_ingest< sc::vector<int> >, std::ref( locked_list ) )
+        ->Arg( 1 << 12 )->Iterations( 200 )->ThreadRange( 1, 16 )->UseRealTime();
+    benchmark::RegisterBenchmark( "ingest/sc::concurrent_vector<int>", &bm_ingest< sc::concurrent_vector<int> >, std::ref( shared_list ) )
+        ->Arg( 1 << 12 )->Iterations( 200 )->ThreadRange( 1, 16 )->UseRealTime();
+
+    // JSON on the standard output, unless the caller chose a format.
+    std::vector<char*> args( argv, argv + argc );
+    bool has_format{false};
+    for( int i{1} ; i < argc ; ++i )
+        if( std::strncmp( argv[i], "--benchmark_format", 18 ) == 0 )
+            has_format = true;
+
+    char json_format[] = "--benchmark_format=json";
+    if( not has_format )
+        args.push_back( json_format );
+
+    int count = (int) args.size();
+    benchmark::Initialize( &count, args.data() );
+    if( benchmark::ReportUnrecognizedArguments( count, args.data() ) )
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#include <sys/mman.h>
+
+#include "vector.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	static constexpr size_t huge_page_size = size_t(2) << 20; //!< Bytes of an x86-64 huge page.
+	static constexpr size_t no_huge_pages = std::numeric_limits<size_t>::max(); //!< Threshold that never uses huge pages.
+
+	/*! \class aligned_allocator
+		\brief allocator whose storage starts on an Alignment byte boundary, with huge pages for large blocks.
+
+		Blocks below HugeThreshold bytes come from posix_memalign. Larger ones are anonymous mappings
+		rounded up to whole huge pages and starting on a huge page boundary, advised with
+		madvise(MADV_HUGEPAGE) so that the kernel backs them with transparent huge pages: one TLB
+		entry then covers 2 MiB instead of 4 KiB. The advice is ignored where the kernel does not
+		support it. The allocator has no state, so all of its instances are equal.
+
+		Used by sc::vector (see aligned_vector), the storage is aligned; the first element is too,
+		unless push_front() or pop_front() left slack in front of it.
+	*/
+	template< typename T, size_t Alignment = 64, size_t HugeThreshold = huge_page_size >
+	class aligned_allocator{
+
+		static_assert( Alignment != 0 and ( Alignment & ( Alignment - 1 ) ) == 0, "the alignment is a power of two" );
+
+		public:
+			//=== Alias
+			typedef T value_type; //!< Type of the elements.
+
+			static constexpr size_t alignment = Alignment < alignof(T) ? alignof(T) : Alignment; //!< Alignment of the storage.
+			static constexpr size_t huge_threshold = HugeThreshold; //!< Bytes from which huge pages are used.
+
+			/// The rebound allocator keeps the alignment and the threshold.
+			template< typename U >
+			struct rebind
+			{ typedef aligned_allocator< U, Alignment, HugeThreshold > other; };
+
+			//=== Constructors
+			aligned_allocator( )
+			{/*empty*/}
+
+			/// Rebinding constructor.
+			template< typename U >
+			aligned_allocator( const aligned_allocator<U, Alignment, HugeThreshold> & )
+			{/*empty*/}
+
+		public:
+			//=== Methods
+			/// Returns storage for n elements, aligned to alignment, or to a huge page if it is large.
+			T * allocate( size_t n )
+			{
+				if( n > std::numeric_limits<size_t>::max() / sizeof(T) )
+					throw std::bad_alloc();
+
+				size_t bytes = n * sizeof(T);
+				if( is_huge( bytes ) )
+					return static_cast<T*>( map_huge( bytes ) );
+
+				void * p = nullptr;
+				size_t align = alignment < sizeof(void*) ? sizeof(void*) : alignment;
+				if( ::posix_memalign( &p, align, bytes != 0 ? bytes : 1 ) != 0 )
+					throw std::bad_alloc();
+				return static_cast<T*>( p );
+			}
+
+			/// Gives back the storage p of n elements.
+			void deallocate( T * p, size_t n )
+			{
+				size_t bytes = n * sizeof(T);
+				if( is_huge( bytes ) )
+					::munmap( p, round_to_huge( bytes ) );
+				else
+					std::free( p );
+			}
+
+			/// Checks whether a block of bytes is served from huge pages.
+			static bool is_huge( size_t bytes )
+			{ return bytes >= HugeThreshold; }
+
+			bool operator==( const aligned_allocator & ) const
+			{ return true; }
+
+			bool operator!=( const aligned_allocator & ) const
+			{ return false; }
+
+		protected:
+			/// Returns bytes rounded up to whole huge pages.
+			static size_t round_to_huge( size_t bytes )
+			{ return ( bytes + huge_page_size - 1 ) / huge_page_size * huge_page_size; }
+
+			/// Maps whole huge pages covering bytes, starting on a huge page boundary.
+			static void * map_huge( size_t bytes )
+			{
+				size_t size = round_to_huge( bytes );
+				if( size < bytes or size > std::numeric_limits<size_t>::max() - huge_page_size )
+					throw std::bad_alloc();
+
+				// Maps a huge page more than needed, then unmaps the unaligned head and the excess tail.
+				size_t span = size + huge_page_size;
+				void * raw = ::mmap( nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+				if( raw == MAP_FAILED )
+					throw std::bad_alloc();
+
+				char * first = static_cast<char*>( raw );
+				size_t head = ( huge_page_size - reinterpret_cast<std::uintptr_t>( first ) % huge_page_size ) % huge_page_size;
+				if( head != 0 )
+					::munmap( first, head );
+				if( span - head - size != 0 )
+					::munmap( first + head + size, span - head - size );
+
+#ifdef MADV_HUGEPAGE
+				::madvise( first + head, size, MADV_HUGEPAGE );
+#endif
+				return first + head;
+			}
+	};
+
+	template< typename T, size_t Alignment, size_t HugeThreshold >
+	constexpr size_t aligned_allocator<T, Alignment, HugeThreshold>::alignment;
+
+	template< typename T, size_t Alignment, size_t HugeThreshold >
+	constexpr size_t aligned_allocator<T, Alignment, HugeThreshold>::huge_threshold;
+
+	/// sc::vector whose storage is aligned to Alignment bytes and uses huge pages from HugeThreshold bytes on.
+	template< typename T, size_t Alignment = 64, size_t HugeThreshold = huge_page_size, typename Growth = growth::doubling >
+	using aligned_vector = vector< T, aligned_allocator<T, Alignment, HugeThreshold>, Growth >;
+
+} // namespace sc
+
+#endif
@@ -0,0 +1,1162 @@
+#ifndef BIT_VECTOR_H
+#define BIT_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \class vector<bool>
+		\brief sc::vector of flags, packed 64 to a word.
+
+		Each flag takes one bit of an array of 64 bit words, an eighth of the storage of one bool
+		per element. operator[] and the iterators hand out reference proxies that read and write
+		one bit; there is no bool& to take, and iterators have no operator->. words() gives the
+		storage itself. The flags keep no front slack: push_front() and pop_front() shift the
+		list a word at a time.
+
+		The bits of the last word past size() are always 0. count(), find_first(), find_next(),
+		operator== and the bitwise operators then work a word at a time: a popcount, a count of
+		trailing zeros or one AND, OR or XOR per 64 flags (see simd::popcount). Capacities are in
+		bits, always a whole number of words.
+	*/
+	template< typename Alloc, typename Growth >
+	class vector< bool, Alloc, Growth >{
+
+		protected:
+			//=== Alias
+			typedef size_t size_type; //!< Type of size.
+
+		public:
+			typedef uint64_t word_type; //!< Storage unit: 64 flags.
+			static constexpr size_type word_bits = 64; //!< Flags per word.
+
+		protected:
+			typedef typename std::allocator_traits<Alloc>::template rebind_alloc<word_type> word_allocator; //!< Allocator of words.
+			typedef std::allocator_traits<word_allocator> alloc_traits; //!< Allocator interface.
+
+		public:
+			class reference;
+			class my_iterator;
+			class my_const_iterator;
+			typedef bool value_type; //!< Type of the elements.
+			typedef bool const_reference; //!< Flags of a constant list are read by value.
+			typedef Alloc allocator_type; //!< Type of the allocator.
+			typedef Growth growth_policy; //!< Growth policy of the storage.
+			typedef my_iterator iterator; //!< Random access iterator.
+			typedef my_const_iterator const_iterator; //!< Random access iterator to const elements.
+
+			//=== Constructors
+			/// Default constructor. Allocates nothing.
+			vector( )
+				: m_words{nullptr}, m_size{0}, m_capacity{0}, m_alloc()
+			{/*empty*/}
+
+			/// Empty vector that will draw its storage from alloc.
+			explicit vector( const Alloc & alloc )
+				: m_words{nullptr}, m_size{0}, m_capacity{0}, m_alloc(alloc)
+			{/*empty*/}
+
+			/// Constructor with a capacity of at least count flags. No flag is added.
+			explicit vector( size_type count, const Alloc & alloc = Alloc() )
+				: m_words{nullptr}, m_size{0}, m_capacity{0}, m_alloc(alloc)
+			{
+				reallocate( words_for( count ) );
+			}
+
+			/// Constructor with the flags in [first, last) range.
+			template< typename InputIt >
+			vector( InputIt first, InputIt last, const Alloc & alloc = Alloc() )
+				: m_words{nullptr}, m_size{0}, m_capacity{0}, m_alloc(alloc)
+			{
+				reallocate( words_for( (size_type)(last - first) ) );
+				for( ; first != last ; ++first )
+					push_back( *first );
+			}
+
+			/// Copy constructor.
+			vector( const vector& other )
+				: m_words{nullptr}, m_size{0}, m_capacity{0},
+				  m_alloc(alloc_traits::select_on_container_copy_construction( other.m_alloc ))
+			{
+				reallocate( other.m_capacity / word_bits );
+				copy_words( other );
+			}
+
+			/// Move constructor. Steals the storage of other, leaving it empty.
+			vector( vector&& other ) noexcept
+				: m_words{other.m_words}, m_size{other.m_size}, m_capacity{other.m_capacity},
+				  m_alloc(std::move( other.m_alloc ))
+			{
+				other.m_words = nullptr;
+				other.m_size = 0;
+				other.m_capacity = 0;
+				note_peaks();
+			}
+
+			/// std::initializer_list copy constructor.
+			vector( std::initializer_list<bool> ilist, const Alloc & alloc = Alloc() )
+				: vector( ilist.begin(), ilist.end(), alloc )
+			{/*empty*/}
+
+			/// Destructor.
+			~vector( )
+			{
+				deallocate( m_words, m_capacity / word_bits );
+			}
+
+			//=== Iterators
+			/// Returns an iterator pointing to the first flag of the list.
+			my_iterator begin()
+			{ return my_iterator( m_words, 0 ); }
+
+			/// Returns an iterator pointing to the position just after the last flag of the list.
+			my_iterator end()
+			{ return my_iterator( m_words, m_size ); }
+
+			/// Returns a constant iterator pointing to the first flag of a constant list.
+			my_const_iterator begin() const
+			{ return cbegin(); }
+
+			/// Returns a constant iterator pointing to the position just after the last flag of a constant list.
+			my_const_iterator end() const
+			{ return cend(); }
+
+			/// Returns a constant iterator pointing to the first flag of the list.
+			my_const_iterator cbegin() const
+			{ return my_const_iterator( m_words, 0 ); }
+
+			/// Returns a constant iterator pointing to the position just after the last flag of the list.
+			my_const_iterator cend() const
+			{ return my_const_iterator( m_words, m_size ); }
+
+			//=== Methods
+			/// Returns the number of flags.
+			size_type size( ) const
+			{ return m_size; }
+
+			/// Returns a copy of the allocator.
+			allocator_type get_allocator( ) const
+			{ return allocator_type( m_alloc ); }
+
+			/// Returns the storage: flag i is bit i % 64 of word i / 64, and the bits past size() are 0.
+			word_type * words( )
+			{ return m_words; }
+
+			const word_type * words( ) const
+			{ return m_words; }
+
+#ifdef SC_VECTOR_INSTRUMENT
+			/// Returns what this vector did with its storage so far.
+			const vector_stats & stats( ) const
+			{ return m_stats; }
+#endif
+
+			/// Removes all flags. The storage is kept.
+			void clear( )
+			{ m_size = 0; }
+
+			/// Checks if the list is empty.
+			bool empty( ) const
+			{ return m_size == 0; }
+
+			/// Adds value to the end of the list.
+			void push_back( bool value )
+			{
+				if( m_size == m_capacity )
+					reallocate( grown_words( m_size + 1 ) );
+
+				size_type w = m_size / word_bits;
+				if( m_size % word_bits == 0 )
+					m_words[w] = value;
+				else if( value )
+					m_words[w] |= bit( m_size );
+				++m_size;
+				note_peaks();
+			}
+
+			/// Adds copies of the flags in the range [first; last) to the end of the list, growing the storage at most once.
+			template< typename InItr >
+			void push_back( InItr first, InItr last )
+			{ insert( end(), first, last ); }
+
+			/// Adds copies of the flags of range, any container with begin() and end(), to the end of the list.
+			template< typename Range >
+			void append_range( const Range & range )
+			{
+				using std::begin;
+				using std::end;
+				push_back( begin( range ), end( range ) );
+			}
+
+			/// Builds a new flag at the end of the list from args.
+			template< typename... Args >
+			reference emplace_back( Args&&... args )
+			{
+				push_back( bool( std::forward<Args>( args )... ) );
+				return (*this)[m_size - 1];
+			}
+
+			/// Adds value to the front of the list. Flags have no front slack: the others are shifted
+			/// up a word at a time, O(size() / 64).
+			void push_front( bool value )
+			{ insert( begin(), value ); }
+
+			/// Builds a new flag at the front of the list from args.
+			template< typename... Args >
+			reference emplace_front( Args&&... args )
+			{
+				push_front( bool( std::forward<Args>( args )... ) );
+				return (*this)[0];
+			}
+
+			/// Removes the flag at the end of the list.
+			void pop_back( )
+			{
+				--m_size;
+				m_words[m_size / word_bits] &= ~bit( m_size );
+			}
+
+			/// Removes the flag at the front of the list, shifting the others down a word at a time.
+			void pop_front( )
+			{ erase( begin() ); }
+
+			/// Returns a proxy to the flag at the end of the list.
+			reference back( )
+			{ return (*this)[m_size - 1]; }
+
+			bool back( ) const
+			{ return (*this)[m_size - 1]; }
+
+			/// Returns a proxy to the flag at the beginning of the list.
+			reference front( )
+			{ return (*this)[0]; }
+
+			bool front( ) const
+			{ return (*this)[0]; }
+
+			/// Replaces the content of the list with count copies of value.
+			void assign( size_type count, bool value )
+			{
+				m_size = 0;
+				if( count > m_capacity )
+					reallocate( words_for( count ) );
+				resize( count, value );
+			}
+
+			/// Replaces the content of the list with the flags in the range [first; last).
+			template< typename InItr >
+			void assign( InItr first, InItr last )
+			{
+				clear();
+				reserve( (size_type)(last - first) );
+				for( ; first != last ; ++first )
+					push_back( *first );
+			}
+
+			/// Replaces the content of the list with the flags in ilist.
+			void assign( std::initializer_list<bool> ilist )
+			{ assign( ilist.begin(), ilist.end() ); }
+
+			/// Returns a proxy to the flag at the index position.
+			reference operator[]( size_type pos )
+			{ return reference( m_words + pos / word_bits, pos % word_bits ); }
+
+			bool operator[]( size_type pos ) const
+			{ return ( m_words[pos / word_bits] & bit( pos ) ) != 0; }
+
+			/// Returns a proxy to the flag at the index pos in the list.
+			reference at( size_type pos )
+			{
+				if( not (pos < m_size) )
+					throw std::out_of_range("error in at(): out of range");
+				return (*this)[pos];
+			}
+
+			bool at( size_type pos ) const
+			{
+				if( not (pos < m_size) )
+					throw std::out_of_range("error in at(): out of range");
+				return (*this)[pos];
+			}
+
+			/// Resizes the list to count flags. New flags are false.
+			void resize( size_type count )
+			{ resize( count, false ); }
+
+			/// Resizes the list to count flags. New flags are value, filled a word at a time.
+			void resize( size_type count, bool value )
+			{
+				if( count <= m_size )
+				{
+					m_size = count;
+					clear_tail();
+					return;
+				}
+
+				if( count > m_capacity )
+					reallocate( grown_words( count ) );
+
+				size_type used = words_for( m_size );
+				if( value and m_size % word_bits != 0 )
+					m_words[used - 1] |= ~word_type(0) << ( m_size % word_bits );
+				for( size_type w = used ; w < words_for( count ) ; ++w )
+					m_words[w] = value ? ~word_type(0) : 0;
+
+				m_size = count;
+				clear_tail();
+				note_peaks();
+			}
+
+			/// Returns the capacity in flags: how many fit without reallocation.
+			size_type capacity( ) const
+			{ return m_capacity; }
+
+			/// Makes room for at least new_cap flags.
+			void reserve( size_type new_cap )
+			{
+				if( new_cap > m_capacity )
+					reallocate( words_for( new_cap ) );
+			}
+
+			/// Gives back the words past the last flag.
+			void shrink_to_fit( )
+			{
+				if( words_for( m_size ) * word_bits != m_capacity )
+					reallocate( words_for( m_size ) );
+			}
+
+			//=== Operators overload
+			/// Operator= overload for vectors
+			vector& operator=( const vector& other )
+			{
+				if( this == &other )
+					return *this;
+
+				if( alloc_traits::propagate_on_container_copy_assignment::value and m_alloc != other.m_alloc )
+				{
+					deallocate( m_words, m_capacity / word_bits );
+					m_words = nullptr;
+					m_size = 0;
+					m_capacity = 0;
+				}
+				copy_allocator( other.m_alloc, typename alloc_traits::propagate_on_container_copy_assignment() );
+
+				m_size = 0;
+				if( other.m_size > m_capacity )
+					reallocate( words_for( other.m_size ) );
+				copy_words( other );
+
+				return *this;
+			}
+
+			/// Move assignment. Releases the current storage and steals the storage of other.
+			vector& operator=( vector&& other )
+				noexcept( alloc_traits::propagate_on_container_move_assignment::value )
+			{
+				if( this != &other )
+					move_assign( other, typename alloc_traits::propagate_on_container_move_assignment() );
+
+				return *this;
+			}
+
+			/// Operator= overload for initializer_list
+			vector& operator=( std::initializer_list<bool> ilist )
+			{
+				assign( ilist );
+				return *this;
+			}
+
+			/// Operator== overload for vectors comparison: one memcmp over the words.
+			bool operator==( const vector& rhs ) const
+			{
+				return m_size == rhs.m_size
+					and ( m_size == 0 or std::memcmp( m_words, rhs.m_words, words_for( m_size ) * sizeof(word_type) ) == 0 );
+			}
+
+			/// Operator!= overload for vectors comparison
+			bool operator!=( const vector& rhs ) const
+			{ return not( *this == rhs ); }
+
+			/// Keeps the flags set in both lists. The lists must have the same size.
+			vector& operator&=( const vector& rhs )
+			{
+				check_size( rhs, "error in operator&=(): the lists differ in size" );
+				for( size_type w{0u} ; w < words_for( m_size ) ; ++w )
+					m_words[w] &= rhs.m_words[w];
+				return *this;
+			}
+
+			/// Sets the flags set in rhs. The lists must have the same size.
+			vector& operator|=( const vector& rhs )
+			{
+				check_size( rhs, "error in operator|=(): the lists differ in size" );
+				for( size_type w{0u} ; w < words_for( m_size ) ; ++w )
+					m_words[w] |= rhs.m_words[w];
+				return *this;
+			}
+
+			/// Flips the flags set in rhs. The lists must have the same size.
+			vector& operator^=( const vector& rhs )
+			{
+				check_size( rhs, "error in operator^=(): the lists differ in size" );
+				for( size_type w{0u} ; w < words_for( m_size ) ; ++w )
+					m_words[w] ^= rhs.m_words[w];
+				return *this;
+			}
+
+			//=== Operations
+			/// Inserts value before pos: the flags from pos on are shifted up a word at a time.
+			/// Returns an iterator to the new flag.
+			my_iterator insert( my_iterator pos, bool value )
+			{
+				size_type posi = pos - begin();
+				if( m_size == m_capacity )
+					reallocate( grown_words( m_size + 1 ) );
+
+				size_type first = posi / word_bits;
+				size_type last = m_size / word_bits;
+				if( m_size % word_bits == 0 )
+					m_words[last] = 0;
+				for( size_type w = last ; w > first ; --w )
+					m_words[w] = ( m_words[w] << 1 ) | ( m_words[w - 1] >> ( word_bits - 1 ) );
+
+				word_type below = bit( posi ) - 1;
+				m_words[first] = ( m_words[first] & below ) | ( ( m_words[first] & ~below ) << 1 );
+				if( value )
+					m_words[first] |= bit( posi );
+				++m_size;
+				note_peaks();
+
+				return my_iterator( m_words, posi );
+			}
+
+			/// Inserts the flags in [first, last) before pos: the flags from pos on are moved up once,
+			/// a word at a time. Returns an iterator to the first inserted flag.
+			template< typename InItr >
+			my_iterator insert( my_iterator pos, InItr first, InItr last )
+			{
+				size_type posi = pos - begin();
+				// Packed first: the range may be read through proxies into this list, which growth moves.
+				vector flags( first, last, get_allocator() );
+				insert_flags( posi, flags );
+				return my_iterator( m_words, posi );
+			}
+
+			/// Inserts the flags of ilist before pos. Returns an iterator to the first inserted flag.
+			my_iterator insert( my_iterator pos, std::initializer_list<bool> ilist )
+			{ return insert( pos, ilist.begin(), ilist.end() ); }
+
+			/// Inserts a flag built from args before pos. Returns an iterator to the new flag.
+			template< typename... Args >
+			my_iterator emplace( my_iterator pos, Args&&... args )
+			{ return insert( pos, bool( std::forward<Args>( args )... ) ); }
+
+			/// Removes the flag at position pos. Returns an iterator to the flag that follows pos before the call.
+			my_iterator erase( my_iterator pos )
+			{ return erase( pos, pos + 1 ); }
+
+			/// Removes the flags in the range [first; last), moving the tail down a word at a time.
+			/// Returns an iterator to the flag that follows the range.
+			my_iterator erase( my_iterator first, my_iterator last )
+			{
+				size_type posi = first - begin();
+				size_type count = last - first;
+				move_down( posi + count, posi, m_size - posi - count );
+
+				m_size -= count;
+				clear_tail();
+				return my_iterator( m_words, posi );
+			}
+
+			/// Removes the flag at position pos in O(1), by copying the last flag into its place:
+			/// the order of the list is not kept. Returns an iterator to the flag now at pos.
+			my_iterator unordered_erase( my_iterator pos )
+			{
+				size_type posi = pos - begin();
+				(*this)[posi] = (*this)[m_size - 1];
+				pop_back();
+				return my_iterator( m_words, posi );
+			}
+
+			/// Removes every flag for which pred returns true, in one pass. Returns the number of removed flags.
+			template< typename Pred >
+			size_type remove_if( Pred pred )
+			{
+				size_type kept{0u};
+				for( size_type i{0u} ; i < m_size ; ++i )
+				{
+					bool value = (*this)[i];
+					if( not pred( value ) )
+						(*this)[kept++] = value;
+				}
+
+				size_type removed = m_size - kept;
+				m_size = kept;
+				clear_tail();
+				return removed;
+			}
+
+			/// Removes the flags at the indices in [first, last), sorted in increasing order (an index may
+			/// repeat); the runs between them move down a word at a time. Throws std::invalid_argument, and
+			/// removes nothing, if the indices are not sorted or not below size(). Returns the number of removed flags.
+			template< typename ForwardIt >
+			size_type erase_indices( ForwardIt first, ForwardIt last )
+			{
+				size_type previous{0u};
+				for( ForwardIt it = first ; it != last ; ++it )
+				{
+					size_type index = *it;
+					if( not ( index < m_size ) )
+						throw std::invalid_argument("error in erase_indices(): index out of range");
+					if( index < previous )
+						throw std::invalid_argument("error in erase_indices(): indices not sorted");
+					previous = index;
+				}
+
+				size_type kept{0u};
+				size_type next{0u};
+				for( ; first != last ; ++first )
+				{
+					size_type index = *first;
+					if( index < next )
+						continue;
+					move_down( next, kept, index - next );
+					kept += index - next;
+					next = index + 1;
+				}
+				move_down( next, kept, m_size - next );
+				kept += m_size - next;
+
+				size_type removed = m_size - kept;
+				m_size = kept;
+				clear_tail();
+				return removed;
+			}
+
+			/// Removes the flags at the sorted indices of range, any container with begin() and end().
+			template< typename Range >
+			size_type erase_indices( const Range & indices )
+			{
+				using std::begin;
+				using std::end;
+				return erase_indices( begin( indices ), end( indices ) );
+			}
+
+			/// Removes the flags at the sorted indices of ilist.
+			size_type erase_indices( std::initializer_list< size_type > ilist )
+			{ return erase_indices( ilist.begin(), ilist.end() ); }
+
+			/// Removes every flag equal to value. Returns the number of removed flags.
+			size_type remove( bool value )
+			{
+				size_type removed = count( value );
+				assign( m_size - removed, not value );
+				return removed;
+			}
+
+			/// Inverts every flag.
+			void flip( )
+			{
+				for( size_type w{0u} ; w < words_for( m_size ) ; ++w )
+					m_words[w] = ~m_words[w];
+				clear_tail();
+			}
+
+			//=== Search
+			// The flags are scanned a word at a time.
+			/// Returns an iterator to the first flag equal to value, or end().
+			my_iterator find( bool value )
+			{ return my_iterator( m_words, scan( 0, value ) ); }
+
+			/// Returns a constant iterator to the first flag equal to value, or end().
+			my_const_iterator find( bool value ) const
+			{ return my_const_iterator( m_words, scan( 0, value ) ); }
+
+			/// Returns how many flags are equal to value, with one popcount per word.
+			size_type count( bool value ) const
+			{
+				size_type set = simd::popcount( m_words, words_for( m_size ) );
+				return value ? set : m_size - set;
+			}
+
+			/// Checks if a flag is equal to value.
+			bool contains( bool value ) const
+			{ return scan( 0, value ) != m_size; }
+
+			/// Returns the index of the first set flag, or size() if there is none.
+			size_type find_first( ) const
+			{ return scan( 0, true ); }
+
+			/// Returns the index of the first set flag after pos, or size() if there is none.
+			size_type find_next( size_type pos ) const
+			{ return scan( pos + 1, true ); }
+
+			/// Returns the smallest flag: false if any flag is. The list must not be empty.
+			bool min( ) const
+			{ return not contains( false ); }
+
+			/// Returns the largest flag: true if any flag is. The list must not be empty.
+			bool max( ) const
+			{ return contains( true ); }
+
+		protected:
+			//=== Bit helpers
+			/// Returns the number of words that hold n flags.
+			static size_type words_for( size_type n )
+			{ return ( n + word_bits - 1 ) / word_bits; }
+
+			/// Returns the mask of the flag pos in its word.
+			static word_type bit( size_type pos )
+			{ return word_type(1) << ( pos % word_bits ); }
+
+			/// Zeroes the bits of the last word past size().
+			void clear_tail( )
+			{
+				if( m_size % word_bits != 0 )
+					m_words[m_size / word_bits] &= bit( m_size ) - 1;
+			}
+
+			/// Returns the count flags from pos on, in the low bits. count is at most 64.
+			word_type read_bits( size_type pos, size_type count ) const
+			{
+				size_type w = pos / word_bits;
+				size_type offset = pos % word_bits;
+				word_type value = m_words[w] >> offset;
+				if( offset + count > word_bits )
+					value |= m_words[w + 1] << ( word_bits - offset );
+				return count == word_bits ? value : value & ( ( word_type(1) << count ) - 1 );
+			}
+
+			/// Overwrites the count flags from pos on, which lie in one word, with the low bits of value.
+			void write_bits( size_type pos, size_type count, word_type value )
+			{
+				word_type mask = count == word_bits ? ~word_type(0) : ( ( word_type(1) << count ) - 1 ) << ( pos % word_bits );
+				word_type & word = m_words[pos / word_bits];
+				word = ( word & ~mask ) | ( ( value << ( pos % word_bits ) ) & mask );
+			}
+
+			/// Copies the count flags from src down to dest, below src, from the first one up.
+			void move_down( size_type src, size_type dest, size_type count )
+			{
+				if( src == dest )
+					return;
+				for( size_type done{0u} ; done < count ; )
+				{
+					size_type chunk = word_bits - ( dest + done ) % word_bits;
+					if( chunk > count - done )
+						chunk = count - done;
+					write_bits( dest + done, chunk, read_bits( src + done, chunk ) );
+					done += chunk;
+				}
+			}
+
+			/// Copies the count flags from src up to dest, above src, from the last one down.
+			void move_up( size_type src, size_type dest, size_type count )
+			{
+				for( size_type left = count ; left != 0 ; )
+				{
+					size_type chunk = ( dest + left ) % word_bits != 0 ? ( dest + left ) % word_bits : word_bits;
+					if( chunk > left )
+						chunk = left;
+					left -= chunk;
+					write_bits( dest + left, chunk, read_bits( src + left, chunk ) );
+				}
+			}
+
+			/// Inserts the flags of other at index pos: the tail moves up by their count once, then they
+			/// are written into the gap, a word at a time.
+			void insert_flags( size_type pos, const vector & other )
+			{
+				size_type count = other.m_size;
+				if( count == 0 )
+					return;
+
+				if( m_size + count > m_capacity )
+					reallocate( grown_words( m_size + count ) );
+				for( size_type w = words_for( m_size ) ; w < words_for( m_size + count ) ; ++w )
+					m_words[w] = 0;
+
+				move_up( pos, pos + count, m_size - pos );
+				for( size_type done{0u} ; done < count ; )
+				{
+					size_type chunk = word_bits - ( pos + done ) % word_bits;
+					if( chunk > count - done )
+						chunk = count - done;
+					write_bits( pos + done, chunk, other.read_bits( done, chunk ) );
+					done += chunk;
+				}
+
+				m_size += count;
+				clear_tail();
+				note_peaks();
+			}
+
+			/// Returns the index of the first flag equal to value from pos on, or size(). Words without
+			/// a match are skipped whole, then the count of trailing zeros gives the flag.
+			size_type scan( size_type pos, bool value ) const
+			{
+				if( pos >= m_size )
+					return m_size;
+
+				word_type invert = value ? 0 : ~word_type(0);
+				size_type w = pos / word_bits;
+				size_type used = words_for( m_size );
+				word_type x = ( m_words[w] ^ invert ) & ( ~word_type(0) << ( pos % word_bits ) );
+				while( x == 0 )
+				{
+					if( ++w == used )
+						return m_size;
+					x = m_words[w] ^ invert;
+				}
+
+				// Searching false, the zeroed tail of the last word reads as a match: clamp it.
+				size_type found = w * word_bits + __builtin_ctzll( x );
+				return found < m_size ? found : m_size;
+			}
+
+			/// Throws std::invalid_argument with message unless rhs has as many flags as this list.
+			void check_size( const vector& rhs, const char * message ) const
+			{
+				if( rhs.m_size != m_size )
+					throw std::invalid_argument( message );
+			}
+
+			//=== Storage helpers
+			/// Number of words to grow to when at least required flags must fit.
+			size_type grown_words( size_type required ) const
+			{
+				size_type words = words_for( required );
+				size_type new_words = Growth::grow( m_capacity / word_bits, words, sizeof(word_type) );
+				return new_words < words ? words : new_words;
+			}
+
+			/// Moves the flags into a new storage of n words, or frees the storage if n is 0.
+			void reallocate( size_type n )
+			{
+				word_type * new_words = nullptr;
+				if( n != 0 )
+				{
+					new_words = alloc_traits::allocate( m_alloc, n );
+					note_allocate( n );
+				}
+				if( m_size != 0 )
+					std::memcpy( new_words, m_words, words_for( m_size ) * sizeof(word_type) );
+
+				if( m_words != nullptr )
+				{
+					deallocate( m_words, m_capacity / word_bits );
+					note_reallocation();
+				}
+				m_words = new_words;
+				m_capacity = n * word_bits;
+				note_peaks();
+			}
+
+			/// Gives back the storage p of n words.
+			void deallocate( word_type * p, size_type n )
+			{
+				if( p != nullptr )
+				{
+					alloc_traits::deallocate( m_alloc, p, n );
+					note_deallocate( n );
+				}
+			}
+
+			/// Copies the flags of other over this list, whose capacity must hold them.
+			void copy_words( const vector& other )
+			{
+				if( other.m_size != 0 )
+					std::memcpy( m_words, other.m_words, words_for( other.m_size ) * sizeof(word_type) );
+				m_size = other.m_size;
+				note_peaks();
+			}
+
+			/// Takes the allocator of other when the allocator propagates on copy assignment.
+			void copy_allocator( const word_allocator & other, std::true_type )
+			{ m_alloc = other; }
+
+			void copy_allocator( const word_allocator &, std::false_type )
+			{/*empty*/}
+
+			/// Move assignment when the allocator propagates: the storage of other is always stolen.
+			void move_assign( vector & other, std::true_type )
+			{
+				deallocate( m_words, m_capacity / word_bits );
+				m_alloc = std::move( other.m_alloc );
+				steal( other );
+			}
+
+			/// Move assignment when the allocator stays: the flags are copied if the allocators differ.
+			void move_assign( vector & other, std::false_type )
+			{
+				if( m_alloc == other.m_alloc )
+				{
+					deallocate( m_words, m_capacity / word_bits );
+					steal( other );
+				}
+				else
+				{
+					*this = static_cast<const vector&>( other );
+					other.clear();
+				}
+			}
+
+			/// Takes the storage of other, leaving it empty.
+			void steal( vector & other )
+			{
+				m_words = other.m_words;
+				m_size = other.m_size;
+				m_capacity = other.m_capacity;
+
+				other.m_words = nullptr;
+				other.m_size = 0;
+				other.m_capacity = 0;
+			}
+
+			//=== Instrumentation hooks: empty unless SC_VECTOR_INSTRUMENT is defined.
+			/// Counts a storage of n words drawn from the allocator.
+			void note_allocate( size_type n )
+			{
+#ifdef SC_VECTOR_INSTRUMENT
+				m_stats.allocations++;
+				m_stats.bytes_allocated += n * sizeof(word_type);
+				instrument::shared().allocations++;
+				instrument::shared().bytes_allocated += n * sizeof(word_type);
+#endif
+			}
+
+			/// Counts a storage of n words given back to the allocator.
+			void note_deallocate( size_type n )
+			{
+#ifdef SC_VECTOR_INSTRUMENT
+				m_stats.bytes_freed += n * sizeof(word_type);
+				instrument::shared().bytes_freed += n * sizeof(word_type);
+#endif
+			}
+
+			/// Counts a storage that replaced the previous one.
+			void note_reallocation( )
+			{
+#ifdef SC_VECTOR_INSTRUMENT
+				m_stats.reallocations++;
+				instrument::shared().reallocations++;
+#endif
+			}
+
+			/// Records the current capacity and size, in flags, if they are the largest so far.
+			void note_peaks( )
+			{
+#ifdef SC_VECTOR_INSTRUMENT
+				if( m_capacity > m_stats.peak_capacity )
+				{
+					m_stats.peak_capacity = m_capacity;
+					instrument::raise( instrument::shared().peak_capacity, m_capacity );
+				}
+				if( m_size > m_stats.peak_size )
+				{
+					m_stats.peak_size = m_size;
+					instrument::raise( instrument::shared().peak_size, m_size );
+				}
+#endif
+			}
+
+		protected:
+			word_type * m_words; //!< Storage, flag i is bit i % 64 of word i / 64.
+			size_type m_size; //!< Number of flags.
+			size_type m_capacity; //!< Flags that fit in the storage, a multiple of 64.
+			word_allocator m_alloc; //!< Allocator that provides the words.
+#ifdef SC_VECTOR_INSTRUMENT
+			vector_stats m_stats; //!< Counters of this vector.
+#endif
+
+		public:
+
+		/*! \class reference
+
+			Proxy to one flag: reads as a bool and writes the bit through assignment.
+		*/
+		class reference{
+			private:
+				word_type * m_word; //!< Word that holds the flag.
+				word_type m_mask; //!< Bit of the flag in the word.
+
+			public:
+				//=== Constructor
+				reference( word_type * word, size_type bit )
+					: m_word{word}, m_mask{word_type(1) << bit}
+				{/*empty*/}
+
+				//=== Operators
+				operator bool() const
+				{ return ( *m_word & m_mask ) != 0; }
+
+				reference& operator=( bool value )
+				{
+					if( value )
+						*m_word |= m_mask;
+					else
+						*m_word &= ~m_mask;
+					return *this;
+				}
+
+				/// Copies the flag other refers to, not the proxy.
+				reference& operator=( const reference& other )
+				{ return *this = bool( other ); }
+
+				bool operator~() const
+				{ return not bool( *this ); }
+
+				/// Inverts the flag.
+				void flip()
+				{ *m_word ^= m_mask; }
+
+				/// Swaps the flags two proxies refer to.
+				friend void swap( reference a, reference b )
+				{
+					bool value = a;
+					a = bool( b );
+					b = value;
+				}
+
+				friend void swap( reference a, bool & b )
+				{
+					bool value = a;
+					a = b;
+					b = value;
+				}
+
+				friend void swap( bool & a, reference b )
+				{ swap( b, a ); }
+		}; // class reference
+
+
+		/*! \class my_iterator
+
+			Random access iterator over the flags: the storage and the index of a flag.
+		*/
+		class my_iterator{
+			private:
+				word_type * m_words; //!< Storage of the list.
+				std::ptrdiff_t m_pos; //!< Index of the flag.
+				typedef my_iterator iterator;
+				friend class my_const_iterator;
+
+			public:
+				//=== Alias
+				typedef size_t size_type; //!< Type of size.
+				typedef std::ptrdiff_t difference_type; //!< Distance between two iterators.
+				typedef bool value_type; //!< Type of the pointed element.
+				typedef void pointer; //!< Flags have no address.
+				typedef vector::reference reference; //!< Proxy to the flag.
+				typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+
+				//=== Constructor
+				my_iterator( word_type * words = nullptr, difference_type pos = 0 )
+					: m_words{words}, m_pos{pos}
+				{/*empty*/}
+
+			public:
+				//=== Operators
+				iterator& operator++(void)
+				{ ++m_pos; return *this; }
+
+				iterator operator++(int)
+				{
+					iterator temp( *this );
+					++m_pos;
+					return temp;
+				}
+
+				reference operator*() const
+				{ return reference( m_words + m_pos / word_bits, m_pos % word_bits ); }
+
+				reference operator[]( difference_type n ) const
+				{ return *( *this + n ); }
+
+				iterator& operator--(void)
+				{ --m_pos; return *this; }
+
+				iterator operator--(int)
+				{
+					iterator temp( *this );
+					--m_pos;
+					return temp;
+				}
+
+				iterator& operator+=( difference_type n )
+				{ m_pos += n; return *this; }
+
+				iterator& operator-=( difference_type n )
+				{ m_pos -= n; return *this; }
+
+				friend iterator operator+(difference_type n, iterator it)
+				{ return iterator( it.m_words, it.m_pos + n ); }
+
+				friend iterator operator+(iterator it, difference_type n)
+				{ return iterator( it.m_words, it.m_pos + n ); }
+
+				friend iterator operator-(iterator it, difference_type n)
+				{ return iterator( it.m_words, it.m_pos - n ); }
+
+				friend difference_type operator-(iterator it1, iterator it2)
+				{ return it1.m_pos - it2.m_pos; }
+
+				bool operator==( const iterator& it2) const
+				{ return m_pos == it2.m_pos; }
+
+				bool operator!=( const iterator& it2) const
+				{ return m_pos != it2.m_pos; }
+
+				bool operator<( const iterator& it2) const
+				{ return m_pos < it2.m_pos; }
+
+				bool operator>( const iterator& it2) const
+				{ return m_pos > it2.m_pos; }
+
+				bool operator<=( const iterator& it2) const
+				{ return m_pos <= it2.m_pos; }
+
+				bool operator>=( const iterator& it2) const
+				{ return m_pos >= it2.m_pos; }
+		}; // class my_iterator
+
+
+		/*! \class my_const_iterator
+
+			Random access iterator over the flags of a constant list. Any my_iterator converts to it.
+		*/
+		class my_const_iterator{
+			private:
+				const word_type * m_words; //!< Storage of the list.
+				std::ptrdiff_t m_pos; //!< Index of the flag.
+				typedef my_const_iterator iterator;
+
+			public:
+				//=== Alias
+				typedef size_t size_type; //!< Type of size.
+				typedef std::ptrdiff_t difference_type; //!< Distance between two iterators.
+				typedef bool value_type; //!< Type of the pointed element.
+				typedef void pointer; //!< Flags have no address.
+				typedef bool reference; //!< Flags are read by value.
+				typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+
+				//=== Constructor
+				my_const_iterator( const word_type * words = nullptr, difference_type pos = 0 )
+					: m_words{words}, m_pos{pos}
+				{/*empty*/}
+
+				/// Conversion from a mutable iterator.
+				my_const_iterator( const my_iterator& other )
+					: m_words{other.m_words}, m_pos{other.m_pos}
+				{/*empty*/}
+
+			public:
+				//=== Operators
+				iterator& operator++(void)
+				{ ++m_pos; return *this; }
+
+				iterator operator++(int)
+				{
+					iterator temp( *this );
+					++m_pos;
+					return temp;
+				}
+
+				bool operator*() const
+				{ return ( m_words[m_pos / word_bits] & bit( m_pos ) ) != 0; }
+
+				bool operator[]( difference_type n ) const
+				{ return *( *this + n ); }
+
+				iterator& operator--(void)
+				{ --m_pos; return *this; }
+
+				iterator operator--(int)
+				{
+					iterator temp( *this );
+					--m_pos;
+					return temp;
+				}
+
+				iterator& operator+=( difference_type n )
+				{ m_pos += n; return *this; }
+
+				iterator& operator-=( difference_type n )
+				{ m_pos -= n; return *this; }
+
+				friend iterator operator+(difference_type n, iterator it)
+				{ return iterator( it.m_words, it.m_pos + n ); }
+
+				friend iterator operator+(iterator it, difference_type n)
+				{ return iterator( it.m_words, it.m_pos + n ); }
+
+				friend iterator operator-(iterator it, difference_type n)
+				{ return iterator( it.m_words, it.m_pos - n ); }
+
+				friend difference_type operator-(iterator it1, iterator it2)
+				{ return it1.m_pos - it2.m_pos; }
+
+				friend bool operator==( const iterator& it1, const iterator& it2 )
+				{ return it1.m_pos == it2.m_pos; }
+
+				friend bool operator!=( const iterator& it1, const iterator& it2 )
+				{ return it1.m_pos != it2.m_pos; }
+
+				friend bool operator<( const iterator& it1, const iterator& it2 )
+				{ return it1.m_pos < it2.m_pos; }
+
+				friend bool operator>( const iterator& it1, const iterator& it2 )
+				{ return it1.m_pos > it2.m_pos; }
+
+				friend bool operator<=( const iterator& it1, const iterator& it2 )
+				{ return it1.m_pos <= it2.m_pos; }
+
+				friend bool operator>=( const iterator& it1, const iterator& it2 )
+				{ return it1.m_pos >= it2.m_pos; }
+		}; // class my_const_iterator
+
+	}; // class vector<bool>
+
+	/// Returns the flags set in both lhs and rhs. The lists must have the same size.
+	template< typename Alloc, typename Growth >
+	vector<bool, Alloc, Growth> operator&( const vector<bool, Alloc, Growth> & lhs, const vector<bool, Alloc, Growth> & rhs )
+	{
+		vector<bool, Alloc, Growth> result( lhs );
+		result &= rhs;
+		return result;
+	}
+
+	/// Returns the flags set in lhs or in rhs. The lists must have the same size.
+	template< typename Alloc, typename Growth >
+	vector<bool, Alloc, Growth> operator|( const vector<bool, Alloc, Growth> & lhs, const vector<bool, Alloc, Growth> & rhs )
+	{
+		vector<bool, Alloc, Growth> result( lhs );
+		result |= rhs;
+		return result;
+	}
+
+	/// Returns the flags set in exactly one of lhs and rhs. The lists must have the same size.
+	template< typename Alloc, typename Growth >
+	vector<bool, Alloc, Growth> operator^( const vector<bool, Alloc, Growth> & lhs, const vector<bool, Alloc, Growth> & rhs )
+	{
+		vector<bool, Alloc, Growth> result( lhs );
+		result ^= rhs;
+		return result;
+	}
+
+} // namespace sc
+
+#endif
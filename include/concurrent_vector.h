@@ -0,0 +1,452 @@
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+
+#include <cstddef>
+#include <atomic>
+#include <initializer_list>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \class concurrent_vector
+		\brief growable list that many threads may append to and read at once.
+
+		The elements live in segments that double in size: segment k holds first_segment * 2^k
+		elements and is never moved nor freed while the list lives, so references, pointers and
+		indices to an element stay valid however much the list grows.
+
+		push_back(), emplace_back(), grow_by() and reserve() may be called by any number of threads
+		at once and never take a lock: each call claims its indices with an atomic counter and,
+		if their segment is missing, allocates it and installs it with a compare-and-swap (the
+		losers of a race give theirs back). operator[], at() and the iterators may run alongside them.
+
+		size() counts the claimed indices, some of which may still be under construction. An element
+		may be read once the call that appended it has returned and that is known to the reader,
+		e.g. by the index it returned. Copying, assignment, clear() and swap() are not concurrent.
+
+		If constructing an element throws, the exception reaches the caller and the slots it claimed
+		stay empty: they must not be read, and the destructor, clear() and copies skip them.
+		The allocator must be safe to use from several threads.
+	*/
+	template< typename T, typename Alloc = std::allocator<T> >
+	class concurrent_vector{
+
+		public:
+			//=== Alias
+			typedef size_t size_type; //!< Type of size.
+			typedef T value_type; //!< Type of the elements.
+			typedef Alloc allocator_type; //!< Type of the allocator.
+
+			template< typename V, typename R >
+			class basic_iterator;
+			typedef basic_iterator< concurrent_vector, T > iterator; //!< Random access iterator.
+			typedef basic_iterator< const concurrent_vector, const T > const_iterator; //!< Random access iterator to const elements.
+
+			static constexpr size_type first_segment = 8; //!< Elements of the first segment, a power of two.
+
+		protected:
+			typedef std::allocator_traits<Alloc> alloc_traits; //!< Allocator interface.
+			static constexpr size_type max_segments = 64; //!< Segments that cover every index.
+
+		public:
+			//=== Constructors
+			/// Empty list. Allocates nothing.
+			explicit concurrent_vector( const Alloc & alloc = Alloc() )
+				: m_size{0}, m_alloc(alloc)
+			{
+				for( auto & segment : m_segments )
+					segment.store( nullptr, std::memory_order_relaxed );
+			}
+
+			/// List of count copies of value.
+			concurrent_vector( size_type count, const T & value, const Alloc & alloc = Alloc() )
+				: concurrent_vector( alloc )
+			{ grow_by( count, value ); }
+
+			/// List of the elements of ilist.
+			concurrent_vector( std::initializer_list<T> ilist, const Alloc & alloc = Alloc() )
+				: concurrent_vector( alloc )
+			{ grow_by( ilist.begin(), ilist.end() ); }
+
+			/// Copy constructor. Must not run while other grows.
+			concurrent_vector( const concurrent_vector & other )
+				: concurrent_vector( alloc_traits::select_on_container_copy_construction( other.m_alloc ) )
+			{
+				reserve( other.live_size() );
+				other.for_each_live( [this, &other]( size_type i ) { emplace_back( other[i] ); } );
+			}
+
+			/// Move constructor. Steals the segments of other, leaving it empty.
+			concurrent_vector( concurrent_vector && other ) noexcept
+				: concurrent_vector( other.m_alloc )
+			{ swap( other ); }
+
+			/// Destructor. Must not run while other threads use the list.
+			~concurrent_vector( )
+			{
+				clear();
+				for( size_type k{0u} ; k < max_segments ; ++k )
+				{
+					T * segment = m_segments[k].load( std::memory_order_relaxed );
+					if( segment != nullptr )
+						alloc_traits::deallocate( m_alloc, segment, segment_size( k ) );
+				}
+			}
+
+		public:
+			//=== Concurrent methods
+			/// Appends a copy of value. Returns its index.
+			size_type push_back( const T & value )
+			{ return emplace_back( value ); }
+
+			/// Appends value, moved. Returns its index.
+			size_type push_back( T && value )
+			{ return emplace_back( std::move( value ) ); }
+
+			/// Appends an element constructed from args. Returns its index.
+			template< typename... Args >
+			size_type emplace_back( Args&&... args )
+			{
+				size_type index = m_size.fetch_add( 1, std::memory_order_relaxed );
+
+				// The index is claimed: if its segment cannot be allocated either, it stays empty.
+				try
+				{
+					T * slot = &segment_for( segment_of( index ) )[ offset_of( index ) ];
+					alloc_traits::construct( m_alloc, slot, std::forward<Args>( args )... );
+				}
+				catch( ... ) { mark_empty( index, index + 1 ); throw; }
+
+				return index;
+			}
+
+			/// Appends count value-initialized elements. Returns the index of the first one.
+			size_type grow_by( size_type count )
+			{ return append( count, [this]( T * slot, size_type ) { alloc_traits::construct( m_alloc, slot ); } ); }
+
+			/// Appends count copies of value. Returns the index of the first one.
+			size_type grow_by( size_type count, const T & value )
+			{ return append( count, [this, &value]( T * slot, size_type ) { alloc_traits::construct( m_alloc, slot, value ); } ); }
+
+			/// Appends copies of the elements in [first, last), which must be forward iterators.
+			/// Returns the index of the first one.
+			template< typename ForwardIt, typename = typename std::enable_if<
+				not std::is_integral<ForwardIt>::value >::type >
+			size_type grow_by( ForwardIt first, ForwardIt last )
+			{
+				ForwardIt source = first;
+				return append( (size_type) std::distance( first, last ), [this, &source]( T * slot, size_type ) {
+					alloc_traits::construct( m_alloc, slot, *source );
+					++source;
+				} );
+			}
+
+			/// Allocates the segments that hold the first count elements.
+			void reserve( size_type count )
+			{
+				if( count != 0 )
+					for( size_type k{0u} ; k <= segment_of( count - 1 ) ; ++k )
+						segment_for( k );
+			}
+
+			/// Returns the element at index pos.
+			T & operator[]( size_type pos )
+			{ return m_segments[ segment_of( pos ) ].load( std::memory_order_acquire )[ offset_of( pos ) ]; }
+
+			const T & operator[]( size_type pos ) const
+			{ return m_segments[ segment_of( pos ) ].load( std::memory_order_acquire )[ offset_of( pos ) ]; }
+
+			/// Returns the element at index pos. Throws std::out_of_range if pos is not below size().
+			T & at( size_type pos )
+			{
+				if( pos >= size() )
+					throw std::out_of_range("error in at(): out of range");
+				return (*this)[pos];
+			}
+
+			const T & at( size_type pos ) const
+			{
+				if( pos >= size() )
+					throw std::out_of_range("error in at(): out of range");
+				return (*this)[pos];
+			}
+
+			/// Returns the number of claimed indices, elements under construction included.
+			size_type size( ) const
+			{ return m_size.load( std::memory_order_acquire ); }
+
+			/// Checks whether no index was claimed.
+			bool empty( ) const
+			{ return size() == 0; }
+
+			/// Returns how many elements fit before a segment must be allocated.
+			size_type capacity( ) const
+			{
+				size_type k{0u};
+				while( k < max_segments and m_segments[k].load( std::memory_order_acquire ) != nullptr )
+					++k;
+				return segment_start( k );
+			}
+
+			iterator begin( )
+			{ return iterator( this, 0 ); }
+
+			iterator end( )
+			{ return iterator( this, size() ); }
+
+			const_iterator begin( ) const
+			{ return const_iterator( this, 0 ); }
+
+			const_iterator end( ) const
+			{ return const_iterator( this, size() ); }
+
+			const_iterator cbegin( ) const
+			{ return begin(); }
+
+			const_iterator cend( ) const
+			{ return end(); }
+
+		public:
+			//=== Non-concurrent methods
+			/// Destroys every element. The segments are kept.
+			void clear( )
+			{
+				for_each_live( [this]( size_type i ) { alloc_traits::destroy( m_alloc, &(*this)[i] ); } );
+				m_size.store( 0, std::memory_order_relaxed );
+				m_empty.clear();
+			}
+
+			/// Exchanges the contents of the two lists.
+			void swap( concurrent_vector & other )
+			{
+				using std::swap;
+				for( size_type k{0u} ; k < max_segments ; ++k )
+				{
+					T * segment = m_segments[k].load( std::memory_order_relaxed );
+					m_segments[k].store( other.m_segments[k].load( std::memory_order_relaxed ), std::memory_order_relaxed );
+					other.m_segments[k].store( segment, std::memory_order_relaxed );
+				}
+				size_type count = m_size.load( std::memory_order_relaxed );
+				m_size.store( other.m_size.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+				other.m_size.store( count, std::memory_order_relaxed );
+				m_empty.swap( other.m_empty );
+				swap( m_alloc, other.m_alloc );
+			}
+
+			/// Copy and move assignment.
+			concurrent_vector & operator=( concurrent_vector other )
+			{
+				swap( other );
+				return *this;
+			}
+
+		protected:
+			//=== Segments
+			/// Returns the segment of index pos.
+			static size_type segment_of( size_type pos )
+			{ return 63 - __builtin_clzll( (unsigned long long)( pos / first_segment + 1 ) ); }
+
+			/// Returns the index of the first element of segment k.
+			static size_type segment_start( size_type k )
+			{ return first_segment * ( ( size_type(1) << k ) - 1 ); }
+
+			/// Returns the number of elements of segment k.
+			static size_type segment_size( size_type k )
+			{ return first_segment << k; }
+
+			/// Returns the offset of index pos in its segment.
+			static size_type offset_of( size_type pos )
+			{ return pos - segment_start( segment_of( pos ) ); }
+
+			/// Returns segment k, allocating it if no thread did yet.
+			T * segment_for( size_type k )
+			{
+				T * segment = m_segments[k].load( std::memory_order_acquire );
+				if( segment != nullptr )
+					return segment;
+
+				T * fresh = alloc_traits::allocate( m_alloc, segment_size( k ) );
+				if( m_segments[k].compare_exchange_strong( segment, fresh, std::memory_order_acq_rel ) )
+					return fresh;
+
+				// Another thread installed it first.
+				alloc_traits::deallocate( m_alloc, fresh, segment_size( k ) );
+				return segment;
+			}
+
+			/// Claims count indices and constructs each with build( slot, index ). Returns the first index.
+			template< typename Build >
+			size_type append( size_type count, Build build )
+			{
+				size_type first = m_size.fetch_add( count, std::memory_order_relaxed );
+				if( count == 0 )
+					return first;
+
+				size_type i{first};
+				try
+				{
+					for( size_type k{segment_of( first )} ; k <= segment_of( first + count - 1 ) ; ++k )
+						segment_for( k );
+					for( ; i < first + count ; ++i )
+						build( &(*this)[i], i );
+				}
+				catch( ... ) { mark_empty( i, first + count ); throw; }
+
+				return first;
+			}
+
+			//=== Empty slots
+			/// Records the slots [first, last) as claimed but never constructed.
+			void mark_empty( size_type first, size_type last )
+			{
+				std::lock_guard<std::mutex> guard( m_empty_lock );
+				m_empty.emplace_back( first, last );
+			}
+
+			/// Returns the number of constructed elements.
+			size_type live_size( ) const
+			{
+				size_type count = size();
+				for( const auto & range : m_empty )
+					count -= range.second - range.first;
+				return count;
+			}
+
+			/// Calls f( index ) for every constructed element, in order. Not concurrent.
+			template< typename F >
+			void for_each_live( F f ) const
+			{
+				std::vector< std::pair<size_type, size_type> > holes( m_empty );
+				std::sort( holes.begin(), holes.end() );
+				holes.emplace_back( size(), size() );
+
+				size_type i{0u};
+				for( const auto & hole : holes )
+				{
+					for( ; i < hole.first ; ++i )
+						f( i );
+					i = hole.second;
+				}
+			}
+
+		protected:
+			std::atomic<T*> m_segments[max_segments]; //!< Segments, null until allocated.
+			std::atomic<size_type> m_size; //!< Claimed indices.
+			std::vector< std::pair<size_type, size_type> > m_empty; //!< Claimed slots whose construction threw.
+			std::mutex m_empty_lock; //!< Guards m_empty while threads append.
+			Alloc m_alloc; //!< Allocator of the segments.
+
+		public:
+		/*! \class basic_iterator
+			\brief random access iterator over the indices of a concurrent_vector.
+
+			It holds the list and an index, so it is not invalidated by growth.
+		*/
+		template< typename V, typename R >
+		class basic_iterator{
+			public:
+				//=== Alias
+				typedef std::ptrdiff_t difference_type; //!< Distance between two iterators.
+				typedef T value_type; //!< Type of the pointed element.
+				typedef R * pointer; //!< Pointer to the element.
+				typedef R & reference; //!< Reference to the element.
+				typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+
+				//=== Constructor
+				basic_iterator( V * list = nullptr, size_type index = 0 )
+					: m_list{list}, m_index{index}
+				{/*empty*/}
+
+				/// An iterator converts to a const_iterator.
+				template< typename W, typename S, typename = typename std::enable_if<
+					std::is_convertible<W*, V*>::value >::type >
+				basic_iterator( const basic_iterator<W, S> & other )
+					: m_list{other.m_list}, m_index{other.m_index}
+				{/*empty*/}
+
+				//=== Operators
+				reference operator*( ) const
+				{ return (*m_list)[m_index]; }
+
+				pointer operator->( ) const
+				{ return &(*m_list)[m_index]; }
+
+				reference operator[]( difference_type n ) const
+				{ return (*m_list)[m_index + n]; }
+
+				basic_iterator & operator++( )
+				{ ++m_index; return *this; }
+
+				basic_iterator operator++( int )
+				{ basic_iterator old( *this ); ++m_index; return old; }
+
+				basic_iterator & operator--( )
+				{ --m_index; return *this; }
+
+				basic_iterator operator--( int )
+				{ basic_iterator old( *this ); --m_index; return old; }
+
+				basic_iterator & operator+=( difference_type n )
+				{ m_index += n; return *this; }
+
+				basic_iterator & operator-=( difference_type n )
+				{ m_index -= n; return *this; }
+
+				basic_iterator operator+( difference_type n ) const
+				{ return basic_iterator( m_list, m_index + n ); }
+
+				basic_iterator operator-( difference_type n ) const
+				{ return basic_iterator( m_list, m_index - n ); }
+
+				difference_type operator-( const basic_iterator & rhs ) const
+				{ return (difference_type) m_index - (difference_type) rhs.m_index; }
+
+				bool operator==( const basic_iterator & rhs ) const
+				{ return m_index == rhs.m_index; }
+
+				bool operator!=( const basic_iterator & rhs ) const
+				{ return m_index != rhs.m_index; }
+
+				bool operator<( const basic_iterator & rhs ) const
+				{ return m_index < rhs.m_index; }
+
+				bool operator>( const basic_iterator & rhs ) const
+				{ return m_index > rhs.m_index; }
+
+				bool operator<=( const basic_iterator & rhs ) const
+				{ return m_index <= rhs.m_index; }
+
+				bool operator>=( const basic_iterator & rhs ) const
+				{ return m_index >= rhs.m_index; }
+
+			private:
+				template< typename, typename > friend class basic_iterator;
+
+				V * m_list; //!< Iterated list.
+				size_type m_index; //!< Index of the pointed element.
+		};
+	};
+
+	template< typename T, typename Alloc >
+	constexpr typename concurrent_vector<T, Alloc>::size_type concurrent_vector<T, Alloc>::first_segment;
+
+	template< typename T, typename Alloc >
+	constexpr typename concurrent_vector<T, Alloc>::size_type concurrent_vector<T, Alloc>::max_segments;
+
+	/// Exchanges the contents of the two lists.
+	template< typename T, typename Alloc >
+	void swap( concurrent_vector<T, Alloc> & lhs, concurrent_vector<T, Alloc> & rhs )
+	{ lhs.swap( rhs ); }
+
+} // namespace sc
+
+#endif
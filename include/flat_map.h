@@ -0,0 +1,485 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \class basic_sorted_vector
+		\brief elements kept sorted by key, without repeated keys, in one sc::vector.
+
+		Lookups are binary searches over contiguous storage: no node, no pointer to follow, and
+		one allocation for the whole container. A single insert() or erase() shifts the elements
+		after its position, O(n); insert_batch() sorts a batch and merges it with the elements in
+		one linear pass, O(n + m log m) for m new elements, so periodic bulk updates cost about as
+		much as copying the container once.
+
+		KeyOf returns the key of an element; Compare orders keys. sorted_vector and flat_map derive
+		from it. Inserting or erasing invalidates iterators and references.
+	*/
+	template< typename Key, typename Value, typename KeyOf, typename Compare, typename Alloc, typename Growth >
+	class basic_sorted_vector{
+
+		public:
+			//=== Alias
+			typedef Key key_type; //!< Type of the keys.
+			typedef Value value_type; //!< Type of the elements.
+			typedef Compare key_compare; //!< Order of the keys.
+			typedef size_t size_type; //!< Type of size.
+			typedef vector<Value, Alloc, Growth> vector_type; //!< Storage of the elements.
+			typedef typename vector_type::const_iterator const_iterator; //!< Random access iterator to const elements.
+
+			//=== Constructors
+			explicit basic_sorted_vector( const Compare & comp = Compare() )
+				: m_items(), m_comp(comp)
+			{/*empty*/}
+
+		public:
+			//=== Capacity
+			size_type size( ) const
+			{ return m_items.size(); }
+
+			bool empty( ) const
+			{ return m_items.size() == 0; }
+
+			size_type capacity( ) const
+			{ return m_items.capacity(); }
+
+			void reserve( size_type new_cap )
+			{ m_items.reserve( new_cap ); }
+
+			void shrink_to_fit( )
+			{ m_items.shrink_to_fit(); }
+
+			void clear( )
+			{ m_items.clear(); }
+
+			/// Returns the elements, sorted by key.
+			const vector_type & items( ) const
+			{ return m_items; }
+
+			key_compare key_comp( ) const
+			{ return m_comp; }
+
+			const_iterator begin( ) const
+			{ return m_items.cbegin(); }
+
+			const_iterator end( ) const
+			{ return m_items.cend(); }
+
+			const_iterator cbegin( ) const
+			{ return m_items.cbegin(); }
+
+			const_iterator cend( ) const
+			{ return m_items.cend(); }
+
+		public:
+			//=== Lookup
+			/// Returns an iterator to the element of key key, or end().
+			const_iterator find( const key_type & key ) const
+			{
+				size_type pos = lower_index( key );
+				return cbegin() + ( found( pos, key ) ? pos : size() );
+			}
+
+			/// Returns an iterator to the first element whose key is not before key.
+			const_iterator lower_bound( const key_type & key ) const
+			{ return cbegin() + lower_index( key ); }
+
+			/// Returns an iterator to the first element whose key is after key.
+			const_iterator upper_bound( const key_type & key ) const
+			{
+				const Compare & comp = m_comp;
+				return std::upper_bound( cbegin(), cend(), key,
+					[&comp]( const key_type & k, const value_type & v ) { return comp( k, KeyOf()( v ) ); } );
+			}
+
+			/// Returns 1 if an element has key key, 0 otherwise.
+			size_type count( const key_type & key ) const
+			{ return contains( key ) ? 1 : 0; }
+
+			bool contains( const key_type & key ) const
+			{ return found( lower_index( key ), key ); }
+
+			bool operator==( const basic_sorted_vector & rhs ) const
+			{ return m_items == rhs.m_items; }
+
+			bool operator!=( const basic_sorted_vector & rhs ) const
+			{ return not ( *this == rhs ); }
+
+		public:
+			//=== Modifiers
+			/// Removes the element of key key. Returns the number of removed elements, 0 or 1.
+			size_type erase( const key_type & key )
+			{
+				size_type pos = lower_index( key );
+				if( not found( pos, key ) )
+					return 0;
+				m_items.erase( m_items.begin() + pos );
+				return 1;
+			}
+
+			/// Inserts the elements in [first, last) whose key is not in the container yet; of several
+			/// elements with the same key, the first one. Sorts them, then merges them with the elements
+			/// in one pass. Returns the number of inserted elements.
+			template< typename InputIt >
+			size_type insert_batch( InputIt first, InputIt last )
+			{ return merge( sorted_batch( first, last, false ), false ); }
+
+			/// Inserts the elements of ilist as insert_batch( first, last ) does.
+			size_type insert_batch( std::initializer_list<value_type> ilist )
+			{ return insert_batch( ilist.begin(), ilist.end() ); }
+
+		protected:
+			/// Returns the index of the first element whose key is not before key.
+			size_type lower_index( const key_type & key ) const
+			{
+				const Compare & comp = m_comp;
+				return std::lower_bound( cbegin(), cend(), key,
+					[&comp]( const value_type & v, const key_type & k ) { return comp( KeyOf()( v ), k ); } ) - cbegin();
+			}
+
+			/// Checks whether the element at pos, from lower_index( key ), has key key.
+			bool found( size_type pos, const key_type & key ) const
+			{ return pos < size() and not m_comp( key, KeyOf()( m_items[pos] ) ); }
+
+			bool less( const value_type & a, const value_type & b ) const
+			{ return m_comp( KeyOf()( a ), KeyOf()( b ) ); }
+
+			/// Inserts value before pos, the index lower_index() returned for its key.
+			typename vector_type::iterator insert_at( size_type pos, const value_type & value )
+			{ return m_items.insert( m_items.begin() + pos, value ); }
+
+			typename vector_type::iterator insert_at( size_type pos, value_type && value )
+			{ return m_items.insert( m_items.begin() + pos, std::move( value ) ); }
+
+			/// Returns the elements in [first, last) sorted by key, with one element per key: the first
+			/// one of each key, or the last one if last_wins.
+			template< typename InputIt >
+			vector_type sorted_batch( InputIt first, InputIt last, bool last_wins ) const
+			{
+				vector_type batch;
+				for( ; first != last ; ++first )
+					batch.push_back( *first );
+
+				const basic_sorted_vector & self = *this;
+				std::stable_sort( batch.begin(), batch.end(),
+					[&self]( const value_type & a, const value_type & b ) { return self.less( a, b ); } );
+
+				size_type kept{0u};
+				for( size_type i{0u} ; i < batch.size() ; ++i )
+				{
+					if( kept != 0 and not less( batch[kept - 1], batch[i] ) )
+					{
+						if( last_wins )
+							batch[kept - 1] = std::move( batch[i] );
+					}
+					else
+					{
+						if( kept != i )
+							batch[kept] = std::move( batch[i] );
+						++kept;
+					}
+				}
+				batch.erase( batch.begin() + kept, batch.end() );
+				return batch;
+			}
+
+			/// Merges batch, sorted with one element per key, with the elements. An element of batch
+			/// whose key is already there replaces it if replace, and is dropped otherwise. Returns the
+			/// number of new keys. The merged list is built in new storage, unless batch only holds keys
+			/// after the last one: if copying an element throws, the container is left unchanged.
+			size_type merge( vector_type && batch, bool replace )
+			{
+				size_type n = m_items.size(), m = batch.size();
+				if( m == 0 )
+					return 0;
+
+				if( n == 0 or less( m_items[n - 1], batch[0] ) )
+				{
+					m_items.push_back( std::make_move_iterator( batch.begin() ), std::make_move_iterator( batch.end() ) );
+					return m;
+				}
+
+				vector_type merged;
+				merged.reserve( n + m );
+				size_type i{0u}, j{0u}, added{0u};
+				while( i < n and j < m )
+				{
+					if( less( m_items[i], batch[j] ) )
+						merged.push_back( std::move_if_noexcept( m_items[i++] ) );
+					else if( less( batch[j], m_items[i] ) )
+					{
+						merged.push_back( std::move( batch[j++] ) );
+						++added;
+					}
+					else
+					{
+						merged.push_back( replace ? std::move( batch[j] ) : std::move_if_noexcept( m_items[i] ) );
+						++i, ++j;
+					}
+				}
+				for( ; i < n ; ++i )
+					merged.push_back( std::move_if_noexcept( m_items[i] ) );
+				for( ; j < m ; ++j, ++added )
+					merged.push_back( std::move( batch[j] ) );
+
+				m_items = std::move( merged );
+				return added;
+			}
+
+		protected:
+			vector_type m_items; //!< Elements, sorted by key, one per key.
+			Compare m_comp; //!< Order of the keys.
+	};
+
+	/// Key of a set element: the element itself.
+	struct identity_key
+	{
+		template< typename T >
+		const T & operator()( const T & value ) const
+		{ return value; }
+	};
+
+	/// Key of a map element: the first of the pair.
+	struct first_key
+	{
+		template< typename Pair >
+		const typename Pair::first_type & operator()( const Pair & value ) const
+		{ return value.first; }
+	};
+
+	/*! \class sorted_vector
+		\brief set of unique values, sorted in a sc::vector (a flat set).
+
+		Its iterators are const: changing an element could break the order.
+	*/
+	template< typename T, typename Compare = std::less<T>, typename Alloc = std::allocator<T>, typename Growth = growth::doubling >
+	class sorted_vector : public basic_sorted_vector< T, T, identity_key, Compare, Alloc, Growth >{
+
+		typedef basic_sorted_vector< T, T, identity_key, Compare, Alloc, Growth > base;
+
+		public:
+			//=== Alias
+			typedef typename base::const_iterator const_iterator; //!< Random access iterator to const elements.
+			typedef const_iterator iterator; //!< The elements are not changed in place.
+			typedef typename base::size_type size_type; //!< Type of size.
+
+			//=== Constructors
+			/// Empty set.
+			explicit sorted_vector( const Compare & comp = Compare() )
+				: base( comp )
+			{/*empty*/}
+
+			/// Set of the values in [first, last).
+			template< typename InputIt >
+			sorted_vector( InputIt first, InputIt last, const Compare & comp = Compare() )
+				: base( comp )
+			{ this->insert_batch( first, last ); }
+
+			/// Set of the values of ilist.
+			sorted_vector( std::initializer_list<T> ilist, const Compare & comp = Compare() )
+				: sorted_vector( ilist.begin(), ilist.end(), comp )
+			{/*empty*/}
+
+		public:
+			//=== Modifiers
+			/// Inserts value unless it is there. Returns an iterator to the element equal to value, and
+			/// whether it was inserted.
+			std::pair<const_iterator, bool> insert( const T & value )
+			{
+				size_type pos = this->lower_index( value );
+				if( this->found( pos, value ) )
+					return std::make_pair( this->cbegin() + pos, false );
+				const_iterator it = this->insert_at( pos, value );
+				return std::make_pair( it, true );
+			}
+
+			std::pair<const_iterator, bool> insert( T && value )
+			{
+				size_type pos = this->lower_index( value );
+				if( this->found( pos, value ) )
+					return std::make_pair( this->cbegin() + pos, false );
+				const_iterator it = this->insert_at( pos, std::move( value ) );
+				return std::make_pair( it, true );
+			}
+
+			using base::erase;
+
+			/// Removes the element at pos. Returns an iterator to the element after it.
+			const_iterator erase( const_iterator pos )
+			{
+				size_type index = pos - this->cbegin();
+				return this->m_items.erase( this->m_items.begin() + index );
+			}
+
+			/// Removes the elements in [first, last). Returns an iterator to the element after them.
+			const_iterator erase( const_iterator first, const_iterator last )
+			{
+				size_type index = first - this->cbegin();
+				return this->m_items.erase( this->m_items.begin() + index, this->m_items.begin() + index + ( last - first ) );
+			}
+	};
+
+	/*! \class flat_map
+		\brief map from unique keys to values, kept as key-value pairs sorted in a sc::vector.
+
+		The pairs are std::pair<Key, Value>, so that they can be moved within the array: the
+		iterators may change the values, and must not change the keys.
+		insert_or_assign_batch() is insert_batch() where the batch overwrites the values of keys
+		already there.
+	*/
+	template< typename Key, typename Value, typename Compare = std::less<Key>,
+		typename Alloc = std::allocator< std::pair<Key, Value> >, typename Growth = growth::doubling >
+	class flat_map : public basic_sorted_vector< Key, std::pair<Key, Value>, first_key, Compare, Alloc, Growth >{
+
+		typedef basic_sorted_vector< Key, std::pair<Key, Value>, first_key, Compare, Alloc, Growth > base;
+
+		public:
+			//=== Alias
+			typedef Value mapped_type; //!< Type of the values.
+			typedef std::pair<Key, Value> value_type; //!< Type of the elements.
+			typedef typename base::vector_type::iterator iterator; //!< Random access iterator.
+			typedef typename base::const_iterator const_iterator; //!< Random access iterator to const elements.
+			typedef typename base::size_type size_type; //!< Type of size.
+
+			//=== Constructors
+			/// Empty map.
+			explicit flat_map( const Compare & comp = Compare() )
+				: base( comp )
+			{/*empty*/}
+
+			/// Map of the pairs in [first, last); of pairs with the same key, the first one.
+			template< typename InputIt >
+			flat_map( InputIt first, InputIt last, const Compare & comp = Compare() )
+				: base( comp )
+			{ this->insert_batch( first, last ); }
+
+			/// Map of the pairs of ilist.
+			flat_map( std::initializer_list<value_type> ilist, const Compare & comp = Compare() )
+				: flat_map( ilist.begin(), ilist.end(), comp )
+			{/*empty*/}
+
+		public:
+			//=== Access
+			using base::begin;
+			using base::end;
+			using base::find;
+			using base::lower_bound;
+
+			iterator begin( )
+			{ return this->m_items.begin(); }
+
+			iterator end( )
+			{ return this->m_items.end(); }
+
+			iterator find( const Key & key )
+			{
+				size_type pos = this->lower_index( key );
+				return begin() + ( this->found( pos, key ) ? pos : this->size() );
+			}
+
+			iterator lower_bound( const Key & key )
+			{ return begin() + this->lower_index( key ); }
+
+			/// Returns the value of key, inserting a value-initialized one if key is not there.
+			Value & operator[]( const Key & key )
+			{
+				size_type pos = this->lower_index( key );
+				if( not this->found( pos, key ) )
+					this->insert_at( pos, value_type( key, Value() ) );
+				return this->m_items[pos].second;
+			}
+
+			/// Returns the value of key. Throws std::out_of_range if key is not there.
+			Value & at( const Key & key )
+			{
+				size_type pos = this->lower_index( key );
+				if( not this->found( pos, key ) )
+					throw std::out_of_range("error in at(): key not found");
+				return this->m_items[pos].second;
+			}
+
+			const Value & at( const Key & key ) const
+			{
+				size_type pos = this->lower_index( key );
+				if( not this->found( pos, key ) )
+					throw std::out_of_range("error in at(): key not found");
+				return this->m_items[pos].second;
+			}
+
+		public:
+			//=== Modifiers
+			/// Inserts value unless its key is there. Returns an iterator to the element of that key,
+			/// and whether it was inserted.
+			std::pair<iterator, bool> insert( const value_type & value )
+			{
+				size_type pos = this->lower_index( value.first );
+				if( this->found( pos, value.first ) )
+					return std::make_pair( begin() + pos, false );
+				return std::make_pair( this->insert_at( pos, value ), true );
+			}
+
+			std::pair<iterator, bool> insert( value_type && value )
+			{
+				size_type pos = this->lower_index( value.first );
+				if( this->found( pos, value.first ) )
+					return std::make_pair( begin() + pos, false );
+				return std::make_pair( this->insert_at( pos, std::move( value ) ), true );
+			}
+
+			/// Sets the value of key, inserting it if key is not there. Returns an iterator to its
+			/// element, and whether it was inserted.
+			template< typename V >
+			std::pair<iterator, bool> insert_or_assign( const Key & key, V && value )
+			{
+				size_type pos = this->lower_index( key );
+				if( this->found( pos, key ) )
+				{
+					this->m_items[pos].second = std::forward<V>( value );
+					return std::make_pair( begin() + pos, false );
+				}
+				return std::make_pair( this->insert_at( pos, value_type( key, std::forward<V>( value ) ) ), true );
+			}
+
+			/// Inserts the pairs in [first, last), replacing the values of the keys that are there; of
+			/// several pairs with the same key, the last one. Sorts them, then merges them with the
+			/// elements in one pass. Returns the number of new keys.
+			template< typename InputIt >
+			size_type insert_or_assign_batch( InputIt first, InputIt last )
+			{ return this->merge( this->sorted_batch( first, last, true ), true ); }
+
+			/// Inserts or assigns the pairs of ilist as insert_or_assign_batch( first, last ) does.
+			size_type insert_or_assign_batch( std::initializer_list<value_type> ilist )
+			{ return insert_or_assign_batch( ilist.begin(), ilist.end() ); }
+
+			using base::erase;
+
+			/// Removes the element at pos. Returns an iterator to the element after it.
+			iterator erase( const_iterator pos )
+			{
+				size_type index = pos - this->cbegin();
+				return this->m_items.erase( begin() + index );
+			}
+
+			/// Removes the elements in [first, last). Returns an iterator to the element after them.
+			iterator erase( const_iterator first, const_iterator last )
+			{
+				size_type index = first - this->cbegin();
+				return this->m_items.erase( begin() + index, begin() + index + ( last - first ) );
+			}
+	};
+
+} // namespace sc
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef GROWTH_H
+#define GROWTH_H
+
+#include <cstddef>
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \namespace growth
+		\brief growth policies for the storage of sc::vector.
+
+		A policy is a type with a static member
+
+			size_t grow( size_t capacity, size_t required, size_t elem_size )
+
+		that returns the capacity, in elements, to reallocate to when the current capacity is
+		full and at least required elements must fit. elem_size is sizeof(T), for policies that
+		reason in bytes. The containers never ask for less than required, whatever it returns.
+	*/
+	namespace growth{
+
+		/// Returns the largest of a and b.
+		inline size_t at_least( size_t a, size_t b )
+		{ return a < b ? b : a; }
+
+		/*! \struct doubling
+			\brief capacity * 2: the fewest reallocations, up to half of the storage unused.
+		*/
+		struct doubling
+		{
+			static size_t grow( size_t capacity, size_t required, size_t )
+			{ return at_least( capacity != 0 ? capacity * 2 : 1, required ); }
+		};
+
+		/*! \struct factor_1_5
+			\brief capacity * 1.5: about a third of the unused storage of doubling.
+		*/
+		struct factor_1_5
+		{
+			static size_t grow( size_t capacity, size_t required, size_t )
+			{ return at_least( capacity + capacity / 2 + 1, required ); }
+		};
+
+		/*! \struct size_class
+			\brief rounds the capacity of Base up to the next malloc size class.
+
+			Classes are 16 bytes, then four per power of two (as jemalloc and tcmalloc do), then
+			whole pages from page_size * 4 on. The bytes the allocator would round up to anyway
+			become usable capacity.
+		*/
+		template< typename Base = factor_1_5 >
+		struct size_class
+		{
+			static constexpr size_t page_size = 4096; //!< Size classes above four pages are page multiples.
+
+			static size_t grow( size_t capacity, size_t required, size_t elem_size )
+			{
+				size_t bytes = round_up( Base::grow( capacity, required, elem_size ) * elem_size );
+				return at_least( bytes / elem_size, required );
+			}
+
+			/// Returns the size class of a request of bytes.
+			static size_t round_up( size_t bytes )
+			{
+				if( bytes <= 16 )
+					return 16;
+				if( bytes >= page_size * 4 )
+					return ( bytes + page_size - 1 ) / page_size * page_size;
+
+				size_t power = 16;
+				while( power * 2 < bytes )
+					power *= 2;
+				size_t step = power / 4;
+
+				return ( bytes + step - 1 ) / step * step;
+			}
+		};
+
+		/*! \struct linear_above
+			\brief grows as Base up to Threshold bytes, then by Step bytes at a time.
+
+			Past the threshold the unused storage is bounded by Step bytes instead of a fraction
+			of the buffer, at the cost of more reallocations.
+		*/
+		template< size_t Threshold, size_t Step, typename Base = doubling >
+		struct linear_above
+		{
+			static size_t grow( size_t capacity, size_t required, size_t elem_size )
+			{
+				if( capacity * elem_size < Threshold )
+					return at_least( Base::grow( capacity, required, elem_size ), required );
+
+				size_t step = Step / elem_size != 0 ? Step / elem_size : 1;
+				return at_least( capacity + step, required );
+			}
+		};
+
+		/*! \struct function
+			\brief policy given by a user function with the signature of grow().
+		*/
+		template< size_t (*Grow)( size_t capacity, size_t required, size_t elem_size ) >
+		struct function
+		{
+			static size_t grow( size_t capacity, size_t required, size_t elem_size )
+			{ return at_least( Grow( capacity, required, elem_size ), required ); }
+		};
+
+	} // namespace growth
+
+} // namespace sc
+
+#endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <cstddef>
+#include <atomic>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \struct vector_stats
+		\brief what a vector did with its storage, as counted in instrumented builds.
+
+		Built with SC_VECTOR_INSTRUMENT defined, every sc::vector keeps one, returned by stats(),
+		and adds to the process totals of instrument::global(). Without the macro neither exists.
+
+		Moved and copied elements are the ones the vector shifts or relocates on its own to make
+		room (reserve, insert, push_front, erase), not the values it was given. An element counts as
+		copied when it is relocated with its copy constructor because its move may throw.
+	*/
+	struct vector_stats
+	{
+		size_t allocations = 0; //!< Storages drawn from the allocator.
+		size_t reallocations = 0; //!< Storages that replaced a previous one.
+		size_t bytes_allocated = 0; //!< Bytes drawn from the allocator.
+		size_t bytes_freed = 0; //!< Bytes given back to the allocator.
+		size_t elements_copied = 0; //!< Elements relocated by copy.
+		size_t elements_moved = 0; //!< Elements relocated by move or raw memory copy.
+		size_t peak_capacity = 0; //!< Largest storage, in elements, front slack included.
+		size_t peak_size = 0; //!< Largest number of elements.
+	};
+
+	/// Writes stats as a JSON object.
+	inline std::ostream & operator<<( std::ostream & os, const vector_stats & stats )
+	{
+		return os << "{\"allocations\": " << stats.allocations
+			<< ", \"reallocations\": " << stats.reallocations
+			<< ", \"bytes_allocated\": " << stats.bytes_allocated
+			<< ", \"bytes_freed\": " << stats.bytes_freed
+			<< ", \"elements_copied\": " << stats.elements_copied
+			<< ", \"elements_moved\": " << stats.elements_moved
+			<< ", \"peak_capacity\": " << stats.peak_capacity
+			<< ", \"peak_size\": " << stats.peak_size << "}";
+	}
+
+	/*! \namespace instrument
+		\brief process wide totals of the instrumented vectors.
+
+		The totals are atomic, so vectors of different threads may update them at once.
+		Peaks are those of the single largest vector.
+	*/
+	namespace instrument{
+
+		/*! \struct totals
+			\brief counters shared by all vectors. Use global() to read them.
+		*/
+		struct totals
+		{
+			std::atomic<size_t> allocations{0};
+			std::atomic<size_t> reallocations{0};
+			std::atomic<size_t> bytes_allocated{0};
+			std::atomic<size_t> bytes_freed{0};
+			std::atomic<size_t> elements_copied{0};
+			std::atomic<size_t> elements_moved{0};
+			std::atomic<size_t> peak_capacity{0};
+			std::atomic<size_t> peak_size{0};
+		};
+
+		/// Returns the counters shared by all vectors.
+		inline totals & shared( )
+		{
+			static totals instance;
+			return instance;
+		}
+
+		/// Raises peak to value, if it is larger.
+		inline void raise( std::atomic<size_t> & peak, size_t value )
+		{
+			size_t current = peak.load( std::memory_order_relaxed );
+			while( value > current and not peak.compare_exchange_weak( current, value, std::memory_order_relaxed ) )
+			{/*empty*/}
+		}
+
+		/// Returns a snapshot of the totals of all vectors since the start or the last reset().
+		inline vector_stats global( )
+		{
+			totals & t = shared();
+			vector_stats stats;
+			stats.allocations = t.allocations.load( std::memory_order_relaxed );
+			stats.reallocations = t.reallocations.load( std::memory_order_relaxed );
+			stats.bytes_allocated = t.bytes_allocated.load( std::memory_order_relaxed );
+			stats.bytes_freed = t.bytes_freed.load( std::memory_order_relaxed );
+			stats.elements_copied = t.elements_copied.load( std::memory_order_relaxed );
+			stats.elements_moved = t.elements_moved.load( std::memory_order_relaxed );
+			stats.peak_capacity = t.peak_capacity.load( std::memory_order_relaxed );
+			stats.peak_size = t.peak_size.load( std::memory_order_relaxed );
+			return stats;
+		}
+
+		/// Sets every total back to zero. The counters of each vector are kept.
+		inline void reset( )
+		{
+			totals & t = shared();
+			t.allocations = 0;
+			t.reallocations = 0;
+			t.bytes_allocated = 0;
+			t.bytes_freed = 0;
+			t.elements_copied = 0;
+			t.elements_moved = 0;
+			t.peak_capacity = 0;
+			t.peak_size = 0;
+		}
+
+		/// Writes the totals of all vectors to os as a JSON object.
+		inline void dump_json( std::ostream & os )
+		{ os << global(); }
+
+		/// Returns stats as a JSON object.
+		inline std::string to_json( const vector_stats & stats )
+		{
+			std::ostringstream os;
+			os << stats;
+			return os.str();
+		}
+
+	} // namespace instrument
+
+} // namespace sc
+
+#endif
@@ -0,0 +1,474 @@
+#ifndef MEMORY_RESOURCE_H
+#define MEMORY_RESOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "vector.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \namespace pmr
+		\brief polymorphic memory resources, as std::pmr of C++17.
+
+		sc::pmr::vector<T> draws its storage from a memory_resource chosen at run time, so
+		every vector built while handling a request can come from one arena and be released
+		with it.
+	*/
+	namespace pmr{
+
+		/*! \class memory_resource
+			\brief interface of a source of raw memory.
+		*/
+		class memory_resource{
+
+			public:
+				static constexpr size_t max_align = alignof(std::max_align_t); //!< Alignment of operator new.
+
+				//=== Destructor
+				virtual ~memory_resource( )
+				{/*empty*/}
+
+			public:
+				//=== Methods
+				/// Returns bytes of storage aligned to alignment.
+				void * allocate( size_t bytes, size_t alignment = max_align )
+				{ return do_allocate( bytes, alignment ); }
+
+				/// Gives back the storage p, obtained from allocate( bytes, alignment ).
+				void deallocate( void * p, size_t bytes, size_t alignment = max_align )
+				{ do_deallocate( p, bytes, alignment ); }
+
+				/// Checks whether storage from this resource can be given back to other and vice versa.
+				bool is_equal( const memory_resource & other ) const
+				{ return do_is_equal( other ); }
+
+			protected:
+				virtual void * do_allocate( size_t bytes, size_t alignment ) = 0;
+				virtual void do_deallocate( void * p, size_t bytes, size_t alignment ) = 0;
+				virtual bool do_is_equal( const memory_resource & other ) const
+				{ return this == &other; }
+		}; // class memory_resource
+
+		inline bool operator==( const memory_resource & lhs, const memory_resource & rhs )
+		{ return &lhs == &rhs or lhs.is_equal( rhs ); }
+
+		inline bool operator!=( const memory_resource & lhs, const memory_resource & rhs )
+		{ return not ( lhs == rhs ); }
+
+
+		/*! \class new_delete_memory_resource
+			\brief memory_resource over the global operator new and delete.
+		*/
+		class new_delete_memory_resource : public memory_resource{
+
+			protected:
+				void * do_allocate( size_t bytes, size_t alignment ) override
+				{
+					if( alignment <= max_align )
+						return ::operator new( bytes );
+
+					// Over-aligned: the pointer from operator new is kept right before the aligned block.
+					char * raw = static_cast<char*>( ::operator new( bytes + alignment + sizeof(void*) ) );
+					std::uintptr_t first = reinterpret_cast<std::uintptr_t>( raw + sizeof(void*) );
+					char * p = raw + sizeof(void*) + ( alignment - first % alignment ) % alignment;
+					reinterpret_cast<void**>( p )[-1] = raw;
+
+					return p;
+				}
+
+				void do_deallocate( void * p, size_t, size_t alignment ) override
+				{
+					if( alignment <= max_align )
+						::operator delete( p );
+					else
+						::operator delete( static_cast<void**>( p )[-1] );
+				}
+
+				bool do_is_equal( const memory_resource & other ) const override
+				{ return dynamic_cast< const new_delete_memory_resource * >( &other ) != nullptr; }
+		}; // class new_delete_memory_resource
+
+		/// Returns the resource over the global operator new and delete.
+		inline memory_resource * new_delete_resource( )
+		{
+			static new_delete_memory_resource resource;
+			return &resource;
+		}
+
+
+		/*! \class monotonic_buffer_resource
+			\brief arena: hands out storage by bumping a pointer and frees it all at once.
+
+			deallocate() does nothing; the storage comes back in one step with release() or the
+			destructor. Chunks are taken from the upstream resource, each twice as large as the
+			previous one. An initial buffer, e.g. on the stack, can be given to serve the first
+			requests without any allocation.
+		*/
+		class monotonic_buffer_resource : public memory_resource{
+
+			public:
+				static constexpr size_t initial_chunk_size = 1024; //!< Default size of the first chunk.
+
+				//=== Constructors
+				/// Arena whose first chunk holds initial_size bytes.
+				explicit monotonic_buffer_resource( size_t initial_size = initial_chunk_size,
+				                                    memory_resource * upstream = new_delete_resource() )
+					: m_upstream{upstream}, m_chunks{nullptr}, m_current{nullptr}, m_left{0},
+					  m_next_size{initial_size != 0 ? initial_size : initial_chunk_size}
+				{/*empty*/}
+
+				/// Arena that serves from buffer, of size bytes, before using upstream.
+				monotonic_buffer_resource( void * buffer, size_t size,
+				                           memory_resource * upstream = new_delete_resource() )
+					: m_upstream{upstream}, m_chunks{nullptr}, m_buffer{static_cast<char*>( buffer )},
+					  m_buffer_size{size}, m_current{static_cast<char*>( buffer )}, m_left{size},
+					  m_next_size{size != 0 ? size * 2 : initial_chunk_size}
+				{/*empty*/}
+
+				monotonic_buffer_resource( const monotonic_buffer_resource & ) = delete;
+				monotonic_buffer_resource & operator=( const monotonic_buffer_resource & ) = delete;
+
+				/// Destructor. Releases all the storage.
+				~monotonic_buffer_resource( )
+				{ release(); }
+
+			public:
+				//=== Methods
+				/// Gives every chunk back to upstream. Everything allocated from the arena is gone.
+				void release( )
+				{
+					while( m_chunks != nullptr )
+					{
+						chunk * next = m_chunks->next;
+						m_upstream->deallocate( m_chunks, m_chunks->size, alignof(chunk) );
+						m_chunks = next;
+					}
+
+					m_current = m_buffer;
+					m_left = m_buffer_size;
+				}
+
+				/// Returns the resource the chunks come from.
+				memory_resource * upstream_resource( ) const
+				{ return m_upstream; }
+
+			protected:
+				void * do_allocate( size_t bytes, size_t alignment ) override
+				{
+					void * p = bump( bytes, alignment );
+					if( p != nullptr )
+						return p;
+
+					// Not enough room left: a new chunk large enough for this request.
+					size_t size = m_next_size;
+					while( size < sizeof(chunk) + bytes + alignment )
+						size *= 2;
+
+					chunk * c = static_cast<chunk*>( m_upstream->allocate( size, alignof(chunk) ) );
+					c->next = m_chunks;
+					c->size = size;
+					m_chunks = c;
+					m_current = reinterpret_cast<char*>( c + 1 );
+					m_left = size - sizeof(chunk);
+					m_next_size = size * 2;
+
+					return bump( bytes, alignment );
+				}
+
+				void do_deallocate( void *, size_t, size_t ) override
+				{/*empty*/}
+
+			private:
+				/// Header at the start of every chunk.
+				struct chunk
+				{
+					chunk * next; //!< Chunk allocated before this one.
+					size_t size; //!< Size of the chunk, header included.
+				};
+
+				/// Takes bytes aligned to alignment from the current chunk, or returns nullptr if they do not fit.
+				void * bump( size_t bytes, size_t alignment )
+				{
+					if( m_current == nullptr )
+						return nullptr;
+
+					size_t padding = ( alignment - reinterpret_cast<std::uintptr_t>( m_current ) % alignment ) % alignment;
+					if( padding + bytes > m_left )
+						return nullptr;
+
+					char * p = m_current + padding;
+					m_current = p + bytes;
+					m_left -= padding + bytes;
+
+					return p;
+				}
+
+			private:
+				memory_resource * m_upstream; //!< Where chunks come from.
+				chunk * m_chunks; //!< Last allocated chunk.
+				char * m_buffer = nullptr; //!< Initial buffer given by the user.
+				size_t m_buffer_size = 0; //!< Size of the initial buffer.
+				char * m_current; //!< Free storage of the current chunk.
+				size_t m_left; //!< Bytes left in the current chunk.
+				size_t m_next_size; //!< Size of the next chunk.
+		}; // class monotonic_buffer_resource
+
+
+		/*! \class unsynchronized_pool_resource
+			\brief pools of fixed-size blocks, for storage that is given back and reused often.
+
+			Requests up to max_block bytes are rounded up to a power of two and served from the
+			free list of that size; the lists are refilled with slabs from upstream. Larger
+			requests go straight to upstream. release() gives every slab back at once. It is not
+			thread safe: use one per thread or per request.
+		*/
+		class unsynchronized_pool_resource : public memory_resource{
+
+			public:
+				static constexpr size_t min_block = 16; //!< Smallest block size.
+				static constexpr size_t max_block = 4096; //!< Largest block size served from a pool.
+				static constexpr size_t pool_count = 9; //!< Pools of 16, 32, ..., 4096 bytes.
+				static constexpr size_t slab_size = 16 * 1024; //!< Size of the first slab of a pool.
+
+				//=== Constructors
+				explicit unsynchronized_pool_resource( memory_resource * upstream = new_delete_resource() )
+					: m_upstream{upstream}, m_slabs{nullptr}
+				{
+					for( size_t i{0u} ; i < pool_count ; ++i )
+					{
+						m_free[i] = nullptr;
+						m_blocks_per_slab[i] = 0;
+					}
+				}
+
+				unsynchronized_pool_resource( const unsynchronized_pool_resource & ) = delete;
+				unsynchronized_pool_resource & operator=( const unsynchronized_pool_resource & ) = delete;
+
+				/// Destructor. Releases all the storage.
+				~unsynchronized_pool_resource( )
+				{ release(); }
+
+			public:
+				//=== Methods
+				/// Gives every slab and large block back to upstream.
+				void release( )
+				{
+					while( m_slabs != nullptr )
+					{
+						slab * next = m_slabs->next;
+						m_upstream->deallocate( m_slabs, m_slabs->size, m_slabs->alignment );
+						m_slabs = next;
+					}
+
+					for( size_t i{0u} ; i < pool_count ; ++i )
+					{
+						m_free[i] = nullptr;
+						m_blocks_per_slab[i] = 0;
+					}
+				}
+
+				/// Returns the resource the slabs come from.
+				memory_resource * upstream_resource( ) const
+				{ return m_upstream; }
+
+			protected:
+				void * do_allocate( size_t bytes, size_t alignment ) override
+				{
+					if( bytes > max_block or alignment > max_align )
+						return allocate_large( bytes, alignment );
+
+					size_t pool = pool_index( bytes );
+					if( m_free[pool] == nullptr )
+						refill( pool );
+
+					block * b = m_free[pool];
+					m_free[pool] = b->next;
+
+					return b;
+				}
+
+				void do_deallocate( void * p, size_t bytes, size_t alignment ) override
+				{
+					if( bytes > max_block or alignment > max_align )
+					{
+						deallocate_large( p, alignment );
+						return;
+					}
+
+					size_t pool = pool_index( bytes );
+					block * b = static_cast<block*>( p );
+					b->next = m_free[pool];
+					m_free[pool] = b;
+				}
+
+			private:
+				/// A free block, linked in the free list of its pool.
+				struct block
+				{
+					block * next; //!< Next free block of the same size.
+				};
+
+				/// Header of every storage taken from upstream: slabs and large blocks.
+				struct alignas(std::max_align_t) slab
+				{
+					slab * next; //!< Slab allocated before this one.
+					slab * prev; //!< Slab allocated after this one, to unlink large blocks.
+					size_t size; //!< Size of the storage, header included.
+					size_t alignment; //!< Alignment asked from upstream.
+				};
+
+				/// Returns the pool of blocks of at least bytes.
+				static size_t pool_index( size_t bytes )
+				{
+					size_t pool{0u};
+					for( size_t size = min_block ; size < bytes ; size *= 2 )
+						++pool;
+					return pool;
+				}
+
+				/// Takes size bytes from upstream and links them in the slab list.
+				slab * new_slab( size_t size, size_t alignment )
+				{
+					slab * s = static_cast<slab*>( m_upstream->allocate( size, alignment ) );
+					s->next = m_slabs;
+					s->prev = nullptr;
+					s->size = size;
+					s->alignment = alignment;
+					if( m_slabs != nullptr )
+						m_slabs->prev = s;
+					m_slabs = s;
+
+					return s;
+				}
+
+				/// Cuts a new slab into free blocks of the pool. Each slab of a pool is twice the previous one.
+				void refill( size_t pool )
+				{
+					size_t block_size = min_block << pool;
+					if( m_blocks_per_slab[pool] == 0 )
+						m_blocks_per_slab[pool] = slab_size / block_size != 0 ? slab_size / block_size : 1;
+					size_t count = m_blocks_per_slab[pool];
+					m_blocks_per_slab[pool] *= 2;
+
+					slab * s = new_slab( sizeof(slab) + count * block_size, alignof(slab) );
+					char * first = reinterpret_cast<char*>( s + 1 );
+					for( size_t i{count} ; i > 0 ; --i )
+					{
+						block * b = reinterpret_cast<block*>( first + ( i - 1 ) * block_size );
+						b->next = m_free[pool];
+						m_free[pool] = b;
+					}
+				}
+
+				/// Size of the header before a large block, a multiple of both the header and alignment.
+				static size_t large_header( size_t alignment )
+				{ return sizeof(slab) > alignment ? sizeof(slab) : alignment; }
+
+				/// Serves a request too large for the pools straight from upstream.
+				void * allocate_large( size_t bytes, size_t alignment )
+				{
+					size_t header = large_header( alignment );
+					slab * s = new_slab( header + bytes, alignment > alignof(slab) ? alignment : alignof(slab) );
+
+					return reinterpret_cast<char*>( s ) + header;
+				}
+
+				/// Gives a large block back to upstream.
+				void deallocate_large( void * p, size_t alignment )
+				{
+					slab * s = reinterpret_cast<slab*>( static_cast<char*>( p ) - large_header( alignment ) );
+
+					if( s->prev != nullptr )
+						s->prev->next = s->next;
+					else
+						m_slabs = s->next;
+					if( s->next != nullptr )
+						s->next->prev = s->prev;
+
+					m_upstream->deallocate( s, s->size, s->alignment );
+				}
+
+			private:
+				memory_resource * m_upstream; //!< Where slabs come from.
+				slab * m_slabs; //!< Last allocated slab or large block.
+				block * m_free[pool_count]; //!< Free list of each pool.
+				size_t m_blocks_per_slab[pool_count]; //!< Blocks in the next slab of each pool.
+		}; // class unsynchronized_pool_resource
+
+
+		/*! \class polymorphic_allocator
+			\brief allocator that forwards to a memory_resource.
+
+			It does not propagate: a container keeps its resource on copy, move and swap, and a
+			copy of a container uses the default resource.
+		*/
+		template< typename T >
+		class polymorphic_allocator{
+
+			public:
+				//=== Alias
+				typedef T value_type; //!< Type of the elements.
+
+				//=== Constructors
+				/// Allocator over the global operator new and delete.
+				polymorphic_allocator( )
+					: m_resource{new_delete_resource()}
+				{/*empty*/}
+
+				/// Allocator over resource.
+				polymorphic_allocator( memory_resource * resource )
+					: m_resource{resource}
+				{/*empty*/}
+
+				/// Rebinding constructor.
+				template< typename U >
+				polymorphic_allocator( const polymorphic_allocator<U> & other )
+					: m_resource{other.resource()}
+				{/*empty*/}
+
+				polymorphic_allocator & operator=( const polymorphic_allocator & ) = delete;
+
+			public:
+				//=== Methods
+				/// Returns storage for n elements.
+				T * allocate( size_t n )
+				{ return static_cast<T*>( m_resource->allocate( n * sizeof(T), alignof(T) ) ); }
+
+				/// Gives back the storage p of n elements.
+				void deallocate( T * p, size_t n )
+				{ m_resource->deallocate( p, n * sizeof(T), alignof(T) ); }
+
+				/// Copies of a container go to the default resource.
+				polymorphic_allocator select_on_container_copy_construction( ) const
+				{ return polymorphic_allocator(); }
+
+				/// Returns the resource.
+				memory_resource * resource( ) const
+				{ return m_resource; }
+
+			private:
+				memory_resource * m_resource; //!< Where the storage comes from.
+		}; // class polymorphic_allocator
+
+		template< typename T, typename U >
+		bool operator==( const polymorphic_allocator<T> & lhs, const polymorphic_allocator<U> & rhs )
+		{ return *lhs.resource() == *rhs.resource(); }
+
+		template< typename T, typename U >
+		bool operator!=( const polymorphic_allocator<T> & lhs, const polymorphic_allocator<U> & rhs )
+		{ return not ( lhs == rhs ); }
+
+		/// sc::vector whose storage comes from a memory_resource.
+		template< typename T, typename Growth = growth::doubling >
+		using vector = sc::vector< T, polymorphic_allocator<T>, Growth >;
+
+	} // namespace pmr
+
+} // namespace sc
+
+#endif
\ No newline at end of file
@@ -0,0 +1,435 @@
+#ifndef MMAP_VECTOR_H
+#define MMAP_VECTOR_H
+
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <functional>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vector.h"
+#include "serialize.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \class mmap_vector
+		\brief vector of trivially copyable elements whose storage is a memory-mapped file.
+
+		The file starts with a 64 byte header (a magic number, the format version, sizeof(T) and
+		the number of elements) followed by the elements, as they are laid out in memory: the
+		layout of the lists saved by sc::io::save(), which this class opens as well. The whole
+		file is mapped shared, so the elements are written to the file as they are assigned and
+		opening it again gives them back with no parsing: pages are read on first access, and a
+		list larger than the memory only keeps the pages in use resident.
+
+		The file holds capacity() elements. reserve() and the growth of push_back() extend it with
+		ftruncate (the new part takes no disk space until written) and remap it with mremap, which
+		may move the mapping: as with sc::vector, growing invalidates pointers and iterators.
+
+		The file is read and written in the byte order of the machine. Errors of the system calls
+		are thrown as std::system_error; a file of another format or element size throws
+		std::runtime_error. A list opened read_only throws std::logic_error from the methods that
+		change its size, and must not be written through operator[].
+	*/
+	template< typename T, typename Growth = growth::doubling >
+	class mmap_vector{
+
+		static_assert( std::is_trivially_copyable<T>::value, "mmap_vector stores trivially copyable elements only" );
+
+		public:
+			//=== Alias
+			typedef size_t size_type; //!< Type of size.
+			typedef T value_type; //!< Type of the elements.
+			typedef Growth growth_policy; //!< Growth policy of the file.
+			typedef T * iterator; //!< Random access iterator, a pointer into the mapping.
+			typedef const T * const_iterator; //!< Random access iterator to const elements.
+
+			/// How the file is opened.
+			enum open_mode
+			{
+				open_or_create, //!< Keeps the elements of an existing file, creates a missing one.
+				truncate, //!< Starts empty, whether the file existed or not.
+				read_only //!< Maps an existing file for reading only.
+			};
+
+		protected:
+			typedef io::header header; //!< First bytes of the file, shared with the saved lists of sc::io.
+
+			static_assert( alignof(T) <= sizeof(header), "elements are aligned on the header size at most" );
+
+		public:
+			//=== Constructors
+			/// Maps the file at path, opened by mode.
+			explicit mmap_vector( const std::string & path, open_mode mode = open_or_create )
+				: m_path{path}, m_fd{-1}, m_map{nullptr}, m_bytes{0}, m_writable{mode != read_only}
+			{
+				int flags = mode == read_only ? O_RDONLY : O_RDWR | O_CREAT;
+				if( mode == truncate )
+					flags |= O_TRUNC;
+
+				m_fd = ::open( path.c_str(), flags | O_CLOEXEC, 0644 );
+				if( m_fd < 0 )
+					fail( "open" );
+
+				try { map_file(); }
+				catch( ... ) { close(); throw; }
+			}
+
+			mmap_vector( const mmap_vector & ) = delete;
+			mmap_vector & operator=( const mmap_vector & ) = delete;
+
+			/// Move constructor. Takes the mapping of other, leaving it closed.
+			mmap_vector( mmap_vector && other ) noexcept
+				: m_path{std::move( other.m_path )}, m_fd{other.m_fd}, m_map{other.m_map},
+				  m_bytes{other.m_bytes}, m_writable{other.m_writable}
+			{
+				other.m_fd = -1;
+				other.m_map = nullptr;
+				other.m_bytes = 0;
+			}
+
+			/// Move assignment. Closes the current file and takes the mapping of other.
+			mmap_vector & operator=( mmap_vector && other ) noexcept
+			{
+				if( this != &other )
+				{
+					close();
+					m_path = std::move( other.m_path );
+					m_fd = other.m_fd;
+					m_map = other.m_map;
+					m_bytes = other.m_bytes;
+					m_writable = other.m_writable;
+					other.m_fd = -1;
+					other.m_map = nullptr;
+					other.m_bytes = 0;
+				}
+				return *this;
+			}
+
+			/// Destructor. Unmaps and closes the file; the kernel writes the dirty pages back.
+			~mmap_vector( )
+			{ close(); }
+
+		public:
+			//=== Iterators
+			iterator begin( )
+			{ return iterator( data() ); }
+
+			iterator end( )
+			{ return iterator( data() + size() ); }
+
+			const_iterator begin( ) const
+			{ return const_iterator( data() ); }
+
+			const_iterator end( ) const
+			{ return const_iterator( data() + size() ); }
+
+			const_iterator cbegin( ) const
+			{ return begin(); }
+
+			const_iterator cend( ) const
+			{ return end(); }
+
+		public:
+			//=== Methods
+			/// Returns the number of elements.
+			size_type size( ) const
+			{ return m_map != nullptr ? (size_type) meta().size : 0; }
+
+			/// Returns how many elements the file holds.
+			size_type capacity( ) const
+			{ return m_bytes > sizeof(header) ? ( m_bytes - sizeof(header) ) / sizeof(T) : 0; }
+
+			/// Checks whether the list has no element.
+			bool empty( ) const
+			{ return size() == 0; }
+
+			/// Returns the path of the file.
+			const std::string & path( ) const
+			{ return m_path; }
+
+			/// Returns the first element in the mapping.
+			T * data( )
+			{ return reinterpret_cast<T*>( m_map + sizeof(header) ); }
+
+			const T * data( ) const
+			{ return reinterpret_cast<const T*>( m_map + sizeof(header) ); }
+
+			/// Return the object at the index position.
+			T & operator[]( size_type pos )
+			{ return data()[pos]; }
+
+			const T & operator[]( size_type pos ) const
+			{ return data()[pos]; }
+
+			/// Returns the object at the index pos. Throws std::out_of_range if pos is not below size().
+			T & at( size_type pos )
+			{
+				if( pos >= size() )
+					throw std::out_of_range("error in at(): out of range");
+				return data()[pos];
+			}
+
+			const T & at( size_type pos ) const
+			{
+				if( pos >= size() )
+					throw std::out_of_range("error in at(): out of range");
+				return data()[pos];
+			}
+
+			/// Return the first element.
+			T & front( )
+			{ return data()[0]; }
+
+			const T & front( ) const
+			{ return data()[0]; }
+
+			/// Return the last element.
+			T & back( )
+			{ return data()[size() - 1]; }
+
+			const T & back( ) const
+			{ return data()[size() - 1]; }
+
+			/// Appends a copy of value, growing the file if it is full.
+			void push_back( const T & value )
+			{
+				T copy = value; // value may live in the mapping, which growth moves.
+				require_writable();
+				if( size() == capacity() )
+					reserve( grown_capacity( size() + 1 ) );
+				data()[size()] = copy;
+				set_size( size() + 1 );
+			}
+
+			/// Appends an element constructed from args.
+			template< typename... Args >
+			void emplace_back( Args&&... args )
+			{ push_back( T( std::forward<Args>( args )... ) ); }
+
+			/// Appends copies of the elements in [first, last).
+			template< typename InputIt >
+			void push_back( InputIt first, InputIt last )
+			{
+				size_type count = (size_type) std::distance( first, last );
+				require_writable();
+				if( size() + count > capacity() )
+				{
+					// The range may lie in the mapping, which growth moves: it is then copied from its new place.
+					const T * source = count != 0 ? in_mapping( first ) : nullptr;
+					size_type offset = source != nullptr ? (size_type) ( source - data() ) : 0;
+					reserve( grown_capacity( size() + count ) );
+					if( source != nullptr )
+					{
+						std::copy( data() + offset, data() + offset + count, data() + size() );
+						set_size( size() + count );
+						return;
+					}
+				}
+				std::copy( first, last, data() + size() );
+				set_size( size() + count );
+			}
+
+			/// Removes the last element.
+			void pop_back( )
+			{ set_size( size() - 1 ); }
+
+			/// Removes every element. The file keeps its capacity.
+			void clear( )
+			{ set_size( 0 ); }
+
+			/// Resizes the list to count elements. New elements are value-initialized.
+			void resize( size_type count )
+			{ resize( count, T() ); }
+
+			/// Resizes the list to count elements. New elements are copies of value.
+			void resize( size_type count, const T & value )
+			{
+				T copy = value;
+				require_writable();
+				if( count > capacity() )
+					reserve( count );
+				if( count > size() )
+					std::fill( data() + size(), data() + count, copy );
+				set_size( count );
+			}
+
+			/// Grows the file to hold new_cap elements and remaps it.
+			void reserve( size_type new_cap )
+			{
+				if( new_cap > capacity() )
+					remap( sizeof(header) + new_cap * sizeof(T) );
+			}
+
+			/// Shrinks the file to the elements it holds.
+			void shrink_to_fit( )
+			{
+				if( size() < capacity() )
+					remap( sizeof(header) + size() * sizeof(T) );
+			}
+
+			/// Writes the dirty pages to the file and waits for the disk.
+			void sync( )
+			{
+				if( m_map != nullptr and m_writable and ::msync( m_map, m_bytes, MS_SYNC ) != 0 )
+					fail( "msync" );
+			}
+
+		protected:
+			/// Throws the error of the system call call.
+			[[noreturn]] static void fail( const char * call )
+			{ throw std::system_error( errno, std::generic_category(), std::string( "error in mmap_vector(): " ) + call ); }
+
+			header & meta( )
+			{ return *reinterpret_cast<header*>( m_map ); }
+
+			const header & meta( ) const
+			{ return *reinterpret_cast<const header*>( m_map ); }
+
+			/// Throws std::logic_error if the file was opened read only.
+			void require_writable( ) const
+			{
+				if( not m_writable )
+					throw std::logic_error( "error in mmap_vector(): the file is read only" );
+			}
+
+			/// Stores the number of elements in the header.
+			void set_size( size_type count )
+			{
+				require_writable();
+				meta().size = count;
+			}
+
+			/// Returns the address of the element it refers to if that lies in the mapping, nullptr otherwise.
+			template< typename It >
+			const T * in_mapping( It it ) const
+			{
+				typedef decltype( *it ) reference;
+				return in_mapping( it, std::integral_constant< bool, std::is_lvalue_reference<reference>::value
+					and std::is_same< typename std::decay<reference>::type, T >::value >() );
+			}
+
+			template< typename It >
+			const T * in_mapping( It it, std::true_type ) const
+			{
+				const T * p = std::addressof( *it );
+				std::less<const T*> before;
+				return not before( p, data() ) and before( p, data() + capacity() ) ? p : nullptr;
+			}
+
+			template< typename It >
+			const T * in_mapping( It, std::false_type ) const
+			{ return nullptr; }
+
+			/// Asks the growth policy for the capacity after the current one, never less than required.
+			size_type grown_capacity( size_type required ) const
+			{
+				size_type new_cap = Growth::grow( capacity(), required, sizeof(T) );
+				return new_cap < required ? required : new_cap;
+			}
+
+			/// Maps the open file, writing the header of an empty one and checking that of the others.
+			void map_file( )
+			{
+				struct stat info;
+				if( ::fstat( m_fd, &info ) != 0 )
+					fail( "fstat" );
+
+				size_type bytes = (size_type) info.st_size;
+				bool fresh = bytes == 0;
+				if( fresh )
+				{
+					if( not m_writable )
+						throw std::runtime_error( "error in mmap_vector(): " + m_path + " is empty" );
+					bytes = sizeof(header);
+					if( ::ftruncate( m_fd, (off_t) bytes ) != 0 )
+						fail( "ftruncate" );
+				}
+				else if( bytes < sizeof(header) )
+					throw std::runtime_error( "error in mmap_vector(): " + m_path + " is not a mmap_vector file" );
+
+				int protection = m_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+				void * map = ::mmap( nullptr, bytes, protection, MAP_SHARED, m_fd, 0 );
+				if( map == MAP_FAILED )
+					fail( "mmap" );
+				m_map = static_cast<char*>( map );
+				m_bytes = bytes;
+
+				if( fresh )
+				{
+					meta() = io::make_header( sizeof(T), 0 );
+					return;
+				}
+
+				if( std::memcmp( meta().magic, io::magic(), sizeof(meta().magic) ) != 0 or meta().version != io::format_version )
+					throw std::runtime_error( "error in mmap_vector(): " + m_path + " is not a mmap_vector file" );
+				if( meta().element_size != sizeof(T) )
+					throw std::runtime_error( "error in mmap_vector(): " + m_path + " holds elements of another size" );
+				if( meta().size > capacity() )
+					throw std::runtime_error( "error in mmap_vector(): " + m_path + " is truncated" );
+			}
+
+			/// Resizes the file to bytes and its mapping with it.
+			void remap( size_type bytes )
+			{
+				require_writable();
+
+				// The file grows before the mapping, and shrinks after it: no page is mapped past its end.
+				size_type old_bytes = m_bytes;
+				if( bytes > old_bytes and ::ftruncate( m_fd, (off_t) bytes ) != 0 )
+					fail( "ftruncate" );
+
+#ifdef __linux__
+				void * map = ::mremap( m_map, m_bytes, bytes, MREMAP_MAYMOVE );
+				if( map == MAP_FAILED )
+					fail( "mremap" );
+#else
+				void * map = ::mmap( nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0 );
+				if( map == MAP_FAILED )
+					fail( "mmap" );
+				::munmap( m_map, m_bytes );
+#endif
+				m_map = static_cast<char*>( map );
+				m_bytes = bytes;
+
+				if( bytes < old_bytes and ::ftruncate( m_fd, (off_t) bytes ) != 0 )
+					fail( "ftruncate" );
+			}
+
+			/// Unmaps and closes the file.
+			void close( ) noexcept
+			{
+				if( m_map != nullptr )
+					::munmap( m_map, m_bytes );
+				if( m_fd >= 0 )
+					::close( m_fd );
+				m_map = nullptr;
+				m_fd = -1;
+				m_bytes = 0;
+			}
+
+		protected:
+			std::string m_path; //!< Path of the file.
+			int m_fd; //!< Descriptor of the open file.
+			char * m_map; //!< Start of the mapping: the header, then the elements.
+			size_type m_bytes; //!< Bytes mapped, the size of the file.
+			bool m_writable; //!< Whether the file was opened for writing.
+	};
+
+} // namespace sc
+
+#endif
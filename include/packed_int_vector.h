@@ -0,0 +1,477 @@
+#ifndef PACKED_INT_VECTOR_H
+#define PACKED_INT_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "vector.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \namespace packing
+		\brief how a packed_int_vector block stores its values.
+
+		A policy has a static member linear: false stores each value as an offset from the smallest
+		value of its block, true as an offset from the line through the first and last values of
+		the block.
+	*/
+	namespace packing{
+
+		/*! \struct frame
+			\brief frame of reference: the block needs as many bits as its largest minus its smallest value.
+		*/
+		struct frame
+		{
+			static constexpr bool linear = false;
+		};
+
+		/*! \struct delta
+			\brief for sorted values, such as ids and timestamps: the block needs as many bits as
+			the widest gap between a value and first + i * (the mean delta of the block).
+		*/
+		struct delta
+		{
+			static constexpr bool linear = true;
+		};
+
+	} // namespace packing
+
+	/*! \class packed_int_vector
+		\brief append-only list of integers, bit-packed in blocks of block_size values.
+
+		Each full block is sealed into width bit fields, width being the fewest bits that hold
+		every value of the block once its frame is taken out: a base, plus i * slope with the
+		packing::delta policy. A block of ids or timestamps that span 20 bits then takes 20 bits
+		per value, plus 32 bytes of frame per block, instead of 64.
+
+		Value i is read in O(1): one frame, one or two words, a shift and a mask. Iterators keep
+		the frame of the last block they read, and for_each() decodes a block at a time.
+		push_back() appends to a tail of plain values and seals it when it is full, so only the
+		tail block is ever encoded; pop_back() on an empty tail decodes the last block back into it.
+	*/
+	template< typename T, typename Packing = packing::frame, typename Alloc = std::allocator<T> >
+	class packed_int_vector{
+
+		static_assert( std::is_integral<T>::value and not std::is_same<T, bool>::value, "packed_int_vector holds integers" );
+
+		public:
+			//=== Alias
+			typedef size_t size_type; //!< Type of size.
+			typedef T value_type; //!< Type of the elements.
+			typedef Alloc allocator_type; //!< Type of the allocator.
+			typedef Packing packing_policy; //!< How blocks store their values.
+
+			class const_iterator;
+			typedef const_iterator iterator; //!< Values are read only.
+
+			static constexpr size_type block_size = 256; //!< Values of a block.
+
+		protected:
+			typedef std::allocator_traits<Alloc> alloc_traits; //!< Allocator interface.
+
+			/// Frame of a sealed block: the key of value i is base + i * slope + its bit field, modulo 2^64.
+			struct block
+			{
+				uint64_t base; //!< Key of the smallest offset.
+				uint64_t slope; //!< Mean delta of the block, 0 with packing::frame.
+				size_type offset; //!< First word of the bit fields.
+				unsigned width; //!< Bits per value, from 0 (all values on the frame) to 64.
+			};
+
+			typedef typename alloc_traits::template rebind_alloc<uint64_t> word_alloc; //!< Allocator of the bit fields.
+			typedef typename alloc_traits::template rebind_alloc<block> block_alloc; //!< Allocator of the frames.
+			typedef vector< uint64_t, word_alloc > word_list; //!< Bit fields of the sealed blocks.
+			typedef vector< block, block_alloc > block_list; //!< Frames of the sealed blocks.
+
+			/// Flipping the sign bit maps signed values onto unsigned keys in the same order.
+			static constexpr uint64_t sign_flip = std::is_signed<T>::value ? uint64_t(1) << 63 : 0;
+
+		public:
+			//=== Constructors
+			/// Empty list. Allocates nothing.
+			explicit packed_int_vector( const Alloc & alloc = Alloc() )
+				: m_words( word_alloc( alloc ) ), m_blocks( block_alloc( alloc ) ), m_tail( alloc )
+			{/*empty*/}
+
+			/// List of the values in [first, last).
+			template< typename InputIt >
+			packed_int_vector( InputIt first, InputIt last, const Alloc & alloc = Alloc() )
+				: packed_int_vector( alloc )
+			{
+				for( ; first != last ; ++first )
+					push_back( *first );
+			}
+
+			/// List of the values in ilist.
+			packed_int_vector( std::initializer_list<T> ilist, const Alloc & alloc = Alloc() )
+				: packed_int_vector( ilist.begin(), ilist.end(), alloc )
+			{/*empty*/}
+
+			//=== Iterators
+			/// Returns an iterator pointing to the first value.
+			const_iterator begin( ) const
+			{ return const_iterator( this, 0 ); }
+
+			/// Returns an iterator pointing just after the last value.
+			const_iterator end( ) const
+			{ return const_iterator( this, size() ); }
+
+			const_iterator cbegin( ) const
+			{ return begin(); }
+
+			const_iterator cend( ) const
+			{ return end(); }
+
+			//=== Methods
+			/// Returns the number of values.
+			size_type size( ) const
+			{ return m_blocks.size() * block_size + m_tail.size(); }
+
+			/// Checks if the list is empty.
+			bool empty( ) const
+			{ return size() == 0; }
+
+			/// Returns the bytes of storage held, sealed blocks, frames and tail.
+			size_type storage_bytes( ) const
+			{
+				return m_words.capacity() * sizeof(uint64_t) + m_blocks.capacity() * sizeof(block)
+					+ m_tail.capacity() * sizeof(T);
+			}
+
+			/// Adds value to the end of the list. A full tail is sealed first, in O(block_size).
+			void push_back( T value )
+			{
+				if( m_tail.size() == block_size )
+					seal();
+				else if( m_tail.capacity() == 0 )
+					m_tail.reserve( block_size );
+				m_tail.push_back( value );
+			}
+
+			/// Removes the value at the end of the list.
+			void pop_back( )
+			{
+				if( m_tail.size() == 0 )
+					unseal();
+				m_tail.pop_back();
+			}
+
+			/// Removes all values, and gives back the storage of the sealed blocks.
+			void clear( )
+			{
+				m_words = word_list( m_words.get_allocator() );
+				m_blocks = block_list( m_blocks.get_allocator() );
+				m_tail.clear();
+			}
+
+			/// Gives back the storage past the sealed blocks.
+			void shrink_to_fit( )
+			{
+				m_words.shrink_to_fit();
+				m_blocks.shrink_to_fit();
+			}
+
+			/// Returns the value at index pos.
+			T operator[]( size_type pos ) const
+			{
+				size_type b = pos / block_size;
+				if( b == m_blocks.size() )
+					return m_tail[pos % block_size];
+				return value_at( m_blocks[b], words() + m_blocks[b].offset, pos % block_size );
+			}
+
+			/// Returns the value at index pos.
+			T at( size_type pos ) const
+			{
+				if( not (pos < size()) )
+					throw std::out_of_range("error in at(): out of range");
+				return (*this)[pos];
+			}
+
+			/// Returns the first value.
+			T front( ) const
+			{ return (*this)[0]; }
+
+			/// Returns the last value.
+			T back( ) const
+			{ return (*this)[size() - 1]; }
+
+			/// Calls f on every value, in order. Each sealed block is decoded whole into a buffer first.
+			template< typename F >
+			void for_each( F f ) const
+			{
+				T values[block_size];
+				for( size_type b{0u} ; b < m_blocks.size() ; ++b )
+				{
+					decode( m_blocks[b], values );
+					for( size_type i{0u} ; i < block_size ; ++i )
+						f( values[i] );
+				}
+				for( size_type i{0u} ; i < m_tail.size() ; ++i )
+					f( m_tail[i] );
+			}
+
+			//=== Operators overload
+			/// Tells whether both lists hold the same values.
+			bool operator==( const packed_int_vector & rhs ) const
+			{
+				if( size() != rhs.size() )
+					return false;
+				for( const_iterator a = begin(), b = rhs.begin() ; a != end() ; ++a, ++b )
+					if( *a != *b )
+						return false;
+				return true;
+			}
+
+			bool operator!=( const packed_int_vector & rhs ) const
+			{ return not( *this == rhs ); }
+
+		protected:
+			//=== Encoding
+			/// Returns the key of value: unsigned, in the same order.
+			static uint64_t key( T value )
+			{ return static_cast<uint64_t>( value ) ^ sign_flip; }
+
+			/// Returns the value of key.
+			static T from_key( uint64_t key )
+			{ return static_cast<T>( key ^ sign_flip ); }
+
+			/// Tells whether offset a is below offset b. Offsets from a line are signed.
+			static bool below( uint64_t a, uint64_t b )
+			{ return Packing::linear ? (int64_t) a < (int64_t) b : a < b; }
+
+			/// Returns the mask of a bit field of width bits.
+			static uint64_t mask( unsigned width )
+			{ return width == 64 ? ~uint64_t(0) : ( uint64_t(1) << width ) - 1; }
+
+			/// Returns the first word of the sealed blocks, nullptr if there is none.
+			const uint64_t * words( ) const
+			{ return m_words.size() == 0 ? nullptr : &m_words[0]; }
+
+			/// Returns value i of the block b, whose bit fields start at fields.
+			static T value_at( const block & b, const uint64_t * fields, size_type i )
+			{
+				uint64_t field{0u};
+				if( b.width != 0 )
+				{
+					size_type bit = i * b.width;
+					size_type shift = bit % 64;
+					field = fields[bit / 64] >> shift;
+					if( shift + b.width > 64 )
+						field |= fields[bit / 64 + 1] << ( 64 - shift );
+					field &= mask( b.width );
+				}
+				return from_key( b.base + i * b.slope + field );
+			}
+
+			/// Decodes the block b into values.
+			void decode( const block & b, T * values ) const
+			{
+				if( b.width == 0 )
+				{
+					for( size_type i{0u} ; i < block_size ; ++i )
+						values[i] = from_key( b.base + i * b.slope );
+					return;
+				}
+
+				// The fields are read in order: a cursor moves through the words instead of computing i * width.
+				const uint64_t * fields = words() + b.offset;
+				uint64_t field_mask = mask( b.width );
+				uint64_t line = b.base;
+				size_type shift{0u};
+				for( size_type i{0u} ; i < block_size ; ++i )
+				{
+					uint64_t field = fields[0] >> shift;
+					if( shift + b.width > 64 )
+						field |= fields[1] << ( 64 - shift );
+					shift += b.width;
+					fields += shift / 64;
+					shift %= 64;
+					values[i] = from_key( line + ( field & field_mask ) );
+					line += b.slope;
+				}
+			}
+
+			/// Encodes the full tail as a new sealed block, and empties the tail.
+			void seal( )
+			{
+				uint64_t keys[block_size];
+				for( size_type i{0u} ; i < block_size ; ++i )
+					keys[i] = key( m_tail[i] );
+
+				// The frame: a line through the first and last keys with packing::delta, else 0; then
+				// the offsets from it, and the base that makes the smallest of them 0.
+				block b;
+				uint64_t origin = Packing::linear ? keys[0] : 0;
+				b.slope = Packing::linear and keys[block_size - 1] > keys[0] ? ( keys[block_size - 1] - keys[0] ) / ( block_size - 1 ) : 0;
+				uint64_t low = keys[0] - origin, high = low;
+				for( size_type i{1u} ; i < block_size ; ++i )
+				{
+					keys[i] -= origin + i * b.slope;
+					if( below( keys[i], low ) )
+						low = keys[i];
+					if( below( high, keys[i] ) )
+						high = keys[i];
+				}
+				keys[0] -= origin;
+				b.base = origin + low;
+				b.width = high == low ? 0 : 64 - __builtin_clzll( high - low );
+				b.offset = m_words.size();
+
+				// block_size * width bits are a whole number of words.
+				m_words.resize( b.offset + block_size / 64 * b.width );
+				if( b.width != 0 )
+				{
+					uint64_t * fields = &m_words[b.offset];
+					for( size_type i{0u} ; i < block_size ; ++i )
+					{
+						uint64_t field = keys[i] - low;
+						size_type bit = i * b.width;
+						size_type shift = bit % 64;
+						fields[bit / 64] |= field << shift;
+						if( shift + b.width > 64 )
+							fields[bit / 64 + 1] |= field >> ( 64 - shift );
+					}
+				}
+
+				try { m_blocks.push_back( b ); }
+				catch( ... ) { m_words.resize( b.offset ); throw; }
+				m_tail.clear();
+			}
+
+			/// Decodes the last sealed block back into the empty tail.
+			void unseal( )
+			{
+				const block b = m_blocks.back();
+				m_tail.resize( block_size );
+				decode( b, &m_tail[0] );
+				m_words.resize( b.offset );
+				m_blocks.pop_back();
+			}
+
+		protected:
+			word_list m_words; //!< Bit fields of the sealed blocks, one after the other.
+			block_list m_blocks; //!< Frame of each sealed block.
+			vector< T, Alloc > m_tail; //!< Plain values past the sealed blocks, at most block_size.
+
+		public:
+
+		/*! \class const_iterator
+			\brief random access iterator over the values of a packed_int_vector.
+
+			It keeps the frame of the last block it read, so that a scan looks the frame up once
+			per block rather than once per value.
+		*/
+		class const_iterator{
+			public:
+				//=== Alias
+				typedef std::ptrdiff_t difference_type; //!< Distance between two iterators.
+				typedef T value_type; //!< Type of the pointed element.
+				typedef void pointer; //!< Values are decoded, they have no address.
+				typedef T reference; //!< Values are read by value.
+				typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+
+				//=== Constructor
+				const_iterator( const packed_int_vector * list = nullptr, size_type index = 0 )
+					: m_list{list}, m_index{index}, m_block{nullptr}, m_fields{nullptr}, m_first{0}, m_last{0}
+				{/*empty*/}
+
+				//=== Operators
+				reference operator*( ) const
+				{
+					if( m_index < m_first or m_index >= m_last )
+					{
+						size_type b = m_index / block_size;
+						m_first = b * block_size;
+						m_last = m_first + block_size;
+						if( b == m_list->m_blocks.size() )
+							m_block = nullptr;
+						else
+						{
+							m_block = &m_list->m_blocks[b];
+							m_fields = m_list->words() + m_block->offset;
+						}
+					}
+					if( m_block == nullptr )
+						return m_list->m_tail[m_index - m_first];
+					return value_at( *m_block, m_fields, m_index - m_first );
+				}
+
+				reference operator[]( difference_type n ) const
+				{ return *( *this + n ); }
+
+				const_iterator & operator++( )
+				{ ++m_index; return *this; }
+
+				const_iterator operator++( int )
+				{ const_iterator old( *this ); ++m_index; return old; }
+
+				const_iterator & operator--( )
+				{ --m_index; return *this; }
+
+				const_iterator operator--( int )
+				{ const_iterator old( *this ); --m_index; return old; }
+
+				const_iterator & operator+=( difference_type n )
+				{ m_index += n; return *this; }
+
+				const_iterator & operator-=( difference_type n )
+				{ m_index -= n; return *this; }
+
+				const_iterator operator+( difference_type n ) const
+				{ const_iterator it( *this ); return it += n; }
+
+				friend const_iterator operator+( difference_type n, const const_iterator & it )
+				{ return it + n; }
+
+				const_iterator operator-( difference_type n ) const
+				{ const_iterator it( *this ); return it -= n; }
+
+				difference_type operator-( const const_iterator & rhs ) const
+				{ return (difference_type) m_index - (difference_type) rhs.m_index; }
+
+				bool operator==( const const_iterator & rhs ) const
+				{ return m_index == rhs.m_index; }
+
+				bool operator!=( const const_iterator & rhs ) const
+				{ return m_index != rhs.m_index; }
+
+				bool operator<( const const_iterator & rhs ) const
+				{ return m_index < rhs.m_index; }
+
+				bool operator>( const const_iterator & rhs ) const
+				{ return m_index > rhs.m_index; }
+
+				bool operator<=( const const_iterator & rhs ) const
+				{ return m_index <= rhs.m_index; }
+
+				bool operator>=( const const_iterator & rhs ) const
+				{ return m_index >= rhs.m_index; }
+
+			private:
+				const packed_int_vector * m_list; //!< Iterated list.
+				size_type m_index; //!< Index of the pointed value.
+				mutable const block * m_block; //!< Frame of the last block read, nullptr for the tail.
+				mutable const uint64_t * m_fields; //!< Bit fields of that block.
+				mutable size_type m_first; //!< Index of the first value of that block.
+				mutable size_type m_last; //!< Index past its last value.
+		};
+	};
+
+	template< typename T, typename Packing, typename Alloc >
+	constexpr typename packed_int_vector<T, Packing, Alloc>::size_type packed_int_vector<T, Packing, Alloc>::block_size;
+
+	template< typename T, typename Packing, typename Alloc >
+	constexpr uint64_t packed_int_vector<T, Packing, Alloc>::sign_flip;
+
+} // namespace sc
+
+#endif
@@ -0,0 +1,474 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "vector.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \namespace parallel
+		\brief algorithms over the elements of a sc::vector, run on a pool of threads.
+
+		The buffer is cut into chunks whose inner bounds fall on cache line boundaries, so two
+		threads never write to the same line, and the chunks are spread over a work-stealing
+		thread_pool. The calling thread runs chunks too. Below a size threshold, or with a pool
+		without threads, the algorithms run serially on the calling thread.
+
+		The callables run concurrently and must not touch the same data without synchronization.
+		An exception thrown by a chunk is rethrown by the algorithm once every chunk has finished.
+	*/
+	namespace parallel{
+
+		static constexpr size_t cache_line = 64; //!< Bytes of a cache line.
+		static constexpr size_t default_threshold = 1 << 15; //!< Elements below which an algorithm runs serially.
+		static constexpr size_t min_chunk = 1 << 12; //!< Fewest elements of a chunk.
+		static constexpr size_t chunks_per_thread = 4; //!< Chunks per thread, spare work for the thieves.
+
+		/// Threads of a pool built without a count: one per hardware thread.
+		inline size_t hardware_threads( )
+		{
+			size_t threads = std::thread::hardware_concurrency();
+			return threads != 0 ? threads : 1;
+		}
+
+		/*! \class thread_pool
+			\brief fixed set of worker threads, each with its own queue of tasks.
+
+			A worker takes tasks from the back of its own queue and, when it is empty, steals from
+			the front of the others. Tasks submitted by a worker go to its own queue; the others
+			are dealt round-robin. A pool is not copied; destroying it drops the queued tasks and
+			joins the workers after their current task.
+		*/
+		class thread_pool{
+
+			public:
+				typedef std::function<void()> task; //!< Unit of work.
+
+				//=== Constructors
+				/// Starts threads workers. A pool of 0 threads runs each task in submit().
+				explicit thread_pool( size_t threads = hardware_threads() )
+					: m_queued{0}, m_next{0}, m_stop{false}
+				{
+					for( size_t i{0u} ; i < threads ; ++i )
+						m_queues.emplace_back( new queue );
+					for( size_t i{0u} ; i < threads ; ++i )
+						m_threads.emplace_back( &thread_pool::work, this, i );
+				}
+
+				thread_pool( const thread_pool & ) = delete;
+				thread_pool & operator=( const thread_pool & ) = delete;
+
+				/// Destructor. Stops and joins the workers.
+				~thread_pool( )
+				{
+					{
+						std::lock_guard<std::mutex> guard( m_lock );
+						m_stop = true;
+					}
+					m_wake.notify_all();
+					for( auto & thread : m_threads )
+						thread.join();
+				}
+
+			public:
+				//=== Methods
+				/// Returns the number of worker threads.
+				size_t size( ) const
+				{ return m_threads.size(); }
+
+				/// Queues job to run on a worker.
+				void submit( task job )
+				{
+					if( m_threads.empty() )
+					{
+						job();
+						return;
+					}
+
+					size_t target = current().pool == this ? current().index : m_next++ % m_queues.size();
+					{
+						std::lock_guard<std::mutex> guard( m_queues[target]->lock );
+						m_queues[target]->tasks.push_back( std::move( job ) );
+					}
+					{
+						std::lock_guard<std::mutex> guard( m_lock );
+						m_queued++;
+					}
+					m_wake.notify_one();
+				}
+
+				/// Runs one queued task on the calling thread, if there is any. Returns whether it ran one.
+				bool run_one( )
+				{
+					task job;
+					bool own = current().pool == this;
+					size_t start = own ? current().index : m_next.load( std::memory_order_relaxed );
+
+					if( not ( ( own and take_back( start, job ) ) or steal( start, job ) ) )
+						return false;
+
+					job();
+					return true;
+				}
+
+			protected:
+				/// Queue of a worker.
+				struct queue
+				{
+					std::mutex lock;
+					std::deque<task> tasks;
+				};
+
+				/// The pool and index of the worker running on this thread, if any.
+				struct worker_id
+				{
+					const thread_pool * pool;
+					size_t index;
+				};
+
+				static worker_id & current( )
+				{
+					static thread_local worker_id id{ nullptr, 0 };
+					return id;
+				}
+
+				/// Takes the newest task of queue index.
+				bool take_back( size_t index, task & job )
+				{
+					queue & q = *m_queues[index];
+					std::lock_guard<std::mutex> guard( q.lock );
+					if( q.tasks.empty() )
+						return false;
+
+					job = std::move( q.tasks.back() );
+					q.tasks.pop_back();
+					m_queued--;
+					return true;
+				}
+
+				/// Takes the oldest task of the first queue that has one, from start + 1 on.
+				bool steal( size_t start, task & job )
+				{
+					size_t count = m_queues.size();
+					for( size_t i{1u} ; i <= count ; ++i )
+					{
+						queue & q = *m_queues[( start + i ) % count];
+						std::lock_guard<std::mutex> guard( q.lock );
+						if( q.tasks.empty() )
+							continue;
+
+						job = std::move( q.tasks.front() );
+						q.tasks.pop_front();
+						m_queued--;
+						return true;
+					}
+					return false;
+				}
+
+				/// Loop of worker index: runs tasks, sleeps while every queue is empty.
+				void work( size_t index )
+				{
+					current() = worker_id{ this, index };
+
+					for( ; ; )
+					{
+						if( run_one() )
+							continue;
+
+						std::unique_lock<std::mutex> guard( m_lock );
+						m_wake.wait( guard, [this]{ return m_stop or m_queued > 0; } );
+						if( m_stop )
+							return;
+					}
+				}
+
+			protected:
+				std::vector< std::unique_ptr<queue> > m_queues; //!< One queue per worker.
+				std::vector< std::thread > m_threads; //!< Workers.
+				std::mutex m_lock; //!< Guards the sleep of the workers.
+				std::condition_variable m_wake; //!< Wakes a worker when a task is queued.
+				std::atomic<long> m_queued; //!< Tasks in the queues. May dip below zero while a task is being queued.
+				std::atomic<size_t> m_next; //!< Next queue of the tasks from other threads.
+				bool m_stop; //!< Set when the pool is destroyed.
+		}; // class thread_pool
+
+		/// Settings of the default pool.
+		struct default_settings
+		{
+			size_t threads; //!< Workers of the default pool.
+			bool built; //!< Whether the default pool runs already.
+		};
+
+		inline default_settings & defaults( )
+		{
+			static default_settings settings{ hardware_threads(), false };
+			return settings;
+		}
+
+		/// Pool used when an algorithm is given none. Built on first use, with one worker per
+		/// hardware thread unless set_default_threads() said otherwise.
+		inline thread_pool & default_pool( )
+		{
+			static thread_pool pool( ( defaults().built = true, defaults().threads ) );
+			return pool;
+		}
+
+		/// Sets the number of workers of the default pool. Throws std::logic_error once the pool runs.
+		inline void set_default_threads( size_t threads )
+		{
+			if( defaults().built )
+				throw std::logic_error( "error in set_default_threads(): the default pool runs already" );
+			defaults().threads = threads;
+		}
+
+		/*! \struct execution
+			\brief where and from which size an algorithm runs in parallel.
+		*/
+		struct execution
+		{
+			thread_pool * pool; //!< Pool of the chunks, default_pool() if nullptr.
+			size_t threshold; //!< Fewest elements to run in parallel.
+
+			explicit execution( thread_pool * pool = nullptr, size_t threshold = default_threshold )
+				: pool{pool}, threshold{threshold}
+			{/*empty*/}
+
+			/// Returns the pool to use.
+			thread_pool & get_pool( ) const
+			{ return pool != nullptr ? *pool : default_pool(); }
+		};
+
+		/// Result of one chunk, padded so that results of adjacent chunks never share a cache line
+		/// (nor a word, as the flags of a std::vector<bool> would).
+		template< typename R >
+		struct chunk_result
+		{
+			R value;
+			char padding[cache_line];
+
+			explicit chunk_result( const R & value )
+				: value( value )
+			{/*empty*/}
+		};
+
+		/// Splits the n elements at data into about parts chunks of at least min_chunk elements.
+		/// Returns the bounds: chunk i is [bounds[i], bounds[i+1]). Every inner bound is on a cache
+		/// line boundary when a whole number of T fits in a line.
+		template< typename T >
+		std::vector<size_t> chunk_bounds( const T * data, size_t n, size_t parts )
+		{
+			size_t address = reinterpret_cast<std::uintptr_t>( data ) % cache_line;
+			size_t head_bytes = ( cache_line - address ) % cache_line;
+			bool aligned = cache_line % sizeof(T) == 0 and head_bytes % sizeof(T) == 0;
+			size_t per_line = aligned ? cache_line / sizeof(T) : 1;
+			size_t head = aligned ? head_bytes / sizeof(T) : 0;
+
+			size_t chunk = parts != 0 ? ( n + parts - 1 ) / parts : n;
+			chunk = chunk < min_chunk ? min_chunk : chunk;
+			chunk = ( chunk + per_line - 1 ) / per_line * per_line;
+
+			std::vector<size_t> bounds{ 0 };
+			for( size_t bound{head + chunk} ; bound < n ; bound += chunk )
+				bounds.push_back( bound );
+			bounds.push_back( n );
+
+			return bounds;
+		}
+
+		/// Returns the chunk bounds of the n elements at data under exec: a single chunk below the
+		/// threshold or without threads, none if n is 0.
+		template< typename T >
+		std::vector<size_t> plan( const T * data, size_t n, const execution & exec )
+		{
+			if( n == 0 )
+				return std::vector<size_t>{ 0 };
+
+			thread_pool & pool = exec.get_pool();
+			if( n < exec.threshold or pool.size() == 0 )
+				return std::vector<size_t>{ 0, n };
+
+			return chunk_bounds( data, n, ( pool.size() + 1 ) * chunks_per_thread );
+		}
+
+		/// Runs body( first, last, chunk ) for every chunk of bounds (see plan) on the pool of exec,
+		/// and waits for all of them. A single chunk runs on the calling thread.
+		template< typename Body >
+		void run_chunks( const std::vector<size_t> & bounds, const execution & exec, Body body )
+		{
+			size_t chunks = bounds.size() - 1;
+			if( chunks == 0 )
+				return;
+			if( chunks == 1 )
+			{
+				body( bounds[0], bounds[1], 0 );
+				return;
+			}
+
+			// Shared with the tasks, which may still hold it after the caller returned.
+			struct state
+			{
+				std::atomic<size_t> remaining;
+				std::mutex lock;
+				std::condition_variable done;
+				std::exception_ptr error;
+			};
+			std::shared_ptr<state> shared( new state );
+			shared->remaining = chunks;
+
+			auto run = [shared, &bounds, &body]( size_t i ) {
+				try { body( bounds[i], bounds[i+1], i ); }
+				catch( ... ) {
+					std::lock_guard<std::mutex> guard( shared->lock );
+					if( not shared->error )
+						shared->error = std::current_exception();
+				}
+				std::lock_guard<std::mutex> guard( shared->lock );
+				if( --shared->remaining == 0 )
+					shared->done.notify_all();
+			};
+
+			thread_pool & pool = exec.get_pool();
+			for( size_t i{1u} ; i < chunks ; ++i )
+				pool.submit( std::bind( run, i ) );
+			run( 0 );
+
+			// Help with the queued chunks, then wait for those running elsewhere.
+			while( shared->remaining != 0 and pool.run_one() )
+			{/*empty*/}
+			std::unique_lock<std::mutex> guard( shared->lock );
+			shared->done.wait( guard, [&shared]{ return shared->remaining == 0; } );
+
+			if( shared->error )
+				std::rethrow_exception( shared->error );
+		}
+
+		/// Returns the address of the first element of vec, or nullptr.
+		template< typename V >
+		auto data_of( V & vec ) -> decltype( &*vec.begin() )
+		{ return vec.size() != 0 ? &*vec.begin() : nullptr; }
+
+		/// The flags of an sc::vector<bool> have no address: chunks of them would share words.
+		template< typename A, typename G >
+		bool * data_of( const vector<bool, A, G> & )
+		{
+			static_assert( sizeof(A) == 0, "sc::vector<bool> packs its flags into words: the parallel algorithms need addressable elements" );
+			return nullptr;
+		}
+
+		/// Copies a chunk of trivially copyable elements with a single memcpy.
+		template< typename T >
+		void copy_chunk( const T * source, size_t n, T * dest, std::true_type )
+		{ std::memcpy( static_cast<void*>( dest ), source, n * sizeof(T) ); }
+
+		template< typename T >
+		void copy_chunk( const T * source, size_t n, T * dest, std::false_type )
+		{
+			for( size_t i{0u} ; i < n ; ++i )
+				dest[i] = source[i];
+		}
+
+		//=== Algorithms
+		/// Calls f( element ) for every element of vec.
+		template< typename T, typename A, typename G, typename F >
+		void for_each( vector<T, A, G> & vec, F f, const execution & exec = execution() )
+		{
+			T * data = data_of( vec );
+			run_chunks( plan( data, vec.size(), exec ), exec, [data, &f]( size_t first, size_t last, size_t ) {
+				for( size_t i{first} ; i < last ; ++i )
+					f( data[i] );
+			} );
+		}
+
+		/// Replaces every element of vec by f( element ).
+		template< typename T, typename A, typename G, typename F >
+		void transform( vector<T, A, G> & vec, F f, const execution & exec = execution() )
+		{
+			T * data = data_of( vec );
+			run_chunks( plan( data, vec.size(), exec ), exec, [data, &f]( size_t first, size_t last, size_t ) {
+				for( size_t i{first} ; i < last ; ++i )
+					data[i] = f( data[i] );
+			} );
+		}
+
+		/// Makes out hold f( element ) for every element of in. out is resized to the size of in.
+		template< typename T, typename A, typename G, typename U, typename B, typename H, typename F >
+		void transform( const vector<T, A, G> & in, vector<U, B, H> & out, F f, const execution & exec = execution() )
+		{
+			out.resize( in.size() );
+			const T * source = data_of( in );
+			U * dest = data_of( out );
+			run_chunks( plan( dest, out.size(), exec ), exec, [source, dest, &f]( size_t first, size_t last, size_t ) {
+				for( size_t i{first} ; i < last ; ++i )
+					dest[i] = f( source[i] );
+			} );
+		}
+
+		/// Returns init combined with every element of vec by op, which must be associative:
+		/// the chunks are reduced apart, then their results in order.
+		template< typename T, typename A, typename G, typename R, typename Op >
+		R reduce( const vector<T, A, G> & vec, R init, Op op, const execution & exec = execution() )
+		{
+			const T * data = data_of( vec );
+			std::vector<size_t> bounds = plan( data, vec.size(), exec );
+			std::vector< chunk_result<R> > partial( bounds.size() - 1, chunk_result<R>( init ) );
+
+			run_chunks( bounds, exec, [data, &partial, &op]( size_t first, size_t last, size_t chunk ) {
+				R result = data[first];
+				for( size_t i{first + 1} ; i < last ; ++i )
+					result = op( result, data[i] );
+				partial[chunk].value = result;
+			} );
+
+			for( const auto & result : partial )
+				init = op( init, result.value );
+			return init;
+		}
+
+		/// Returns the sum of init and every element of vec.
+		template< typename T, typename A, typename G, typename R >
+		R reduce( const vector<T, A, G> & vec, R init, const execution & exec = execution() )
+		{ return reduce( vec, init, std::plus<R>(), exec ); }
+
+		/// Assigns value to every element of vec.
+		template< typename T, typename A, typename G >
+		void fill( vector<T, A, G> & vec, const T & value, const execution & exec = execution() )
+		{
+			T * data = data_of( vec );
+			run_chunks( plan( data, vec.size(), exec ), exec, [data, &value]( size_t first, size_t last, size_t ) {
+				for( size_t i{first} ; i < last ; ++i )
+					data[i] = value;
+			} );
+		}
+
+		/// Makes out a copy of in. out is resized to the size of in.
+		template< typename T, typename A, typename G, typename B, typename H >
+		void copy( const vector<T, A, G> & in, vector<T, B, H> & out, const execution & exec = execution() )
+		{
+			out.resize( in.size() );
+			const T * source = data_of( in );
+			T * dest = data_of( out );
+			run_chunks( plan( dest, out.size(), exec ), exec, [source, dest]( size_t first, size_t last, size_t ) {
+				copy_chunk( source + first, last - first, dest + first, std::is_trivially_copyable<T>() );
+			} );
+		}
+
+	} // namespace parallel
+
+} // namespace sc
+
+#endif
@@ -0,0 +1,1027 @@
+#ifndef PERSISTENT_VECTOR_H
+#define PERSISTENT_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \class persistent_vector
+		\brief immutable list whose versions share most of their storage (a relaxed radix balanced tree).
+
+		The elements are in leaves of 32, under nodes of 32 children. push_back(), set(), concat()
+		and slice() leave the list unchanged and return a new version that copies only the nodes on
+		the paths they touch, O(log32 n) of them, and shares all the others with the old version.
+		Keeping every version costs memory only for what differs between them.
+
+		Trees built by push_back() alone are balanced and indexed by radix: each level picks a child
+		with a shift of the index. concat() and slice() may leave nodes that are not full; those
+		nodes keep a table of the sizes of their children (they are relaxed) and index through it,
+		and concat() redistributes the nodes along the seam so that a search takes at most a couple
+		of extra steps per level.
+
+		transient() gives a transient_vector: a version that may be changed in place. It copies a
+		node the first time it changes it and then changes its copy in place, so building a list
+		by many push_back() calls on it costs little more than on a sc::vector. persistent() turns
+		it back into a persistent_vector in O(1).
+
+		The nodes are reference counted with atomic counters and never change once they belong to
+		a persistent version: versions may be read and derived from different threads at once.
+	*/
+	template< typename T >
+	class persistent_vector{
+
+		public:
+			//=== Alias
+			typedef size_t size_type; //!< Type of size.
+			typedef T value_type; //!< Type of the elements.
+			class const_iterator;
+			class transient_vector;
+
+			static constexpr size_type branching = 32; //!< Elements of a leaf, children of a node.
+
+		protected:
+			static constexpr unsigned bits = 5; //!< log2( branching ).
+			static constexpr size_type max_extra_steps = 2; //!< Nodes a level may have above the fewest possible, after concat().
+
+			/// Leaf or inner node. owner is the transient that may change it in place, 0 if none.
+			struct node
+			{
+				std::atomic<size_t> refs;
+				uint64_t owner;
+				unsigned count; //!< Elements of a leaf, children of an inner node.
+				bool is_leaf;
+
+				node( bool leaf, uint64_t owner )
+					: refs{1}, owner{owner}, count{0}, is_leaf{leaf}
+				{/*empty*/}
+			};
+
+			struct leaf : node
+			{
+				typename std::aligned_storage< sizeof(T), alignof(T) >::type storage[branching];
+
+				explicit leaf( uint64_t owner )
+					: node( true, owner )
+				{/*empty*/}
+
+				~leaf( )
+				{
+					for( unsigned i{0u} ; i < this->count ; ++i )
+						items()[i].~T();
+				}
+
+				T * items( )
+				{ return reinterpret_cast<T*>( storage ); }
+
+				/// Appends a copy of value.
+				void append( const T & value )
+				{
+					::new( static_cast<void*>( items() + this->count ) ) T( value );
+					++this->count;
+				}
+			};
+
+			struct inner : node
+			{
+				node * children[branching];
+				size_type sizes[branching]; //!< sizes[i]: elements of children 0 to i.
+				bool relaxed; //!< Whether a child but the last is not full, so radix indexing is wrong.
+
+				explicit inner( uint64_t owner )
+					: node( false, owner ), relaxed{false}
+				{/*empty*/}
+			};
+
+		public:
+			//=== Constructors
+			/// Empty list.
+			persistent_vector( )
+				: m_root{nullptr}, m_size{0}, m_height{0}
+			{/*empty*/}
+
+			/// List of the elements in [first, last).
+			template< typename InputIt >
+			persistent_vector( InputIt first, InputIt last )
+				: persistent_vector()
+			{
+				transient_vector builder( *this );
+				for( ; first != last ; ++first )
+					builder.push_back( *first );
+				*this = builder.persistent();
+			}
+
+			/// List of the elements of ilist.
+			persistent_vector( std::initializer_list<T> ilist )
+				: persistent_vector( ilist.begin(), ilist.end() )
+			{/*empty*/}
+
+			/// Copy constructor. Shares the whole tree.
+			persistent_vector( const persistent_vector & other ) noexcept
+				: m_root{retain( other.m_root )}, m_size{other.m_size}, m_height{other.m_height}
+			{/*empty*/}
+
+			/// Move constructor.
+			persistent_vector( persistent_vector && other ) noexcept
+				: m_root{other.m_root}, m_size{other.m_size}, m_height{other.m_height}
+			{
+				other.m_root = nullptr;
+				other.m_size = other.m_height = 0;
+			}
+
+			/// Destructor. Frees the nodes no other version holds.
+			~persistent_vector( )
+			{ release( m_root ); }
+
+			/// Copy and move assignment.
+			persistent_vector & operator=( persistent_vector other ) noexcept
+			{
+				std::swap( m_root, other.m_root );
+				std::swap( m_size, other.m_size );
+				std::swap( m_height, other.m_height );
+				return *this;
+			}
+
+		public:
+			//=== Reading
+			/// Returns the number of elements.
+			size_type size( ) const
+			{ return m_size; }
+
+			/// Checks whether the list has no element.
+			bool empty( ) const
+			{ return m_size == 0; }
+
+			/// Returns the element at index pos.
+			const T & operator[]( size_type pos ) const
+			{ return lookup( m_root, m_height, pos ); }
+
+			/// Returns the element at index pos. Throws std::out_of_range if pos is not below size().
+			const T & at( size_type pos ) const
+			{
+				if( pos >= m_size )
+					throw std::out_of_range("error in at(): out of range");
+				return (*this)[pos];
+			}
+
+			/// Return the first element.
+			const T & front( ) const
+			{ return (*this)[0]; }
+
+			/// Return the last element.
+			const T & back( ) const
+			{ return (*this)[m_size - 1]; }
+
+			const_iterator begin( ) const
+			{ return const_iterator( this, 0 ); }
+
+			const_iterator end( ) const
+			{ return const_iterator( this, m_size ); }
+
+			const_iterator cbegin( ) const
+			{ return begin(); }
+
+			const_iterator cend( ) const
+			{ return end(); }
+
+		public:
+			//=== New versions
+			/// Returns this list with value appended.
+			persistent_vector push_back( const T & value ) const
+			{
+				persistent_vector result( *this );
+				result.append( value, 0 );
+				return result;
+			}
+
+			/// Returns this list with the element at pos replaced by value.
+			persistent_vector set( size_type pos, const T & value ) const
+			{
+				if( pos >= m_size )
+					throw std::out_of_range("error in set(): out of range");
+				return persistent_vector( assoc( m_root, m_height, pos, value, 0 ), m_size, m_height );
+			}
+
+			/// Returns this list without its last element.
+			persistent_vector pop_back( ) const
+			{ return slice( 0, m_size - 1 ); }
+
+			/// Returns the elements of this list followed by those of rhs.
+			persistent_vector concat( const persistent_vector & rhs ) const
+			{
+				if( rhs.empty() )
+					return *this;
+				if( empty() )
+					return rhs;
+
+				node * root = concat_trees( m_root, m_height, rhs.m_root, rhs.m_height, true );
+				persistent_vector result( root, m_size + rhs.m_size, ( m_height > rhs.m_height ? m_height : rhs.m_height ) + 1 );
+				result.shorten();
+				return result;
+			}
+
+			/// Returns the elements in [first, last).
+			persistent_vector slice( size_type first, size_type last ) const
+			{
+				if( first > last or last > m_size )
+					throw std::out_of_range("error in slice(): out of range");
+				if( first == last )
+					return persistent_vector();
+
+				node * taken = take( m_root, m_height, last );
+				node * dropped;
+				try { dropped = drop( taken, m_height, first ); }
+				catch( ... ) { release( taken ); throw; }
+				release( taken );
+
+				persistent_vector result( dropped, last - first, m_height );
+				result.shorten();
+				return result;
+			}
+
+			/// Returns a version of this list that may be changed in place.
+			transient_vector transient( ) const
+			{ return transient_vector( *this ); }
+
+		protected:
+			/// List of size elements under root, of height height. Takes the reference to root.
+			persistent_vector( node * root, size_type size, unsigned height )
+				: m_root{root}, m_size{size}, m_height{height}
+			{/*empty*/}
+
+			/// Appends value, changing in place the nodes of owner.
+			void append( const T & value, uint64_t owner )
+			{
+				if( m_root == nullptr )
+				{
+					m_root = new_path( 0, value, owner );
+					m_size = 1;
+					return;
+				}
+
+				if( owner != 0 and append_in_place( value, owner ) )
+				{
+					++m_size;
+					return;
+				}
+
+				node * grown = push( m_root, m_height, value, owner );
+				if( grown == nullptr )
+				{
+					// The tree is full: a new root over the old one and a new path.
+					inner * root = new inner( owner );
+					try { root->children[1] = new_path( m_height, value, owner ); }
+					catch( ... ) { delete root; throw; }
+					root->children[0] = m_root;
+					root->count = 2;
+					seal( root, m_height + 1 );
+					m_root = root;
+					++m_height;
+				}
+				else
+				{
+					release( m_root );
+					m_root = grown;
+				}
+				++m_size;
+			}
+
+			/// Appends value to the last leaf if owner owns it, its path, and it has room. Leaves the
+			/// reference counts alone, unlike push().
+			bool append_in_place( const T & value, uint64_t owner )
+			{
+				inner * path[16];
+				node * n = m_root;
+				for( unsigned h{m_height} ; h > 0 ; --h )
+				{
+					if( n->owner != owner )
+						return false;
+					path[h - 1] = static_cast<inner*>( n );
+					n = path[h - 1]->children[n->count - 1];
+				}
+				if( n->owner != owner or n->count == branching )
+					return false;
+
+				static_cast<leaf*>( n )->append( value );
+				for( unsigned h{0u} ; h < m_height ; ++h )
+					path[h]->sizes[path[h]->count - 1] += 1;
+				return true;
+			}
+
+			/// Removes the roots that have a single child.
+			void shorten( )
+			{
+				while( m_height > 0 and m_root->count == 1 )
+				{
+					node * child = retain( static_cast<inner*>( m_root )->children[0] );
+					release( m_root );
+					m_root = child;
+					--m_height;
+				}
+			}
+
+			//=== Nodes
+			static node * retain( node * n )
+			{
+				if( n != nullptr )
+					n->refs.fetch_add( 1, std::memory_order_relaxed );
+				return n;
+			}
+
+			/// Drops a reference to n, freeing it and releasing its children with the last one.
+			static void release( node * n )
+			{
+				if( n == nullptr or n->refs.fetch_sub( 1, std::memory_order_acq_rel ) != 1 )
+					return;
+
+				if( n->is_leaf )
+					delete static_cast<leaf*>( n );
+				else
+				{
+					inner * in = static_cast<inner*>( n );
+					for( unsigned i{0u} ; i < in->count ; ++i )
+						release( in->children[i] );
+					delete in;
+				}
+			}
+
+			/// Returns the number of elements under n.
+			static size_type size_of( const node * n )
+			{ return n->is_leaf ? n->count : static_cast<const inner*>( n )->sizes[n->count - 1]; }
+
+			/// Returns the most elements a tree of height height holds.
+			static size_type full_size( unsigned height )
+			{
+				unsigned shift = bits * ( height + 1 );
+				return shift < 64 ? size_type(1) << shift : ~size_type(0);
+			}
+
+			/// Computes the sizes of the children of n, of height height, and whether it is relaxed.
+			static void seal( inner * n, unsigned height )
+			{
+				size_type total{0u};
+				n->relaxed = false;
+				for( unsigned i{0u} ; i < n->count ; ++i )
+				{
+					size_type child = size_of( n->children[i] );
+					if( i + 1 < n->count and child != full_size( height - 1 ) )
+						n->relaxed = true;
+					total += child;
+					n->sizes[i] = total;
+				}
+			}
+
+			/// Returns a copy of leaf l, of owner owner.
+			static leaf * clone( leaf * l, uint64_t owner )
+			{
+				leaf * copy = new leaf( owner );
+				try
+				{
+					for( unsigned i{0u} ; i < l->count ; ++i )
+						copy->append( l->items()[i] );
+				}
+				catch( ... ) { delete copy; throw; }
+				return copy;
+			}
+
+			/// Returns a copy of inner node n, of owner owner, sharing its children.
+			static inner * clone( inner * n, uint64_t owner )
+			{
+				inner * copy = new inner( owner );
+				for( unsigned i{0u} ; i < n->count ; ++i )
+				{
+					copy->children[i] = retain( n->children[i] );
+					copy->sizes[i] = n->sizes[i];
+				}
+				copy->count = n->count;
+				copy->relaxed = n->relaxed;
+				return copy;
+			}
+
+			/// Returns a new reference to a version of n that may be changed: n itself if owner owns it,
+			/// otherwise a copy owned by owner.
+			template< typename Node >
+			static Node * editable( Node * n, uint64_t owner )
+			{
+				if( owner != 0 and n->owner == owner )
+					return static_cast<Node*>( retain( n ) );
+				return clone( n, owner );
+			}
+
+			/// Returns a tree of height height holding value alone.
+			static node * new_path( unsigned height, const T & value, uint64_t owner )
+			{
+				leaf * l = new leaf( owner );
+				try { l->append( value ); }
+				catch( ... ) { delete l; throw; }
+
+				node * path = l;
+				for( unsigned h{1u} ; h <= height ; ++h )
+				{
+					inner * parent = new( std::nothrow ) inner( owner );
+					if( parent == nullptr )
+					{
+						release( path );
+						throw std::bad_alloc();
+					}
+					parent->children[0] = path;
+					parent->count = 1;
+					parent->sizes[0] = 1;
+					path = parent;
+				}
+				return path;
+			}
+
+			/// Picks the child of n, of height height, that holds index pos, and makes pos relative to it.
+			static unsigned locate( const inner * n, unsigned height, size_type & pos )
+			{
+				unsigned shift = bits * height;
+				unsigned child = (unsigned)( pos >> shift );
+				if( not n->relaxed )
+				{
+					pos -= (size_type) child << shift;
+					return child;
+				}
+
+				// A child holds at most 2^shift elements: the radix guess is never past the right one.
+				while( n->sizes[child] <= pos )
+					++child;
+				if( child != 0 )
+					pos -= n->sizes[child - 1];
+				return child;
+			}
+
+			/// Returns the leaf holding index pos of the tree n, and makes pos relative to it.
+			static leaf * leaf_at( node * n, unsigned height, size_type & pos )
+			{
+				for( ; height > 0 ; --height )
+				{
+					inner * in = static_cast<inner*>( n );
+					n = in->children[ locate( in, height, pos ) ];
+				}
+				return static_cast<leaf*>( n );
+			}
+
+			static const T & lookup( node * n, unsigned height, size_type pos )
+			{
+				leaf * l = leaf_at( n, height, pos );
+				return l->items()[pos];
+			}
+
+			/// Returns a new reference to n with value appended, or nullptr if n is full.
+			static node * push( node * n, unsigned height, const T & value, uint64_t owner )
+			{
+				if( height == 0 )
+				{
+					if( n->count == branching )
+						return nullptr;
+					leaf * l = editable( static_cast<leaf*>( n ), owner );
+					try { l->append( value ); }
+					catch( ... ) { release( l ); throw; }
+					return l;
+				}
+
+				inner * in = static_cast<inner*>( n );
+				unsigned last = in->count - 1;
+				node * child = push( in->children[last], height - 1, value, owner );
+				bool grew = child != nullptr;
+				if( not grew and in->count == branching )
+					return nullptr;
+
+				inner * copy;
+				try
+				{
+					if( not grew )
+						child = new_path( height - 1, value, owner );
+					copy = editable( in, owner );
+				}
+				catch( ... ) { release( child ); throw; }
+
+				if( grew )
+				{
+					// child may be the last child itself, changed in place: its count is then back to one.
+					release( copy->children[last] );
+					copy->children[last] = child;
+					copy->sizes[last] += 1;
+				}
+				else
+				{
+					// The last child is full, or cannot grow: a new last child.
+					if( size_of( copy->children[last] ) != full_size( height - 1 ) )
+						copy->relaxed = true;
+					copy->children[copy->count] = child;
+					copy->sizes[copy->count] = copy->sizes[last] + 1;
+					++copy->count;
+				}
+				return copy;
+			}
+
+			/// Returns a new reference to n with the element at pos replaced by value.
+			static node * assoc( node * n, unsigned height, size_type pos, const T & value, uint64_t owner )
+			{
+				if( height == 0 )
+				{
+					leaf * l = editable( static_cast<leaf*>( n ), owner );
+					try { l->items()[pos] = value; }
+					catch( ... ) { release( l ); throw; }
+					return l;
+				}
+
+				inner * in = static_cast<inner*>( n );
+				unsigned index = locate( in, height, pos );
+				node * child = assoc( in->children[index], height - 1, pos, value, owner );
+
+				inner * copy;
+				try { copy = editable( in, owner ); }
+				catch( ... ) { release( child ); throw; }
+				release( copy->children[index] );
+				copy->children[index] = child;
+				return copy;
+			}
+
+			/// Returns a new reference to the tree of the first count elements of n.
+			static node * take( node * n, unsigned height, size_type count )
+			{
+				if( count == size_of( n ) )
+					return retain( n );
+
+				if( height == 0 )
+				{
+					leaf * l = new leaf( 0 );
+					try
+					{
+						for( unsigned i{0u} ; i < count ; ++i )
+							l->append( static_cast<leaf*>( n )->items()[i] );
+					}
+					catch( ... ) { delete l; throw; }
+					return l;
+				}
+
+				inner * in = static_cast<inner*>( n );
+				size_type pos = count - 1;
+				unsigned index = locate( in, height, pos );
+				node * child = take( in->children[index], height - 1, pos + 1 );
+
+				inner * copy = new( std::nothrow ) inner( 0 );
+				if( copy == nullptr )
+				{
+					release( child );
+					throw std::bad_alloc();
+				}
+				for( unsigned i{0u} ; i < index ; ++i )
+					copy->children[i] = retain( in->children[i] );
+				copy->children[index] = child;
+				copy->count = index + 1;
+				seal( copy, height );
+				return copy;
+			}
+
+			/// Returns a new reference to the tree of the elements of n from index count on.
+			static node * drop( node * n, unsigned height, size_type count )
+			{
+				if( count == 0 )
+					return retain( n );
+
+				if( height == 0 )
+				{
+					leaf * l = new leaf( 0 );
+					try
+					{
+						for( unsigned i = (unsigned) count ; i < n->count ; ++i )
+							l->append( static_cast<leaf*>( n )->items()[i] );
+					}
+					catch( ... ) { delete l; throw; }
+					return l;
+				}
+
+				inner * in = static_cast<inner*>( n );
+				size_type pos = count;
+				unsigned index = locate( in, height, pos );
+				node * child = drop( in->children[index], height - 1, pos );
+
+				inner * copy = new( std::nothrow ) inner( 0 );
+				if( copy == nullptr )
+				{
+					release( child );
+					throw std::bad_alloc();
+				}
+				copy->children[0] = child;
+				for( unsigned i{index + 1} ; i < in->count ; ++i )
+					copy->children[i - index] = retain( in->children[i] );
+				copy->count = in->count - index;
+				seal( copy, height );
+				return copy;
+			}
+
+			//=== Concatenation
+			/// Concatenates the trees left and right, of heights hl and hr. Returns a new reference to a
+			/// node of height max( hl, hr ) + 1 with one or two children.
+			static node * concat_trees( node * left, unsigned hl, node * right, unsigned hr, bool top )
+			{
+				if( hl > hr )
+				{
+					inner * l = static_cast<inner*>( left );
+					node * middle = concat_trees( l->children[l->count - 1], hl - 1, right, hr, false );
+					return rebalance( l, middle, nullptr, hl );
+				}
+				if( hl < hr )
+				{
+					inner * r = static_cast<inner*>( right );
+					node * middle = concat_trees( left, hl, r->children[0], hr - 1, false );
+					return rebalance( nullptr, middle, r, hr );
+				}
+				if( hl == 0 )
+				{
+					if( top and left->count + right->count <= branching )
+					{
+						// Both fit in one leaf.
+						leaf * merged = clone( static_cast<leaf*>( left ), 0 );
+						try
+						{
+							for( unsigned i{0u} ; i < right->count ; ++i )
+								merged->append( static_cast<leaf*>( right )->items()[i] );
+						}
+						catch( ... ) { delete merged; throw; }
+
+						inner * parent = new( std::nothrow ) inner( 0 );
+						if( parent == nullptr )
+						{
+							delete merged;
+							throw std::bad_alloc();
+						}
+						parent->children[0] = merged;
+						parent->count = 1;
+						seal( parent, 1 );
+						return parent;
+					}
+
+					// The leaves are merged, if at all, by the rebalance of the level above.
+					inner * parent = new inner( 0 );
+					parent->children[0] = retain( left );
+					parent->children[1] = retain( right );
+					parent->count = 2;
+					seal( parent, 1 );
+					return parent;
+				}
+
+				inner * l = static_cast<inner*>( left );
+				inner * r = static_cast<inner*>( right );
+				node * middle = concat_trees( l->children[l->count - 1], hl - 1, r->children[0], hr - 1, false );
+				return rebalance( l, middle, r, hl );
+			}
+
+			/// Merges the children of left but its last, of middle, and of right but its first, all of
+			/// height height - 1, into as few nodes as the extra steps allow. Returns a new reference
+			/// to a node of height height + 1 over one or two nodes of height height. Takes the
+			/// reference to middle.
+			static node * rebalance( inner * left, node * middle, inner * right, unsigned height )
+			{
+				inner * mid = static_cast<inner*>( middle );
+				std::vector<node*> all;
+				std::vector<node*> built;
+				try
+				{
+					if( left != nullptr )
+						all.insert( all.end(), left->children, left->children + left->count - 1 );
+					all.insert( all.end(), mid->children, mid->children + mid->count );
+					if( right != nullptr )
+						all.insert( all.end(), right->children + 1, right->children + right->count );
+
+					std::vector<size_type> plan = redistribution( all );
+					built = build( all, plan, height - 1 );
+
+					// At most 31 + 2 + 31 nodes: one or two nodes of height height hold them.
+					bool two = built.size() > branching;
+					inner * parent = new( std::nothrow ) inner( 0 );
+					inner * a = new( std::nothrow ) inner( 0 );
+					inner * b = two ? new( std::nothrow ) inner( 0 ) : nullptr;
+					if( parent == nullptr or a == nullptr or ( two and b == nullptr ) )
+					{
+						delete parent;
+						delete a;
+						delete b;
+						throw std::bad_alloc();
+					}
+
+					for( size_type i{0u} ; i < built.size() ; ++i )
+					{
+						inner * to = i < branching ? a : b;
+						to->children[to->count++] = built[i];
+					}
+					seal( a, height );
+					parent->children[parent->count++] = a;
+					if( two )
+					{
+						seal( b, height );
+						parent->children[parent->count++] = b;
+					}
+					seal( parent, height + 1 );
+					release( middle );
+					return parent;
+				}
+				catch( ... )
+				{
+					for( node * n : built )
+						release( n );
+					release( middle );
+					throw;
+				}
+			}
+
+			/// Returns the slot counts of the nodes that all is merged into: nodes are emptied into
+			/// the following ones until there are at most max_extra_steps more than the fewest possible.
+			static std::vector<size_type> redistribution( const std::vector<node*> & all )
+			{
+				std::vector<size_type> slots;
+				size_type total{0u};
+				for( node * n : all )
+				{
+					slots.push_back( n->count );
+					total += n->count;
+				}
+
+				size_type fewest = ( total + branching - 1 ) / branching;
+				size_type n = slots.size();
+				size_type i{0u};
+				while( n > fewest + max_extra_steps )
+				{
+					while( i + 1 < n and slots[i] >= branching - max_extra_steps / 2 )
+						++i;
+					if( i + 1 >= n )
+						break;
+
+					size_type remaining = slots[i];
+					while( remaining > 0 and i + 1 < n )
+					{
+						size_type filled = remaining + slots[i + 1] < branching ? remaining + slots[i + 1] : branching;
+						remaining = remaining + slots[i + 1] - filled;
+						slots[i] = filled;
+						++i;
+					}
+					for( size_type j{i} ; j + 1 < n ; ++j )
+						slots[j] = slots[j + 1];
+					--n;
+					i = i > 0 ? i - 1 : 0;
+				}
+				slots.resize( n );
+				return slots;
+			}
+
+			/// Returns new references to nodes of height height holding, in order, the slots of all,
+			/// plan[k] in the k-th. A node of all whose slots make a planned node as they are is reused.
+			static std::vector<node*> build( const std::vector<node*> & all, const std::vector<size_type> & plan, unsigned height )
+			{
+				std::vector<node*> result;
+				result.reserve( plan.size() );
+				size_type source{0u}, offset{0u};
+				try
+				{
+					for( size_type count : plan )
+					{
+						if( offset == 0 and all[source]->count == count )
+						{
+							result.push_back( retain( all[source++] ) );
+							continue;
+						}
+
+						if( height == 0 )
+						{
+							leaf * l = new leaf( 0 );
+							result.push_back( l );
+							while( l->count < count )
+							{
+								leaf * from = static_cast<leaf*>( all[source] );
+								l->append( from->items()[offset] );
+								if( ++offset == from->count )
+									offset = 0, ++source;
+							}
+						}
+						else
+						{
+							inner * in = new inner( 0 );
+							result.push_back( in );
+							while( in->count < count )
+							{
+								inner * from = static_cast<inner*>( all[source] );
+								in->children[in->count++] = retain( from->children[offset] );
+								if( ++offset == from->count )
+									offset = 0, ++source;
+							}
+							seal( in, height );
+						}
+					}
+				}
+				catch( ... )
+				{
+					for( node * n : result )
+						release( n );
+					throw;
+				}
+				return result;
+			}
+
+			/// Returns an id that no transient used before.
+			static uint64_t new_owner( )
+			{
+				static std::atomic<uint64_t> last{0};
+				return ++last;
+			}
+
+		protected:
+			node * m_root; //!< Root, nullptr when empty.
+			size_type m_size; //!< Number of elements.
+			unsigned m_height; //!< Height of the root: 0 for a leaf.
+
+		public:
+		/*! \class transient_vector
+			\brief version of a persistent_vector that is changed in place.
+
+			It owns the nodes it copies and changes them in place afterwards; the nodes it shares
+			with persistent versions are copied on the first change, as persistent_vector does.
+			persistent() returns the current contents as a persistent_vector and gives up the nodes,
+			so that later changes do not show in that version. A transient is not thread safe, and
+			it cannot be copied: two copies would change the same nodes in place. It can be moved,
+			which leaves the source empty.
+		*/
+		class transient_vector{
+			public:
+				//=== Constructors
+				/// Transient holding the elements of list.
+				explicit transient_vector( const persistent_vector & list = persistent_vector() )
+					: m_list( list ), m_owner{new_owner()}
+				{/*empty*/}
+
+				transient_vector( const transient_vector & ) = delete;
+				transient_vector & operator=( const transient_vector & ) = delete;
+
+				/// Move constructor. Takes the nodes of other, which is left empty with an owner id of its own.
+				transient_vector( transient_vector && other ) noexcept
+					: m_list( std::move( other.m_list ) ), m_owner{other.m_owner}
+				{ other.m_owner = new_owner(); }
+
+				/// Move assignment. Takes the nodes of other, which is left empty with an owner id of its own.
+				transient_vector & operator=( transient_vector && other ) noexcept
+				{
+					if( this != &other )
+					{
+						m_list = std::move( other.m_list );
+						m_owner = other.m_owner;
+						other.m_owner = new_owner();
+					}
+					return *this;
+				}
+
+			public:
+				//=== Methods
+				size_type size( ) const
+				{ return m_list.size(); }
+
+				bool empty( ) const
+				{ return m_list.empty(); }
+
+				const T & operator[]( size_type pos ) const
+				{ return m_list[pos]; }
+
+				/// Appends value.
+				void push_back( const T & value )
+				{ m_list.append( value, m_owner ); }
+
+				/// Replaces the element at pos by value.
+				void set( size_type pos, const T & value )
+				{
+					if( pos >= m_list.m_size )
+						throw std::out_of_range("error in set(): out of range");
+					node * root = assoc( m_list.m_root, m_list.m_height, pos, value, m_owner );
+					release( m_list.m_root );
+					m_list.m_root = root;
+				}
+
+				/// Returns the contents as a persistent_vector. Later changes of the transient copy the nodes again.
+				persistent_vector persistent( )
+				{
+					m_owner = new_owner();
+					return m_list;
+				}
+
+			private:
+				persistent_vector m_list; //!< Current contents.
+				uint64_t m_owner; //!< Id of the nodes this transient may change in place.
+		};
+
+		/*! \class const_iterator
+			\brief random access iterator over the elements of a persistent_vector.
+
+			It keeps the leaf of the last element it read, so that a scan goes down the tree once
+			per leaf rather than once per element.
+		*/
+		class const_iterator{
+			public:
+				//=== Alias
+				typedef std::ptrdiff_t difference_type; //!< Distance between two iterators.
+				typedef T value_type; //!< Type of the pointed element.
+				typedef const T * pointer; //!< Pointer to the element.
+				typedef const T & reference; //!< Reference to the element.
+				typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+
+				//=== Constructor
+				const_iterator( const persistent_vector * list = nullptr, size_type index = 0 )
+					: m_list{list}, m_index{index}, m_items{nullptr}, m_first{0}, m_last{0}
+				{/*empty*/}
+
+				//=== Operators
+				reference operator*( ) const
+				{
+					if( m_index < m_first or m_index >= m_last )
+					{
+						size_type pos = m_index;
+						leaf * l = leaf_at( m_list->m_root, m_list->m_height, pos );
+						m_items = l->items();
+						m_first = m_index - pos;
+						m_last = m_first + l->count;
+					}
+					return m_items[m_index - m_first];
+				}
+
+				pointer operator->( ) const
+				{ return &**this; }
+
+				reference operator[]( difference_type n ) const
+				{ return *( *this + n ); }
+
+				const_iterator & operator++( )
+				{ ++m_index; return *this; }
+
+				const_iterator operator++( int )
+				{ const_iterator old( *this ); ++m_index; return old; }
+
+				const_iterator & operator--( )
+				{ --m_index; return *this; }
+
+				const_iterator operator--( int )
+				{ const_iterator old( *this ); --m_index; return old; }
+
+				const_iterator & operator+=( difference_type n )
+				{ m_index += n; return *this; }
+
+				const_iterator & operator-=( difference_type n )
+				{ m_index -= n; return *this; }
+
+				const_iterator operator+( difference_type n ) const
+				{ const_iterator it( *this ); return it += n; }
+
+				const_iterator operator-( difference_type n ) const
+				{ const_iterator it( *this ); return it -= n; }
+
+				difference_type operator-( const const_iterator & rhs ) const
+				{ return (difference_type) m_index - (difference_type) rhs.m_index; }
+
+				bool operator==( const const_iterator & rhs ) const
+				{ return m_index == rhs.m_index; }
+
+				bool operator!=( const const_iterator & rhs ) const
+				{ return m_index != rhs.m_index; }
+
+				bool operator<( const const_iterator & rhs ) const
+				{ return m_index < rhs.m_index; }
+
+				bool operator>( const const_iterator & rhs ) const
+				{ return m_index > rhs.m_index; }
+
+				bool operator<=( const const_iterator & rhs ) const
+				{ return m_index <= rhs.m_index; }
+
+				bool operator>=( const const_iterator & rhs ) const
+				{ return m_index >= rhs.m_index; }
+
+			private:
+				const persistent_vector * m_list; //!< Iterated list.
+				size_type m_index; //!< Index of the pointed element.
+				mutable const T * m_items; //!< Elements of the last leaf read.
+				mutable size_type m_first; //!< Index of the first element of that leaf.
+				mutable size_type m_last; //!< Index past its last element.
+		};
+	};
+
+	template< typename T >
+	constexpr typename persistent_vector<T>::size_type persistent_vector<T>::branching;
+
+	template< typename T >
+	constexpr unsigned persistent_vector<T>::bits;
+
+	template< typename T >
+	constexpr typename persistent_vector<T>::size_type persistent_vector<T>::max_extra_steps;
+
+} // namespace sc
+
+#endif
@@ -0,0 +1,483 @@
+#ifndef SEGMENTED_VECTOR_H
+#define SEGMENTED_VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \struct default_block_size
+		\brief elements of a segmented_vector block: the largest power of two that fits in Bytes, at least 1.
+	*/
+	template< typename T, size_t Bytes = 16384 >
+	struct default_block_size
+	{
+		/// Largest power of two not above n, from p up.
+		static constexpr size_t floor_pow2( size_t n, size_t p = 1 )
+		{ return p * 2 <= n ? floor_pow2( n, p * 2 ) : p; }
+
+		static constexpr size_t value = sizeof(T) >= Bytes ? 1 : floor_pow2( Bytes / sizeof(T) );
+	};
+
+	template< typename T, size_t Bytes >
+	constexpr size_t default_block_size<T, Bytes>::value;
+
+	/*! \class segmented_vector
+		\brief growable list stored in blocks of BlockSize elements, that never moves its elements.
+
+		Element i is at offset i % BlockSize of block i / BlockSize; BlockSize is a power of two, so
+		both are a shift and a mask. The blocks are listed by a directory, a sc::vector of pointers.
+		Growing the list allocates one more block and appends its pointer: the elements are never
+		copied, so a push_back costs the same however large the list is, memory never holds two
+		copies of it, and pointers and references to elements stay valid until the element is
+		removed. The directory itself does grow by reallocation, but it holds one pointer per
+		block, BlockSize times fewer bytes than the elements.
+
+		Iterators point into the directory, as those of std::deque do into its map: adding a
+		block may invalidate them, while references stay valid. Elements are appended and removed
+		at the back only; pop_back(), clear() and resize() keep the blocks for reuse, and
+		shrink_to_fit() frees those that hold no element.
+	*/
+	template< typename T, typename Alloc = std::allocator<T>, size_t BlockSize = default_block_size<T>::value >
+	class segmented_vector{
+
+		static_assert( BlockSize != 0 and ( BlockSize & ( BlockSize - 1 ) ) == 0, "the block size is a power of two" );
+
+		public:
+			//=== Alias
+			typedef size_t size_type; //!< Type of size.
+			typedef T value_type; //!< Type of the elements.
+			typedef Alloc allocator_type; //!< Type of the allocator.
+
+			template< typename R >
+			class basic_iterator;
+			typedef basic_iterator< T > iterator; //!< Random access iterator.
+			typedef basic_iterator< const T > const_iterator; //!< Random access iterator to const elements.
+
+			static constexpr size_type block_size = BlockSize; //!< Elements of a block.
+
+		protected:
+			typedef std::allocator_traits<Alloc> alloc_traits; //!< Allocator interface.
+			typedef typename alloc_traits::template rebind_alloc<T*> directory_alloc; //!< Allocator of the directory.
+			typedef vector<T*, directory_alloc> directory_type; //!< Pointers to the blocks, then nullptr.
+
+		public:
+			//=== Constructors
+			/// Empty list. Allocates nothing.
+			explicit segmented_vector( const Alloc & alloc = Alloc() )
+				: m_dir( directory_alloc( alloc ) ), m_size{0}, m_alloc(alloc)
+			{/*empty*/}
+
+			/// List of count value-initialized elements.
+			explicit segmented_vector( size_type count, const Alloc & alloc = Alloc() )
+				: segmented_vector( alloc )
+			{ resize( count ); }
+
+			/// List of count copies of value.
+			segmented_vector( size_type count, const T & value, const Alloc & alloc = Alloc() )
+				: segmented_vector( alloc )
+			{ resize( count, value ); }
+
+			/// List of the elements in [first, last).
+			template< typename InputIt, typename = typename std::enable_if<
+				not std::is_integral<InputIt>::value >::type >
+			segmented_vector( InputIt first, InputIt last, const Alloc & alloc = Alloc() )
+				: segmented_vector( alloc )
+			{
+				for( ; first != last ; ++first )
+					emplace_back( *first );
+			}
+
+			/// List of the elements of ilist.
+			segmented_vector( std::initializer_list<T> ilist, const Alloc & alloc = Alloc() )
+				: segmented_vector( ilist.begin(), ilist.end(), alloc )
+			{/*empty*/}
+
+			/// Copy constructor.
+			segmented_vector( const segmented_vector & other )
+				: segmented_vector( alloc_traits::select_on_container_copy_construction( other.m_alloc ) )
+			{
+				reserve( other.m_size );
+				for( size_type i{0u} ; i < other.m_size ; ++i )
+					emplace_back( other[i] );
+			}
+
+			/// Move constructor. Takes the blocks of other, leaving it empty.
+			segmented_vector( segmented_vector && other ) noexcept
+				: segmented_vector( other.m_alloc )
+			{ swap( other ); }
+
+			/// Destructor.
+			~segmented_vector( )
+			{
+				clear();
+				free_blocks( 0 );
+			}
+
+			/// Copy and move assignment.
+			segmented_vector & operator=( segmented_vector other ) noexcept
+			{
+				swap( other );
+				return *this;
+			}
+
+		public:
+			//=== Iterators
+			iterator begin( )
+			{ return iterator( directory(), 0 ); }
+
+			iterator end( )
+			{ return iterator( directory(), m_size ); }
+
+			const_iterator begin( ) const
+			{ return const_iterator( directory(), 0 ); }
+
+			const_iterator end( ) const
+			{ return const_iterator( directory(), m_size ); }
+
+			const_iterator cbegin( ) const
+			{ return begin(); }
+
+			const_iterator cend( ) const
+			{ return end(); }
+
+		public:
+			//=== Capacity
+			size_type size( ) const
+			{ return m_size; }
+
+			bool empty( ) const
+			{ return m_size == 0; }
+
+			/// Returns the number of elements the allocated blocks hold.
+			size_type capacity( ) const
+			{ return blocks() * BlockSize; }
+
+			allocator_type get_allocator( ) const
+			{ return m_alloc; }
+
+			/// Allocates blocks until new_cap elements fit. Moves no element.
+			void reserve( size_type new_cap )
+			{
+				size_type needed = ( new_cap + BlockSize - 1 ) / BlockSize;
+				if( needed <= blocks() )
+					return;
+				m_dir.reserve( needed + 1 );
+				while( blocks() < needed )
+					add_block();
+			}
+
+			/// Frees the blocks that hold no element, and the unused directory.
+			void shrink_to_fit( )
+			{
+				free_blocks( ( m_size + BlockSize - 1 ) / BlockSize );
+				m_dir.shrink_to_fit();
+			}
+
+		public:
+			//=== Access
+			T & operator[]( size_type pos )
+			{ return m_dir[pos / BlockSize][pos % BlockSize]; }
+
+			const T & operator[]( size_type pos ) const
+			{ return m_dir[pos / BlockSize][pos % BlockSize]; }
+
+			T & at( size_type pos )
+			{
+				if( not (pos < m_size) )
+					throw std::out_of_range("error in at(): out of range");
+				return (*this)[pos];
+			}
+
+			const T & at( size_type pos ) const
+			{
+				if( not (pos < m_size) )
+					throw std::out_of_range("error in at(): out of range");
+				return (*this)[pos];
+			}
+
+			T & front( )
+			{ return (*this)[0]; }
+
+			const T & front( ) const
+			{ return (*this)[0]; }
+
+			T & back( )
+			{ return (*this)[m_size - 1]; }
+
+			const T & back( ) const
+			{ return (*this)[m_size - 1]; }
+
+		public:
+			//=== Modifiers
+			void push_back( const T & value )
+			{ emplace_back( value ); }
+
+			void push_back( T && value )
+			{ emplace_back( std::move( value ) ); }
+
+			/// Appends an element constructed from args, allocating a block if the last one is full.
+			template< typename... Args >
+			T & emplace_back( Args&&... args )
+			{
+				if( m_size == capacity() )
+					add_block();
+
+				T * slot = m_dir[m_size / BlockSize] + m_size % BlockSize;
+				alloc_traits::construct( m_alloc, slot, std::forward<Args>( args )... );
+				++m_size;
+				return *slot;
+			}
+
+			/// Removes the last element. Its block is kept.
+			void pop_back( )
+			{
+				--m_size;
+				alloc_traits::destroy( m_alloc, &(*this)[m_size] );
+			}
+
+			/// Removes every element. The blocks are kept.
+			void clear( )
+			{
+				while( m_size != 0 )
+					pop_back();
+			}
+
+			/// Keeps the first count elements, or appends value-initialized ones up to count.
+			void resize( size_type count )
+			{
+				reserve( count );
+				while( m_size > count )
+					pop_back();
+				while( m_size < count )
+					emplace_back();
+			}
+
+			/// Keeps the first count elements, or appends copies of value up to count.
+			void resize( size_type count, const T & value )
+			{
+				reserve( count );
+				while( m_size > count )
+					pop_back();
+				while( m_size < count )
+					emplace_back( value );
+			}
+
+			/// Exchanges the contents, and the allocators, of the two lists.
+			void swap( segmented_vector & other ) noexcept
+			{
+				using std::swap;
+				swap( m_dir, other.m_dir );
+				swap( m_size, other.m_size );
+				swap( m_alloc, other.m_alloc );
+			}
+
+		public:
+			//=== Comparison
+			bool operator==( const segmented_vector & rhs ) const
+			{
+				if( m_size != rhs.m_size )
+					return false;
+				for( size_type i{0u} ; i < m_size ; ++i )
+					if( not ( (*this)[i] == rhs[i] ) )
+						return false;
+				return true;
+			}
+
+			bool operator!=( const segmented_vector & rhs ) const
+			{ return not ( *this == rhs ); }
+
+		protected:
+			/// Returns the number of allocated blocks.
+			size_type blocks( ) const
+			{ return m_dir.size() != 0 ? m_dir.size() - 1 : 0; }
+
+			/// Returns the directory, which always ends with nullptr: iterators step onto it at the end.
+			T * const * directory( ) const
+			{
+				static T * const none = nullptr;
+				return m_dir.size() != 0 ? &m_dir[0] : &none;
+			}
+
+			/// Allocates a block and lists it in the directory.
+			void add_block( )
+			{
+				if( m_dir.size() == 0 )
+					m_dir.push_back( nullptr );
+				m_dir.push_back( nullptr );
+				try { m_dir[m_dir.size() - 2] = alloc_traits::allocate( m_alloc, BlockSize ); }
+				catch( ... ) { m_dir.pop_back(); throw; }
+			}
+
+			/// Frees the blocks from index first on, which must hold no element.
+			void free_blocks( size_type first )
+			{
+				while( blocks() > first )
+				{
+					alloc_traits::deallocate( m_alloc, m_dir[m_dir.size() - 2], BlockSize );
+					m_dir.pop_back();
+					m_dir[m_dir.size() - 1] = nullptr;
+				}
+				if( blocks() == 0 )
+					m_dir.clear();
+			}
+
+		protected:
+			directory_type m_dir; //!< Pointers to the blocks and a trailing nullptr, or nothing.
+			size_type m_size; //!< Number of elements.
+			Alloc m_alloc; //!< Allocator of the blocks.
+
+		public:
+		/*! \class basic_iterator
+			\brief random access iterator over the elements of a segmented_vector.
+
+			It holds the directory entry of its block and a pointer into the block, so stepping
+			within a block is a pointer increment.
+		*/
+		template< typename R >
+		class basic_iterator{
+			public:
+				//=== Alias
+				typedef std::ptrdiff_t difference_type; //!< Distance between two iterators.
+				typedef T value_type; //!< Type of the pointed element.
+				typedef R * pointer; //!< Pointer to the element.
+				typedef R & reference; //!< Reference to the element.
+				typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+
+				//=== Constructors
+				basic_iterator( T * const * dir = nullptr, size_type index = 0 )
+					: m_block{dir != nullptr ? dir + index / BlockSize : nullptr},
+					  m_cur{dir != nullptr ? block_at( m_block, index % BlockSize ) : nullptr}
+				{/*empty*/}
+
+				/// An iterator converts to a const_iterator.
+				template< typename S, typename = typename std::enable_if<
+					std::is_convertible<S*, R*>::value >::type >
+				basic_iterator( const basic_iterator<S> & other )
+					: m_block{other.m_block}, m_cur{other.m_cur}
+				{/*empty*/}
+
+				//=== Operators
+				reference operator*( ) const
+				{ return *m_cur; }
+
+				pointer operator->( ) const
+				{ return m_cur; }
+
+				reference operator[]( difference_type n ) const
+				{ return *( *this + n ); }
+
+				basic_iterator & operator++( )
+				{
+					if( ++m_cur == *m_block + BlockSize )
+						m_cur = *++m_block;
+					return *this;
+				}
+
+				basic_iterator operator++( int )
+				{ basic_iterator old( *this ); ++*this; return old; }
+
+				basic_iterator & operator--( )
+				{
+					if( m_cur == *m_block )
+						m_cur = *--m_block + BlockSize;
+					--m_cur;
+					return *this;
+				}
+
+				basic_iterator operator--( int )
+				{ basic_iterator old( *this ); --*this; return old; }
+
+				basic_iterator & operator+=( difference_type n )
+				{
+					difference_type offset = offset_in_block() + n;
+					if( offset >= 0 and offset < (difference_type) BlockSize )
+					{
+						m_cur += n;
+						return *this;
+					}
+					// Floor division, for steps back past the block.
+					difference_type step = offset >= 0 ? offset / (difference_type) BlockSize
+						: -( ( -offset - 1 ) / (difference_type) BlockSize ) - 1;
+					m_block += step;
+					m_cur = block_at( m_block, (size_type)( offset - step * (difference_type) BlockSize ) );
+					return *this;
+				}
+
+				basic_iterator & operator-=( difference_type n )
+				{ return *this += -n; }
+
+				basic_iterator operator+( difference_type n ) const
+				{ basic_iterator it( *this ); return it += n; }
+
+				basic_iterator operator-( difference_type n ) const
+				{ basic_iterator it( *this ); return it -= n; }
+
+				template< typename S >
+				difference_type operator-( const basic_iterator<S> & rhs ) const
+				{
+					return ( m_block - rhs.m_block ) * (difference_type) BlockSize
+						+ offset_in_block() - rhs.offset_in_block();
+				}
+
+				template< typename S >
+				bool operator==( const basic_iterator<S> & rhs ) const
+				{ return m_block == rhs.m_block and m_cur == rhs.m_cur; }
+
+				template< typename S >
+				bool operator!=( const basic_iterator<S> & rhs ) const
+				{ return not ( *this == rhs ); }
+
+				template< typename S >
+				bool operator<( const basic_iterator<S> & rhs ) const
+				{ return *this - rhs < 0; }
+
+				template< typename S >
+				bool operator>( const basic_iterator<S> & rhs ) const
+				{ return *this - rhs > 0; }
+
+				template< typename S >
+				bool operator<=( const basic_iterator<S> & rhs ) const
+				{ return *this - rhs <= 0; }
+
+				template< typename S >
+				bool operator>=( const basic_iterator<S> & rhs ) const
+				{ return *this - rhs >= 0; }
+
+			private:
+				template< typename S >
+				friend class basic_iterator;
+
+				/// Returns a pointer to offset in the block listed at entry, nullptr past the last block.
+				static T * block_at( T * const * entry, size_type offset )
+				{ return *entry != nullptr ? *entry + offset : nullptr; }
+
+				difference_type offset_in_block( ) const
+				{ return m_cur != nullptr ? m_cur - *m_block : 0; }
+
+				T * const * m_block; //!< Directory entry of the block.
+				R * m_cur; //!< Pointed element, nullptr on the trailing directory entry.
+		};
+	};
+
+	template< typename T, typename Alloc, size_t BlockSize >
+	constexpr typename segmented_vector<T, Alloc, BlockSize>::size_type segmented_vector<T, Alloc, BlockSize>::block_size;
+
+	/// Exchanges the contents of the two lists.
+	template< typename T, typename Alloc, size_t BlockSize >
+	void swap( segmented_vector<T, Alloc, BlockSize> & lhs, segmented_vector<T, Alloc, BlockSize> & rhs ) noexcept
+	{ lhs.swap( rhs ); }
+
+} // namespace sc
+
+#endif
@@ -0,0 +1,414 @@
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <stdexcept>
+#include <type_traits>
+
+#include <unistd.h>
+
+#include "vector.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \namespace io
+		\brief binary save and load of sc::vector to streams and file descriptors.
+
+		A saved list is a 64 byte header (a magic number, the format version, the size of an element
+		and the number of elements) followed by the elements. Trivially copyable elements are written
+		and read as they are laid out in memory, with one bulk call; a saved list of them is also a
+		file that sc::mmap_vector opens. Other element types need a codec (std::string has one).
+		An sc::vector<bool> is saved as its words, 64 flags each, the header counting the flags.
+
+		Data is written in the byte order of the machine. A stream or descriptor that fails throws
+		std::system_error for descriptors and std::runtime_error for streams, as does input that is
+		not a saved list of the expected element type, or that ends early.
+	*/
+	namespace io{
+
+		static constexpr uint32_t format_version = 1; //!< Version of the layout.
+		static constexpr size_t read_chunk = 1 << 20; //!< Most bytes a load allocates ahead of the data read.
+		static constexpr uint32_t packed_flags = ~uint32_t(0); //!< element_size of a saved sc::vector<bool>.
+
+		/// First bytes of a saved list, or of a mmap_vector file.
+		struct header
+		{
+			char magic[8]; //!< "SCMMVEC" and a null.
+			uint32_t version; //!< format_version.
+			uint32_t element_size; //!< sizeof(T) for raw elements, 0 for those of variable size, packed_flags for flags.
+			uint64_t size; //!< Number of elements.
+			char reserved[40]; //!< Zeros.
+		};
+
+		static_assert( sizeof(header) == 64, "the header takes 64 bytes" );
+
+		/// Returns the magic number, 8 bytes with the null.
+		inline const char * magic( )
+		{ return "SCMMVEC"; }
+
+		/// Returns the header of a list of count elements of element_size bytes.
+		inline header make_header( uint32_t element_size, uint64_t count )
+		{
+			header h;
+			std::memset( &h, 0, sizeof(h) );
+			std::memcpy( h.magic, magic(), sizeof(h.magic) );
+			h.version = format_version;
+			h.element_size = element_size;
+			h.size = count;
+			return h;
+		}
+
+		/// Throws std::runtime_error unless h starts a list of elements of element_size bytes.
+		inline void check_header( const header & h, uint32_t element_size )
+		{
+			if( std::memcmp( h.magic, magic(), sizeof(h.magic) ) != 0 or h.version != format_version )
+				throw std::runtime_error( "error in load(): not a saved sc::vector" );
+			if( h.element_size != element_size )
+				throw std::runtime_error( "error in load(): the elements are of another size" );
+		}
+
+		//=== Sinks and sources
+		/// Writes to an output stream.
+		struct stream_sink
+		{
+			std::ostream & os;
+
+			void write( const void * bytes, size_t count )
+			{
+				if( not os.write( static_cast<const char*>( bytes ), (std::streamsize) count ) )
+					throw std::runtime_error( "error in save(): the stream failed" );
+			}
+		};
+
+		/// Writes to a file descriptor.
+		struct fd_sink
+		{
+			int fd;
+
+			void write( const void * bytes, size_t count )
+			{
+				const char * p = static_cast<const char*>( bytes );
+				while( count != 0 )
+				{
+					ssize_t done = ::write( fd, p, count );
+					if( done < 0 and errno == EINTR )
+						continue;
+					if( done < 0 )
+						throw std::system_error( errno, std::generic_category(), "error in save(): write" );
+					p += done;
+					count -= (size_t) done;
+				}
+			}
+		};
+
+		/// Reads from an input stream.
+		struct stream_source
+		{
+			std::istream & is;
+
+			void read( void * bytes, size_t count )
+			{
+				if( not is.read( static_cast<char*>( bytes ), (std::streamsize) count ) )
+					throw std::runtime_error( "error in load(): the stream ended early or failed" );
+			}
+		};
+
+		/// Reads from a file descriptor.
+		struct fd_source
+		{
+			int fd;
+
+			void read( void * bytes, size_t count )
+			{
+				char * p = static_cast<char*>( bytes );
+				while( count != 0 )
+				{
+					ssize_t done = ::read( fd, p, count );
+					if( done < 0 and errno == EINTR )
+						continue;
+					if( done < 0 )
+						throw std::system_error( errno, std::generic_category(), "error in load(): read" );
+					if( done == 0 )
+						throw std::runtime_error( "error in load(): the file ended early" );
+					p += done;
+					count -= (size_t) done;
+				}
+			}
+		};
+
+		//=== Codecs
+		/*! \struct codec
+			\brief how elements of type T are written and read.
+
+			A codec has a static element_size, written to the header, a static bool raw, and, unless
+			raw, the static templates write( Sink &, const T & ) and read( Source &, T & ). Raw
+			elements are copied as bytes, many at a time. Specialize it for other types.
+		*/
+		template< typename T, typename Enable = void >
+		struct codec
+		{
+			static_assert( std::is_trivially_copyable<T>::value, "no codec for this element type: specialize sc::io::codec" );
+		};
+
+		/// Trivially copyable elements: their bytes.
+		template< typename T >
+		struct codec< T, typename std::enable_if< std::is_trivially_copyable<T>::value >::type >
+		{
+			static constexpr uint32_t element_size = sizeof(T);
+			static constexpr bool raw = true;
+		};
+
+		/// Strings: their length, on 8 bytes, then their characters.
+		template< typename C, typename Traits, typename A >
+		struct codec< std::basic_string<C, Traits, A> >
+		{
+			static constexpr uint32_t element_size = 0;
+			static constexpr bool raw = false;
+
+			template< typename Sink >
+			static void write( Sink & sink, const std::basic_string<C, Traits, A> & value )
+			{
+				uint64_t length = value.size();
+				sink.write( &length, sizeof(length) );
+				sink.write( value.data(), length * sizeof(C) );
+			}
+
+			template< typename Source >
+			static void read( Source & source, std::basic_string<C, Traits, A> & value )
+			{
+				uint64_t length;
+				source.read( &length, sizeof(length) );
+
+				// The length is not trusted: the string grows as the characters arrive.
+				const uint64_t chunk = read_chunk / sizeof(C);
+				value.clear();
+				for( uint64_t done{0u} ; done < length ; )
+				{
+					size_t count = (size_t) std::min( length - done, chunk );
+					value.resize( (size_t) done + count );
+					source.read( &value[(size_t) done], count * sizeof(C) );
+					done += count;
+				}
+			}
+		};
+
+		//=== Writing
+		/// Writes count elements from data to sink, in one call for raw elements.
+		template< typename T, typename Sink >
+		void write_elements( Sink & sink, const T * data, size_t count, std::true_type )
+		{
+			if( count != 0 )
+				sink.write( data, count * sizeof(T) );
+		}
+
+		template< typename T, typename Sink >
+		void write_elements( Sink & sink, const T * data, size_t count, std::false_type )
+		{
+			for( size_t i{0u} ; i < count ; ++i )
+				codec<T>::write( sink, data[i] );
+		}
+
+		/// Writes the header and the elements of vec to sink.
+		template< typename Sink, typename T, typename A, typename G >
+		void save_to( Sink & sink, const vector<T, A, G> & vec )
+		{
+			header h = make_header( codec<T>::element_size, vec.size() );
+			sink.write( &h, sizeof(h) );
+			const T * data = vec.size() != 0 ? &*vec.begin() : nullptr;
+			write_elements( sink, data, vec.size(), std::integral_constant<bool, codec<T>::raw>() );
+		}
+
+		/// Writes the header and the words of flags to sink.
+		template< typename Sink, typename A, typename G >
+		void save_to( Sink & sink, const vector<bool, A, G> & flags )
+		{
+			typedef typename vector<bool, A, G>::word_type word_type;
+			const size_t word_bits = vector<bool, A, G>::word_bits;
+
+			header h = make_header( packed_flags, flags.size() );
+			sink.write( &h, sizeof(h) );
+			size_t words = ( flags.size() + word_bits - 1 ) / word_bits;
+			if( words != 0 )
+				sink.write( flags.words(), words * sizeof(word_type) );
+		}
+
+		/// Writes vec to os.
+		template< typename T, typename A, typename G >
+		void save( std::ostream & os, const vector<T, A, G> & vec )
+		{
+			stream_sink sink{ os };
+			save_to( sink, vec );
+		}
+
+		/// Writes vec to the file descriptor fd, from its current offset.
+		template< typename T, typename A, typename G >
+		void save( int fd, const vector<T, A, G> & vec )
+		{
+			fd_sink sink{ fd };
+			save_to( sink, vec );
+		}
+
+		//=== Reading
+		/*! \class basic_reader
+			\brief reads a saved list a chunk at a time.
+
+			The header is read by the constructor; each read() then appends at most a given number
+			of elements to a vector, so a large list can be processed without holding all of it.
+		*/
+		template< typename T, typename Source >
+		class basic_reader{
+
+			static_assert( not std::is_same<T, bool>::value, "sc::vector<bool> packs its flags into words: load() reads it whole" );
+
+			public:
+				typedef size_t size_type; //!< Type of size.
+
+				//=== Constructors
+				/// Reads and checks the header from source.
+				explicit basic_reader( Source source )
+					: m_source( source ), m_size{0}, m_read{0}
+				{
+					header h;
+					m_source.read( &h, sizeof(h) );
+					check_header( h, codec<T>::element_size );
+					m_size = (size_type) h.size;
+				}
+
+			public:
+				//=== Methods
+				/// Returns the number of elements of the saved list.
+				size_type size( ) const
+				{ return m_size; }
+
+				/// Returns the number of elements not read yet.
+				size_type remaining( ) const
+				{ return m_size - m_read; }
+
+				/// Checks whether every element was read.
+				bool done( ) const
+				{ return m_read == m_size; }
+
+				/// Appends up to count of the next elements to out. Returns how many it appended.
+				/// out grows read_chunk bytes at a time, as the elements arrive, and is left as it was
+				/// if reading fails.
+				template< typename A, typename G >
+				size_type read( vector<T, A, G> & out, size_type count )
+				{
+					count = count < remaining() ? count : remaining();
+					if( count == 0 )
+						return 0;
+
+					const size_type chunk = read_chunk / sizeof(T) != 0 ? read_chunk / sizeof(T) : 1;
+					size_type first = out.size();
+					try {
+						for( size_type done{0u} ; done < count ; )
+						{
+							size_type n = std::min( count - done, chunk );
+							out.resize( first + done + n );
+							read_elements( &out[first + done], n, std::integral_constant<bool, codec<T>::raw>() );
+							done += n;
+						}
+					}
+					catch( ... ) { out.resize( first ); throw; }
+
+					m_read += count;
+					return count;
+				}
+
+			protected:
+				/// Reads count raw elements into dest with one call.
+				void read_elements( T * dest, size_type count, std::true_type )
+				{ m_source.read( dest, count * sizeof(T) ); }
+
+				void read_elements( T * dest, size_type count, std::false_type )
+				{
+					for( size_type i{0u} ; i < count ; ++i )
+						codec<T>::read( m_source, dest[i] );
+				}
+
+			protected:
+				Source m_source; //!< Where the list is read from.
+				size_type m_size; //!< Elements of the saved list.
+				size_type m_read; //!< Elements read so far.
+		};
+
+		/// Reader of a list saved to a stream.
+		template< typename T >
+		using stream_reader = basic_reader<T, stream_source>;
+
+		/// Reader of a list saved to a file descriptor.
+		template< typename T >
+		using fd_reader = basic_reader<T, fd_source>;
+
+		/// Returns a reader of the list saved in is.
+		template< typename T >
+		stream_reader<T> reader( std::istream & is )
+		{ return stream_reader<T>( stream_source{ is } ); }
+
+		/// Returns a reader of the list saved in the file descriptor fd, from its current offset.
+		template< typename T >
+		fd_reader<T> reader( int fd )
+		{ return fd_reader<T>( fd_source{ fd } ); }
+
+		/// Reads the list saved in source, then moves it into vec. vec is left as it was if reading fails.
+		template< typename Source, typename T, typename A, typename G >
+		void load_from( Source source, vector<T, A, G> & vec )
+		{
+			basic_reader<T, Source> in( source );
+			vector<T, A, G> loaded( vec.get_allocator() );
+			in.read( loaded, in.size() );
+			vec = std::move( loaded );
+		}
+
+		/// Reads the words of saved flags, read_chunk bytes at a time, then moves them into flags.
+		template< typename Source, typename A, typename G >
+		void load_from( Source source, vector<bool, A, G> & flags )
+		{
+			typedef typename vector<bool, A, G>::word_type word_type;
+			const size_t word_bits = vector<bool, A, G>::word_bits;
+
+			header h;
+			source.read( &h, sizeof(h) );
+			check_header( h, packed_flags );
+
+			vector<bool, A, G> loaded( flags.get_allocator() );
+			const uint64_t chunk = read_chunk / sizeof(word_type) * word_bits;
+			for( uint64_t done{0u} ; done < h.size ; )
+			{
+				size_t count = (size_t) std::min( h.size - done, chunk );
+				loaded.resize( (size_t) done + count );
+				source.read( loaded.words() + done / word_bits, ( count + word_bits - 1 ) / word_bits * sizeof(word_type) );
+				done += count;
+			}
+
+			// The list keeps the bits past its last flag at 0, whatever the file holds.
+			if( h.size % word_bits != 0 )
+				loaded.words()[h.size / word_bits] &= ( word_type(1) << ( h.size % word_bits ) ) - 1;
+			flags = std::move( loaded );
+		}
+
+		/// Replaces the contents of vec by the list saved in is.
+		template< typename T, typename A, typename G >
+		void load( std::istream & is, vector<T, A, G> & vec )
+		{ load_from( stream_source{ is }, vec ); }
+
+		/// Replaces the contents of vec by the list saved in the file descriptor fd, from its current offset.
+		template< typename T, typename A, typename G >
+		void load( int fd, vector<T, A, G> & vec )
+		{ load_from( fd_source{ fd }, vec ); }
+
+	} // namespace io
+
+} // namespace sc
+
+#endif
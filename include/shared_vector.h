@@ -0,0 +1,337 @@
+#ifndef SHARED_VECTOR_H
+#define SHARED_VECTOR_H
+
+#include <cstddef>
+#include <atomic>
+#include <initializer_list>
+#include <utility>
+
+#include "vector.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \class shared_vector
+		\brief sc::vector whose copies share one buffer until one of them is changed (copy-on-write).
+
+		Copying or assigning a shared_vector only adds a reference to its buffer, so handing the
+		same list to many owners costs no allocation and no element copy. The first change through
+		an owner whose buffer is shared clones the buffer for that owner alone; the others keep
+		seeing the list as it was.
+
+		Reading goes through the const methods: size(), the const operator[], at(), front(), back(),
+		cbegin() and cend(), find(), count(), contains() and get(). The non-const operator[], at(),
+		front(), back(), begin() and end() may be used to write, so they clone a shared buffer as the
+		modifiers do; read a shared list through a const reference to avoid that. References and
+		iterators into the buffer are invalidated when it is cloned.
+
+		The reference count is atomic: owners that share a buffer may be read, changed, copied and
+		destroyed from different threads at once. One owner is not synchronized, like a shared_ptr.
+	*/
+	template< typename T, typename Alloc = std::allocator<T>, typename Growth = growth::doubling >
+	class shared_vector{
+
+		public:
+			//=== Alias
+			typedef vector<T, Alloc, Growth> vector_type; //!< Type of the shared list.
+			typedef size_t size_type; //!< Type of size.
+			typedef T value_type; //!< Type of the elements.
+			typedef typename vector_type::reference reference; //!< Writable element, a proxy for bool.
+			typedef typename vector_type::const_reference const_reference; //!< Read element, by value for bool.
+			typedef typename vector_type::iterator iterator; //!< Random access iterator.
+			typedef typename vector_type::const_iterator const_iterator; //!< Random access iterator to const elements.
+
+		protected:
+			/// A list and the number of its owners.
+			struct buffer
+			{
+				std::atomic<size_t> refs;
+				vector_type items;
+
+				template< typename... Args >
+				explicit buffer( Args&&... args )
+					: refs{1}, items( std::forward<Args>( args )... )
+				{/*empty*/}
+			};
+
+			/// Drops a reference to a buffer when it goes out of scope.
+			struct reference_guard
+			{
+				buffer * held;
+
+				~reference_guard( )
+				{ release( held ); }
+			};
+
+		public:
+			//=== Constructors
+			/// Empty list. Allocates nothing.
+			shared_vector( )
+				: m_buf{nullptr}
+			{/*empty*/}
+
+			/// List of the elements of items, copied.
+			explicit shared_vector( const vector_type & items )
+				: m_buf{new buffer( items )}
+			{/*empty*/}
+
+			/// List of the elements of items, moved.
+			explicit shared_vector( vector_type && items )
+				: m_buf{new buffer( std::move( items ) )}
+			{/*empty*/}
+
+			/// List of the elements in [first, last).
+			template< typename InputIt >
+			shared_vector( InputIt first, InputIt last )
+				: m_buf{new buffer( first, last )}
+			{/*empty*/}
+
+			/// List of the elements of ilist.
+			shared_vector( std::initializer_list<T> ilist )
+				: m_buf{new buffer( ilist )}
+			{/*empty*/}
+
+			/// Copy constructor. Shares the buffer of other.
+			shared_vector( const shared_vector & other ) noexcept
+				: m_buf{other.m_buf}
+			{
+				if( m_buf != nullptr )
+					m_buf->refs.fetch_add( 1, std::memory_order_relaxed );
+			}
+
+			/// Move constructor. Takes the buffer of other, leaving it empty.
+			shared_vector( shared_vector && other ) noexcept
+				: m_buf{other.m_buf}
+			{ other.m_buf = nullptr; }
+
+			/// Destructor. Frees the buffer if this was its last owner.
+			~shared_vector( )
+			{ release( m_buf ); }
+
+			/// Copy and move assignment. A copy shares the buffer of other.
+			shared_vector & operator=( shared_vector other ) noexcept
+			{
+				swap( other );
+				return *this;
+			}
+
+		public:
+			//=== Reading
+			/// Returns the list, for reading.
+			const vector_type & get( ) const
+			{ return m_buf != nullptr ? m_buf->items : empty_list(); }
+
+			size_type size( ) const
+			{ return get().size(); }
+
+			size_type capacity( ) const
+			{ return get().capacity(); }
+
+			bool empty( ) const
+			{ return size() == 0; }
+
+			const_reference operator[]( size_type pos ) const
+			{ return get()[pos]; }
+
+			const_reference at( size_type pos ) const
+			{ return get().at( pos ); }
+
+			const_reference front( ) const
+			{ return get().front(); }
+
+			const_reference back( ) const
+			{ return get().back(); }
+
+			const_iterator begin( ) const
+			{ return get().begin(); }
+
+			const_iterator end( ) const
+			{ return get().end(); }
+
+			const_iterator cbegin( ) const
+			{ return get().cbegin(); }
+
+			const_iterator cend( ) const
+			{ return get().cend(); }
+
+			const_iterator find( const T & value ) const
+			{ return get().find( value ); }
+
+			size_type count( const T & value ) const
+			{ return get().count( value ); }
+
+			bool contains( const T & value ) const
+			{ return get().contains( value ); }
+
+			bool operator==( const shared_vector & rhs ) const
+			{ return m_buf == rhs.m_buf or get() == rhs.get(); }
+
+			bool operator!=( const shared_vector & rhs ) const
+			{ return not ( *this == rhs ); }
+
+			/// Returns the number of owners of the buffer, 0 if there is none.
+			size_t use_count( ) const
+			{ return m_buf != nullptr ? m_buf->refs.load( std::memory_order_acquire ) : 0; }
+
+			/// Checks whether no other owner shares the buffer, so that a change does not clone it.
+			bool unique( ) const
+			{ return use_count() <= 1; }
+
+		public:
+			//=== Writing
+			/// Returns the list, for writing: clones the buffer first if it is shared.
+			vector_type & mutate( )
+			{
+				release( detach() );
+				return m_buf->items;
+			}
+
+			reference operator[]( size_type pos )
+			{ return mutate()[pos]; }
+
+			reference at( size_type pos )
+			{ return mutate().at( pos ); }
+
+			reference front( )
+			{ return mutate()[0]; }
+
+			reference back( )
+			{ return mutate()[size() - 1]; }
+
+			iterator begin( )
+			{ return mutate().begin(); }
+
+			iterator end( )
+			{ return mutate().end(); }
+
+			void push_back( const T & value )
+			{ reference_guard old{ detach() }; m_buf->items.push_back( value ); }
+
+			void push_back( T && value )
+			{ reference_guard old{ detach() }; m_buf->items.push_back( std::move( value ) ); }
+
+			template< typename... Args >
+			reference emplace_back( Args&&... args )
+			{ reference_guard old{ detach() }; return m_buf->items.emplace_back( std::forward<Args>( args )... ); }
+
+			void push_front( const T & value )
+			{ reference_guard old{ detach() }; m_buf->items.push_front( value ); }
+
+			void push_front( T && value )
+			{ reference_guard old{ detach() }; m_buf->items.push_front( std::move( value ) ); }
+
+			void pop_back( )
+			{ mutate().pop_back(); }
+
+			void pop_front( )
+			{ mutate().pop_front(); }
+
+			/// Inserts value before pos, an iterator of this list.
+			iterator insert( const_iterator pos, const T & value )
+			{
+				size_type index = pos - cbegin();
+				reference_guard old{ detach() };
+				return m_buf->items.insert( m_buf->items.begin() + index, value );
+			}
+
+			/// Inserts the elements in [first, last) before pos, an iterator of this list.
+			template< typename InputIt >
+			iterator insert( const_iterator pos, InputIt first, InputIt last )
+			{
+				size_type index = pos - cbegin();
+				reference_guard old{ detach() };
+				return m_buf->items.insert( m_buf->items.begin() + index, first, last );
+			}
+
+			/// Removes the element at pos, an iterator of this list.
+			iterator erase( const_iterator pos )
+			{
+				size_type index = pos - cbegin();
+				vector_type & items = mutate();
+				return items.erase( items.begin() + index );
+			}
+
+			/// Removes the elements in [first, last), iterators of this list.
+			iterator erase( const_iterator first, const_iterator last )
+			{
+				size_type index = first - cbegin();
+				size_type count = last - first;
+				vector_type & items = mutate();
+				return items.erase( items.begin() + index, items.begin() + index + count );
+			}
+
+			void resize( size_type count )
+			{ mutate().resize( count ); }
+
+			void resize( size_type count, const T & value )
+			{ reference_guard old{ detach() }; m_buf->items.resize( count, value ); }
+
+			void reserve( size_type new_cap )
+			{ mutate().reserve( new_cap ); }
+
+			void shrink_to_fit( )
+			{ mutate().shrink_to_fit(); }
+
+			void assign( size_type count, const T & value )
+			{ reference_guard old{ detach() }; m_buf->items.assign( count, value ); }
+
+			/// Removes every element. A shared buffer is left to its other owners, not cloned.
+			void clear( )
+			{
+				if( unique() )
+					mutate().clear();
+				else
+					shared_vector().swap( *this );
+			}
+
+			/// Exchanges the buffers of the two lists.
+			void swap( shared_vector & other ) noexcept
+			{ std::swap( m_buf, other.m_buf ); }
+
+		protected:
+			/// Makes the buffer of this owner its own, cloning it if it is shared. Returns the buffer
+			/// this owner dropped, still referenced until it is released, or nullptr: arguments that
+			/// point into it stay valid until then.
+			buffer * detach( )
+			{
+				if( m_buf == nullptr )
+				{
+					m_buf = new buffer();
+					return nullptr;
+				}
+				if( m_buf->refs.load( std::memory_order_acquire ) == 1 )
+					return nullptr;
+
+				buffer * old = m_buf;
+				m_buf = new buffer( old->items );
+				return old;
+			}
+
+			/// Drops a reference to buf, freeing it with the last one.
+			static void release( buffer * buf )
+			{
+				if( buf != nullptr and buf->refs.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+					delete buf;
+			}
+
+			/// Returns the list read by owners without a buffer.
+			static const vector_type & empty_list( )
+			{
+				static const vector_type none;
+				return none;
+			}
+
+		protected:
+			buffer * m_buf; //!< Shared list, or nullptr for an empty list.
+	};
+
+	/// Exchanges the contents of the two lists.
+	template< typename T, typename Alloc, typename Growth >
+	void swap( shared_vector<T, Alloc, Growth> & lhs, shared_vector<T, Alloc, Growth> & rhs ) noexcept
+	{ lhs.swap( rhs ); }
+
+} // namespace sc
+
+#endif
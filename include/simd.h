@@ -0,0 +1,538 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) and ( defined(__x86_64__) or defined(__i386__) ) and defined(__SSE2__) and not defined(SC_SIMD_DISABLE)
+#define SC_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \namespace simd
+		\brief search and comparison kernels over contiguous arrays, used by sc::vector.
+
+		Arrays of integers and floating point numbers are scanned 16 bytes at a time with SSE2,
+		or 32 bytes at a time with AVX2 when the CPU running the program has it; any other
+		element type, or a build without x86 (or with SC_SIMD_DISABLE defined), uses the scalar
+		loops; equality of integer arrays is a memcmp. Every kernel gives the same result as its
+		scalar loop, so floating point equality follows operator==: NaN never matches and 0.0
+		matches -0.0.
+
+		popcount() counts the set bits of an array of words, the flags of sc::vector<bool>, with
+		the popcnt instruction when the CPU has it.
+	*/
+	namespace simd{
+
+		/// Tells whether T is compared in vector registers: an integer or floating point number, not bool.
+		template< typename T >
+		struct is_vectorizable
+			: std::integral_constant< bool, std::is_arithmetic<T>::value and not std::is_same<T, bool>::value
+				and ( sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8 ) >
+		{/*empty*/};
+
+		/// Tells whether the smallest and largest T are searched in vector registers. Floating point
+		/// numbers are not: NaN and the sign of zero make min and max depend on the order of the scan.
+		template< typename T >
+		struct has_vector_min
+			: std::integral_constant< bool, is_vectorizable<T>::value and std::is_integral<T>::value >
+		{/*empty*/};
+
+		/*! \namespace scalar
+			\brief one element per iteration, for any T with operator== and operator<.
+		*/
+		namespace scalar{
+
+			/// Returns the index of the first element equal to value, or n.
+			template< typename T >
+			size_t find( const T * p, size_t n, const T & value )
+			{
+				size_t i{0u};
+				while( i < n and not( p[i] == value ) )
+					++i;
+				return i;
+			}
+
+			/// Returns how many elements are equal to value.
+			template< typename T >
+			size_t count( const T * p, size_t n, const T & value )
+			{
+				size_t total{0u};
+				for( size_t i{0u} ; i < n ; ++i )
+					if( p[i] == value )
+						++total;
+				return total;
+			}
+
+			/// Tells whether a[i] == b[i] for every i < n.
+			template< typename T >
+			bool equal( const T * a, const T * b, size_t n )
+			{
+				for( size_t i{0u} ; i < n ; ++i )
+					if( not( a[i] == b[i] ) )
+						return false;
+				return true;
+			}
+
+			/// Returns the index of the first smallest element. n must not be 0.
+			template< typename T >
+			size_t min_index( const T * p, size_t n )
+			{
+				size_t best{0u};
+				for( size_t i{1u} ; i < n ; ++i )
+					if( p[i] < p[best] )
+						best = i;
+				return best;
+			}
+
+			/// Returns the index of the first largest element. n must not be 0.
+			template< typename T >
+			size_t max_index( const T * p, size_t n )
+			{
+				size_t best{0u};
+				for( size_t i{1u} ; i < n ; ++i )
+					if( p[best] < p[i] )
+						best = i;
+				return best;
+			}
+
+			/// Returns how many bits are set in the n words of p.
+			inline size_t popcount( const uint64_t * p, size_t n )
+			{
+				size_t total{0u};
+				for( size_t i{0u} ; i < n ; ++i )
+					total += __builtin_popcountll( p[i] );
+				return total;
+			}
+
+		} // namespace scalar
+
+#ifdef SC_SIMD_X86
+		/// Selects the compare instruction of an element: its size in bytes and whether it is floating point.
+		template< size_t Size, bool Float >
+		struct lane
+		{/*empty*/};
+
+		/// Lane of T.
+		template< typename T >
+		using lane_of = lane< sizeof(T), std::is_floating_point<T>::value >;
+
+		/// Bits of the sign of T, to compare unsigned integers with signed instructions.
+		template< typename T >
+		T sign_bit( )
+		{ return std::is_signed<T>::value ? T(0) : T( T(1) << ( sizeof(T) * 8 - 1 ) ); }
+
+		/*! \namespace sse2
+			\brief 16 byte kernels. SSE2 is part of every x86-64 CPU.
+
+			The comparisons produce a byte mask with sizeof(T) bits per element, so the position
+			and number of matches are found the same way for every element size.
+		*/
+		namespace sse2{
+
+			typedef __m128i reg; //!< A register of 16 bytes.
+			static constexpr size_t width = 16; //!< Bytes per register.
+
+			inline reg load( const void * p )
+			{ return _mm_loadu_si128( static_cast<const reg*>( p ) ); }
+
+			inline unsigned mask( reg r )
+			{ return (unsigned) _mm_movemask_epi8( r ); }
+
+			static constexpr unsigned full = 0xFFFF; //!< Mask of a register whose elements all matched.
+
+			/// Register with every element equal to value.
+			template< typename T >
+			reg broadcast( T value )
+			{
+				T lanes[width / sizeof(T)];
+				for( auto & l : lanes )
+					l = value;
+				return load( lanes );
+			}
+
+			inline reg eq( reg a, reg b, lane<1, false> ) { return _mm_cmpeq_epi8( a, b ); }
+			inline reg eq( reg a, reg b, lane<2, false> ) { return _mm_cmpeq_epi16( a, b ); }
+			inline reg eq( reg a, reg b, lane<4, false> ) { return _mm_cmpeq_epi32( a, b ); }
+			inline reg eq( reg a, reg b, lane<4, true> ) { return _mm_castps_si128( _mm_cmpeq_ps( _mm_castsi128_ps( a ), _mm_castsi128_ps( b ) ) ); }
+			inline reg eq( reg a, reg b, lane<8, true> ) { return _mm_castpd_si128( _mm_cmpeq_pd( _mm_castsi128_pd( a ), _mm_castsi128_pd( b ) ) ); }
+
+			/// No 64 bit compare in SSE2: both 32 bit halves must match.
+			inline reg eq( reg a, reg b, lane<8, false> )
+			{
+				reg halves = _mm_cmpeq_epi32( a, b );
+				return _mm_and_si128( halves, _mm_shuffle_epi32( halves, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+			}
+
+			inline reg gt( reg a, reg b, lane<1, false> ) { return _mm_cmpgt_epi8( a, b ); }
+			inline reg gt( reg a, reg b, lane<2, false> ) { return _mm_cmpgt_epi16( a, b ); }
+			inline reg gt( reg a, reg b, lane<4, false> ) { return _mm_cmpgt_epi32( a, b ); }
+
+			/// Picks a where m is set, b elsewhere.
+			inline reg select( reg m, reg a, reg b )
+			{ return _mm_or_si128( _mm_and_si128( m, a ), _mm_andnot_si128( m, b ) ); }
+
+			template< typename T >
+			size_t find( const T * p, size_t n, T value )
+			{
+				const size_t step = width / sizeof(T);
+				reg needle = broadcast( value );
+				size_t i{0u};
+				for( ; i + step <= n ; i += step )
+				{
+					unsigned m = mask( eq( load( p + i ), needle, lane_of<T>() ) );
+					if( m != 0 )
+						return i + __builtin_ctz( m ) / sizeof(T);
+				}
+				return i + scalar::find( p + i, n - i, value );
+			}
+
+			template< typename T >
+			size_t count( const T * p, size_t n, T value )
+			{
+				const size_t step = width / sizeof(T);
+				reg needle = broadcast( value );
+				size_t bits{0u}, i{0u};
+				for( ; i + step <= n ; i += step )
+					bits += __builtin_popcount( mask( eq( load( p + i ), needle, lane_of<T>() ) ) );
+				return bits / sizeof(T) + scalar::count( p + i, n - i, value );
+			}
+
+			template< typename T >
+			bool equal( const T * a, const T * b, size_t n )
+			{
+				const size_t step = width / sizeof(T);
+				size_t i{0u};
+				for( ; i + step <= n ; i += step )
+					if( mask( eq( load( a + i ), load( b + i ), lane_of<T>() ) ) != full )
+						return false;
+				return scalar::equal( a + i, b + i, n - i );
+			}
+
+			/// Smallest (Less) or largest element of p, n at least one register. The last load may
+			/// overlap the previous one: elements seen twice do not change a minimum.
+			template< bool Less, typename T >
+			T extreme( const T * p, size_t n, std::true_type )
+			{
+				const size_t step = width / sizeof(T);
+				reg bias = broadcast( sign_bit<T>() );
+				reg best = load( p );
+				for( size_t i{step} ; i < n ; i += step )
+				{
+					reg next = load( i + step <= n ? p + i : p + n - step );
+					reg over = gt( _mm_xor_si128( best, bias ), _mm_xor_si128( next, bias ), lane_of<T>() );
+					best = Less ? select( over, next, best ) : select( over, best, next );
+				}
+
+				T lanes[width / sizeof(T)];
+				std::memcpy( lanes, &best, width );
+				T result = lanes[0];
+				for( auto l : lanes )
+					if( Less ? l < result : result < l )
+						result = l;
+				return result;
+			}
+
+			/// Never called: min_index() and max_index() scan the other T one by one.
+			template< bool Less, typename T >
+			T extreme( const T * p, size_t, std::false_type )
+			{ return p[0]; }
+
+			/// Tells whether SSE2 orders the T: integers, but no 64 bit compare.
+			template< typename T >
+			using has_gt = std::integral_constant< bool, std::is_integral<T>::value and sizeof(T) != 8 >;
+
+			template< typename T >
+			size_t min_index( const T * p, size_t n )
+			{
+				if( n < width / sizeof(T) or not has_gt<T>::value )
+					return scalar::min_index( p, n );
+				return find( p, n, extreme<true>( p, n, has_gt<T>() ) );
+			}
+
+			template< typename T >
+			size_t max_index( const T * p, size_t n )
+			{
+				if( n < width / sizeof(T) or not has_gt<T>::value )
+					return scalar::max_index( p, n );
+				return find( p, n, extreme<false>( p, n, has_gt<T>() ) );
+			}
+
+		} // namespace sse2
+
+		/*! \namespace avx2
+			\brief 32 byte kernels, compiled for AVX2 whatever the flags of the build.
+
+			Only call them when has_avx2() is true.
+		*/
+		namespace avx2{
+
+#define SC_SIMD_AVX2 __attribute__(( target( "avx2,popcnt" ) ))
+
+			typedef __m256i reg; //!< A register of 32 bytes.
+			static constexpr size_t width = 32; //!< Bytes per register.
+
+			SC_SIMD_AVX2 inline reg load( const void * p )
+			{ return _mm256_loadu_si256( static_cast<const reg*>( p ) ); }
+
+			SC_SIMD_AVX2 inline unsigned mask( reg r )
+			{ return (unsigned) _mm256_movemask_epi8( r ); }
+
+			static constexpr unsigned full = 0xFFFFFFFF; //!< Mask of a register whose elements all matched.
+
+			template< typename T >
+			SC_SIMD_AVX2 reg broadcast( T value )
+			{
+				T lanes[width / sizeof(T)];
+				for( auto & l : lanes )
+					l = value;
+				return load( lanes );
+			}
+
+			SC_SIMD_AVX2 inline reg eq( reg a, reg b, lane<1, false> ) { return _mm256_cmpeq_epi8( a, b ); }
+			SC_SIMD_AVX2 inline reg eq( reg a, reg b, lane<2, false> ) { return _mm256_cmpeq_epi16( a, b ); }
+			SC_SIMD_AVX2 inline reg eq( reg a, reg b, lane<4, false> ) { return _mm256_cmpeq_epi32( a, b ); }
+			SC_SIMD_AVX2 inline reg eq( reg a, reg b, lane<8, false> ) { return _mm256_cmpeq_epi64( a, b ); }
+			SC_SIMD_AVX2 inline reg eq( reg a, reg b, lane<4, true> )
+			{ return _mm256_castps_si256( _mm256_cmp_ps( _mm256_castsi256_ps( a ), _mm256_castsi256_ps( b ), _CMP_EQ_OQ ) ); }
+			SC_SIMD_AVX2 inline reg eq( reg a, reg b, lane<8, true> )
+			{ return _mm256_castpd_si256( _mm256_cmp_pd( _mm256_castsi256_pd( a ), _mm256_castsi256_pd( b ), _CMP_EQ_OQ ) ); }
+
+			SC_SIMD_AVX2 inline reg gt( reg a, reg b, lane<1, false> ) { return _mm256_cmpgt_epi8( a, b ); }
+			SC_SIMD_AVX2 inline reg gt( reg a, reg b, lane<2, false> ) { return _mm256_cmpgt_epi16( a, b ); }
+			SC_SIMD_AVX2 inline reg gt( reg a, reg b, lane<4, false> ) { return _mm256_cmpgt_epi32( a, b ); }
+			SC_SIMD_AVX2 inline reg gt( reg a, reg b, lane<8, false> ) { return _mm256_cmpgt_epi64( a, b ); }
+
+			/// Picks a where m is set, b elsewhere.
+			SC_SIMD_AVX2 inline reg select( reg m, reg a, reg b )
+			{ return _mm256_blendv_epi8( b, a, m ); }
+
+			template< typename T >
+			SC_SIMD_AVX2 size_t find( const T * p, size_t n, T value )
+			{
+				const size_t step = width / sizeof(T);
+				reg needle = broadcast( value );
+				size_t i{0u};
+				for( ; i + step <= n ; i += step )
+				{
+					unsigned m = mask( eq( load( p + i ), needle, lane_of<T>() ) );
+					if( m != 0 )
+						return i + __builtin_ctz( m ) / sizeof(T);
+				}
+				return i + scalar::find( p + i, n - i, value );
+			}
+
+			template< typename T >
+			SC_SIMD_AVX2 size_t count( const T * p, size_t n, T value )
+			{
+				const size_t step = width / sizeof(T);
+				reg needle = broadcast( value );
+				size_t bits{0u}, i{0u};
+				for( ; i + step <= n ; i += step )
+					bits += __builtin_popcount( mask( eq( load( p + i ), needle, lane_of<T>() ) ) );
+				return bits / sizeof(T) + scalar::count( p + i, n - i, value );
+			}
+
+			template< typename T >
+			SC_SIMD_AVX2 bool equal( const T * a, const T * b, size_t n )
+			{
+				const size_t step = width / sizeof(T);
+				size_t i{0u};
+				for( ; i + step <= n ; i += step )
+					if( mask( eq( load( a + i ), load( b + i ), lane_of<T>() ) ) != full )
+						return false;
+				return scalar::equal( a + i, b + i, n - i );
+			}
+
+			/// Smallest (Less) or largest element of p, n at least one register. The last load may
+			/// overlap the previous one: elements seen twice do not change a minimum.
+			template< bool Less, typename T >
+			SC_SIMD_AVX2 T extreme( const T * p, size_t n, std::true_type )
+			{
+				const size_t step = width / sizeof(T);
+				reg bias = broadcast( sign_bit<T>() );
+				reg best = load( p );
+				for( size_t i{step} ; i < n ; i += step )
+				{
+					reg next = load( i + step <= n ? p + i : p + n - step );
+					reg over = gt( _mm256_xor_si256( best, bias ), _mm256_xor_si256( next, bias ), lane_of<T>() );
+					best = Less ? select( over, next, best ) : select( over, best, next );
+				}
+
+				T lanes[width / sizeof(T)];
+				std::memcpy( lanes, &best, width );
+				T result = lanes[0];
+				for( auto l : lanes )
+					if( Less ? l < result : result < l )
+						result = l;
+				return result;
+			}
+
+			/// Never called: min_index() and max_index() scan the other T one by one.
+			template< bool Less, typename T >
+			T extreme( const T * p, size_t, std::false_type )
+			{ return p[0]; }
+
+			/// Tells whether AVX2 orders the T: integers.
+			template< typename T >
+			using has_gt = std::integral_constant< bool, std::is_integral<T>::value >;
+
+			template< typename T >
+			SC_SIMD_AVX2 size_t min_index( const T * p, size_t n )
+			{
+				if( n < width / sizeof(T) or not has_gt<T>::value )
+					return scalar::min_index( p, n );
+				return find( p, n, extreme<true>( p, n, has_gt<T>() ) );
+			}
+
+			template< typename T >
+			SC_SIMD_AVX2 size_t max_index( const T * p, size_t n )
+			{
+				if( n < width / sizeof(T) or not has_gt<T>::value )
+					return scalar::max_index( p, n );
+				return find( p, n, extreme<false>( p, n, has_gt<T>() ) );
+			}
+
+#undef SC_SIMD_AVX2
+
+		} // namespace avx2
+
+		/// Tells whether the running CPU has AVX2. Checked once.
+		inline bool has_avx2( )
+		{
+			static const bool supported = ( __builtin_cpu_init(), __builtin_cpu_supports( "avx2" ) and __builtin_cpu_supports( "popcnt" ) );
+			return supported;
+		}
+
+		/// Tells whether the running CPU has the popcnt instruction. Checked once.
+		inline bool has_popcnt( )
+		{
+			static const bool supported = ( __builtin_cpu_init(), __builtin_cpu_supports( "popcnt" ) );
+			return supported;
+		}
+
+		/// scalar::popcount compiled for the popcnt instruction. Only call it when has_popcnt() is true.
+		__attribute__(( target( "popcnt" ) )) inline size_t popcount_hw( const uint64_t * p, size_t n )
+		{
+			size_t total{0u};
+			for( size_t i{0u} ; i < n ; ++i )
+				total += __builtin_popcountll( p[i] );
+			return total;
+		}
+
+		/// Returns how many bits are set in the n words of p: one popcnt per word when the CPU has it.
+		inline size_t popcount( const uint64_t * p, size_t n )
+		{ return has_popcnt() ? popcount_hw( p, n ) : scalar::popcount( p, n ); }
+
+		template< typename T >
+		size_t find( const T * p, size_t n, const T & value, std::true_type )
+		{ return has_avx2() ? avx2::find( p, n, value ) : sse2::find( p, n, value ); }
+
+		template< typename T >
+		size_t count( const T * p, size_t n, const T & value, std::true_type )
+		{ return has_avx2() ? avx2::count( p, n, value ) : sse2::count( p, n, value ); }
+
+		/// Integers are equal when their bytes are: memcmp is already vectorized by the C library.
+		template< typename T >
+		bool equal( const T * a, const T * b, size_t n, std::true_type )
+		{
+			if( std::is_integral<T>::value )
+				return n == 0 or std::memcmp( a, b, n * sizeof(T) ) == 0;
+			return has_avx2() ? avx2::equal( a, b, n ) : sse2::equal( a, b, n );
+		}
+
+		template< typename T >
+		size_t min_index( const T * p, size_t n, std::true_type )
+		{ return has_avx2() ? avx2::min_index( p, n ) : sse2::min_index( p, n ); }
+
+		template< typename T >
+		size_t max_index( const T * p, size_t n, std::true_type )
+		{ return has_avx2() ? avx2::max_index( p, n ) : sse2::max_index( p, n ); }
+#else
+		/// Tells whether the running CPU has AVX2: never, without the x86 kernels.
+		inline bool has_avx2( )
+		{ return false; }
+
+		/// Returns how many bits are set in the n words of p.
+		inline size_t popcount( const uint64_t * p, size_t n )
+		{ return scalar::popcount( p, n ); }
+
+		template< typename T >
+		size_t find( const T * p, size_t n, const T & value, std::true_type )
+		{ return scalar::find( p, n, value ); }
+
+		template< typename T >
+		size_t count( const T * p, size_t n, const T & value, std::true_type )
+		{ return scalar::count( p, n, value ); }
+
+		template< typename T >
+		bool equal( const T * a, const T * b, size_t n, std::true_type )
+		{ return scalar::equal( a, b, n ); }
+
+		template< typename T >
+		size_t min_index( const T * p, size_t n, std::true_type )
+		{ return scalar::min_index( p, n ); }
+
+		template< typename T >
+		size_t max_index( const T * p, size_t n, std::true_type )
+		{ return scalar::max_index( p, n ); }
+#endif
+
+		template< typename T >
+		size_t find( const T * p, size_t n, const T & value, std::false_type )
+		{ return scalar::find( p, n, value ); }
+
+		template< typename T >
+		size_t count( const T * p, size_t n, const T & value, std::false_type )
+		{ return scalar::count( p, n, value ); }
+
+		template< typename T >
+		bool equal( const T * a, const T * b, size_t n, std::false_type )
+		{ return scalar::equal( a, b, n ); }
+
+		template< typename T >
+		size_t min_index( const T * p, size_t n, std::false_type )
+		{ return scalar::min_index( p, n ); }
+
+		template< typename T >
+		size_t max_index( const T * p, size_t n, std::false_type )
+		{ return scalar::max_index( p, n ); }
+
+		//=== Entry points
+		/// Returns the index of the first of the n elements of p equal to value, or n.
+		template< typename T >
+		size_t find( const T * p, size_t n, const T & value )
+		{ return simd::find( p, n, value, is_vectorizable<T>() ); }
+
+		/// Returns how many of the n elements of p are equal to value.
+		template< typename T >
+		size_t count( const T * p, size_t n, const T & value )
+		{ return simd::count( p, n, value, is_vectorizable<T>() ); }
+
+		/// Tells whether the n elements of a and b are equal, one by one.
+		template< typename T >
+		bool equal( const T * a, const T * b, size_t n )
+		{ return simd::equal( a, b, n, is_vectorizable<T>() ); }
+
+		/// Returns the index of the first smallest of the n elements of p. n must not be 0.
+		template< typename T >
+		size_t min_index( const T * p, size_t n )
+		{ return simd::min_index( p, n, has_vector_min<T>() ); }
+
+		/// Returns the index of the first largest of the n elements of p. n must not be 0.
+		template< typename T >
+		size_t max_index( const T * p, size_t n )
+		{ return simd::max_index( p, n, has_vector_min<T>() ); }
+
+	} // namespace simd
+
+} // namespace sc
+
+#endif
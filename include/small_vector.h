@@ -0,0 +1,218 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "vector.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	/*! \class inline_allocator
+		\brief allocator that hands out a fixed inline buffer before going to the heap.
+
+		The buffer lives in the owning container: a request of at most N elements is served
+		from it while it is free, anything else is forwarded to Alloc.
+	*/
+	template< typename T, size_t N, typename Alloc = std::allocator<T> >
+	class inline_allocator{
+
+		private:
+			typedef std::allocator_traits<Alloc> heap_traits; //!< Interface of the heap allocator.
+
+		public:
+			//=== Alias
+			typedef T value_type; //!< Type of the elements.
+
+			/// The rebound allocator has no inline buffer and always uses the heap.
+			template< typename U >
+			struct rebind
+			{ typedef inline_allocator< U, N, typename heap_traits::template rebind_alloc<U> > other; };
+
+			//=== Constructors
+			/// Allocator serving from buffer, of N elements, before using heap.
+			explicit inline_allocator( T * buffer = nullptr, const Alloc & heap = Alloc() )
+				: m_buffer{buffer}, m_in_use{false}, m_heap(heap)
+			{/*empty*/}
+
+			/// Rebinding constructor. The inline buffer is not shared.
+			template< typename U, typename A >
+			inline_allocator( const inline_allocator<U, N, A> & other )
+				: m_buffer{nullptr}, m_in_use{false}, m_heap(other.heap())
+			{/*empty*/}
+
+		public:
+			//=== Methods
+			/// Returns storage for n elements: the inline buffer if it is free and large enough.
+			T * allocate( size_t n )
+			{
+				if( m_buffer != nullptr and not m_in_use and n <= N )
+				{
+					m_in_use = true;
+					return m_buffer;
+				}
+
+				return heap_traits::allocate( m_heap, n );
+			}
+
+			/// Gives back the storage p of n elements.
+			void deallocate( T * p, size_t n )
+			{
+				if( p == m_buffer )
+					m_in_use = false;
+				else
+					heap_traits::deallocate( m_heap, p, n );
+			}
+
+			/// Returns the allocator used beyond the inline buffer.
+			const Alloc & heap( ) const
+			{ return m_heap; }
+
+			/// Checks whether p is the inline buffer.
+			bool is_inline( const T * p ) const
+			{ return p == m_buffer; }
+
+			/// Storage from one allocator can be released by the other only if they share the buffer.
+			bool operator==( const inline_allocator & rhs ) const
+			{ return m_buffer == rhs.m_buffer and m_heap == rhs.m_heap; }
+
+			bool operator!=( const inline_allocator & rhs ) const
+			{ return not ( *this == rhs ); }
+
+		private:
+			T * m_buffer; //!< Inline buffer of N elements.
+			bool m_in_use; //!< Whether the buffer was handed out.
+			Alloc m_heap; //!< Allocator beyond the inline buffer.
+	}; // class inline_allocator
+
+
+	/*! \class small_vector
+		\brief sc::vector that keeps up to N elements inside the object.
+
+		It is an sc::vector, with the same API and iterators, whose storage starts as an inline
+		buffer of N elements. It spills to the heap only when more than N elements are needed,
+		so a small list never allocates.
+	*/
+	template< typename T, size_t N, typename Alloc = std::allocator<T>, typename Growth = growth::doubling >
+	class small_vector : public vector< T, inline_allocator<T, N, Alloc>, Growth >{
+
+		static_assert( N > 0, "small_vector needs an inline capacity" );
+		static_assert( not std::is_same<T, bool>::value, "sc::vector<bool> packs its flags into words: small_vector has no inline buffer for them" );
+
+		protected:
+			//=== Alias
+			typedef vector< T, inline_allocator<T, N, Alloc>, Growth > base; //!< Vector that holds the elements.
+			typedef typename base::size_type size_type; //!< Type of size.
+			typedef typename base::allocator_type allocator_type; //!< Allocator of the base vector.
+
+		public:
+			//=== Constructors
+			/// Default constructor. The capacity is the inline one, N.
+			small_vector( )
+				: base( allocator_type( reinterpret_cast<T*>( m_buffer ) ) )
+			{ this->reserve( N ); }
+
+			/// Empty vector that spills to the heap through alloc.
+			explicit small_vector( const Alloc & alloc )
+				: base( allocator_type( reinterpret_cast<T*>( m_buffer ), alloc ) )
+			{ this->reserve( N ); }
+
+			/// Constructor with a defined capacity, at least N. No element is constructed.
+			explicit small_vector( size_type count, const Alloc & alloc = Alloc() )
+				: base( allocator_type( reinterpret_cast<T*>( m_buffer ), alloc ) )
+			{ this->reserve( count > N ? count : N ); }
+
+			/// Constructor with elements in [first, last) range.
+			template< typename InputIt >
+			small_vector( InputIt first, InputIt last, const Alloc & alloc = Alloc() )
+				: small_vector( alloc )
+			{ this->assign( first, last ); }
+
+			/// Copy constructor.
+			small_vector( const small_vector & other )
+				: small_vector( other.m_alloc.heap() )
+			{ this->assign_range( other.arr, other.m_size ); }
+
+			/// Move constructor. Steals a heap storage, moves the elements of an inline one into the buffer.
+			small_vector( small_vector && other )
+				noexcept( std::is_nothrow_move_constructible<T>::value )
+				: small_vector( other.m_alloc.heap() )
+			{ take( other ); }
+
+			/// std::initializer_list copy constructor.
+			small_vector( std::initializer_list<T> ilist, const Alloc & alloc = Alloc() )
+				: small_vector( alloc )
+			{ this->assign( ilist ); }
+
+		public:
+			//=== Operators overload
+			/// Operator= overload for vectors.
+			small_vector & operator=( const small_vector & other )
+			{
+				if( this != &other )
+					this->assign_range( other.arr, other.m_size );
+
+				return *this;
+			}
+
+			/// Move assignment. Steals a heap storage, moves the elements of an inline one.
+			/// A stateful Alloc may differ from that of other, whose elements then need a new storage.
+			small_vector & operator=( small_vector && other )
+				noexcept( std::is_nothrow_move_constructible<T>::value and std::is_nothrow_move_assignable<T>::value
+					and std::is_empty<Alloc>::value )
+			{
+				if( this != &other )
+					take( other );
+
+				return *this;
+			}
+
+			/// Operator= overload for initializer_list.
+			small_vector & operator=( std::initializer_list<T> ilist )
+			{
+				this->assign( ilist );
+				return *this;
+			}
+
+		public:
+			//=== Methods
+			/// Checks whether the elements are stored in the inline buffer.
+			bool is_inline( ) const
+			{ return this->m_alloc.is_inline( this->arr - this->m_front ); }
+
+			/// Desaloc unused storage. A list that fits the inline buffer goes back to it.
+			void shrink_to_fit( )
+			{
+				if( is_inline() )
+					return;
+
+				if( this->m_size <= N )
+					this->reallocate( N );
+				else
+					base::shrink_to_fit();
+			}
+
+		protected:
+			/// Takes the elements of other, leaving it empty.
+			void take( small_vector & other )
+			{
+				if( other.is_inline() or other.m_alloc.heap() != this->m_alloc.heap() )
+				{
+					this->assign_range( std::make_move_iterator( other.arr ), other.m_size );
+					other.clear();
+					return;
+				}
+
+				// The heap storage changes hands, then other falls back to its buffer.
+				this->release();
+				this->steal( other );
+				other.reserve( N );
+			}
+
+		protected:
+			typename std::aligned_storage< sizeof(T), alignof(T) >::type m_buffer[N]; //!< Inline storage.
+	}; // class small_vector
+
+} // namespace sc
+
+#endif
\ No newline at end of file
@@ -0,0 +1,690 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "growth.h"
+
+/*! \namespace sc
+    \brief namespace to differ from std
+*/
+namespace sc{
+
+	//=== Index packs (std::index_sequence is C++14)
+	template< size_t... Is >
+	struct soa_indices
+	{/*empty*/};
+
+	template< size_t N, size_t... Is >
+	struct make_soa_indices : make_soa_indices< N - 1, N - 1, Is... >
+	{/*empty*/};
+
+	template< size_t... Is >
+	struct make_soa_indices< 0, Is... >
+	{ typedef soa_indices<Is...> type; };
+
+	/*! \struct column_view
+		\brief the contiguous array of one field of a soa_vector.
+
+		It is invalidated, as the pointers into the list, when the list reallocates.
+	*/
+	template< typename T >
+	struct column_view
+	{
+		T * first; //!< First element.
+		size_t count; //!< Number of elements.
+
+		T * begin( ) const
+		{ return first; }
+
+		T * end( ) const
+		{ return first + count; }
+
+		T & operator[]( size_t pos ) const
+		{ return first[pos]; }
+
+		size_t size( ) const
+		{ return count; }
+
+		T * data( ) const
+		{ return first; }
+	};
+
+	/*! \class basic_soa_vector
+		\brief list of records of fields Ts..., stored as one array per field.
+
+		A loop over one field walks one dense array instead of skipping over the other fields of
+		each record, so every byte loaded into the cache is used. The arrays share one size and one
+		capacity, grown by the Growth policy as the vector grows (the element size it is given is
+		that of a whole record).
+
+		push_back() takes a std::tuple of the fields and emplace_back() one value per field.
+		operator[] and the iterators give proxies, std::tuple<Ts&...>, whose fields refer into the
+		arrays; column<I>() gives the array of field I, get<I>( pos ) one of its elements.
+
+		Growth relocates the fields whose move may throw first, by copy, and moves the others
+		afterwards: a throwing copy leaves the list as it was. A field that cannot be copied is
+		moved even if its move may throw; such a move that throws leaves the records valid, but
+		those of that field and of the fields moved before it may have been moved from. Appending
+		a record whose field throws destroys the fields already built.
+	*/
+	template< typename Growth, typename... Ts >
+	class basic_soa_vector{
+
+		static_assert( sizeof...(Ts) != 0, "a soa_vector has at least one field" );
+
+		public:
+			//=== Alias
+			typedef size_t size_type; //!< Type of size.
+			typedef std::tuple<Ts...> value_type; //!< A record, by value.
+			typedef std::tuple<Ts&...> reference; //!< A record, as references to its fields.
+			typedef std::tuple<const Ts&...> const_reference; //!< A record, as const references to its fields.
+			typedef Growth growth_policy; //!< Growth policy of the arrays.
+
+			template< typename V, typename R >
+			class basic_iterator;
+			typedef basic_iterator< basic_soa_vector, reference > iterator; //!< Random access proxy iterator.
+			typedef basic_iterator< const basic_soa_vector, const_reference > const_iterator; //!< Random access proxy iterator to const records.
+
+			/// Type of field I.
+			template< size_t I >
+			using field_type = typename std::tuple_element< I, value_type >::type;
+
+			static constexpr size_t fields = sizeof...(Ts); //!< Number of fields.
+
+		protected:
+			typedef std::tuple<Ts*...> columns; //!< One array per field.
+			typedef typename make_soa_indices<sizeof...(Ts)>::type all_fields; //!< 0, 1, ..., fields - 1.
+
+			/// Tag of field I, to recurse over the fields.
+			template< size_t I >
+			using field = std::integral_constant<size_t, I>;
+			typedef field<sizeof...(Ts)> past_fields; //!< Tag that ends the recursions.
+
+			/// Whether growth moves a field of type T: its move cannot throw, or it cannot be copied.
+			template< typename T >
+			struct relocated_by_move
+				: std::integral_constant< bool, std::is_nothrow_move_constructible<T>::value or not std::is_copy_constructible<T>::value >
+			{/*empty*/};
+
+		public:
+			//=== Constructors
+			/// Empty list. Allocates nothing.
+			basic_soa_vector( )
+				: m_columns{}, m_size{0}, m_capacity{0}
+			{/*empty*/}
+
+			/// Copy constructor.
+			basic_soa_vector( const basic_soa_vector & other )
+				: m_columns{}, m_size{0}, m_capacity{0}
+			{
+				columns fresh = allocate( other.m_size );
+				try { copy_fields( fresh, other, field<0>() ); }
+				catch( ... ) { deallocate( fresh, other.m_size ); throw; }
+				m_columns = fresh;
+				m_size = m_capacity = other.m_size;
+			}
+
+			/// Move constructor. Steals the arrays of other, leaving it empty.
+			basic_soa_vector( basic_soa_vector && other ) noexcept
+				: m_columns{other.m_columns}, m_size{other.m_size}, m_capacity{other.m_capacity}
+			{
+				other.m_columns = columns{};
+				other.m_size = other.m_capacity = 0;
+			}
+
+			/// List of the records of ilist.
+			basic_soa_vector( std::initializer_list<value_type> ilist )
+				: basic_soa_vector()
+			{
+				reserve( ilist.size() );
+				for( const auto & record : ilist )
+					push_back( record );
+			}
+
+			/// Destructor.
+			~basic_soa_vector( )
+			{
+				destroy( 0, m_size, field<0>() );
+				deallocate( m_columns, m_capacity );
+			}
+
+			/// Copy and move assignment.
+			basic_soa_vector & operator=( basic_soa_vector other )
+			{
+				swap( other );
+				return *this;
+			}
+
+		public:
+			//=== Methods
+			/// Returns the number of records.
+			size_type size( ) const
+			{ return m_size; }
+
+			/// Returns how many records fit without reallocation.
+			size_type capacity( ) const
+			{ return m_capacity; }
+
+			/// Checks whether the list has no record.
+			bool empty( ) const
+			{ return m_size == 0; }
+
+			/// Returns the record at index pos.
+			reference operator[]( size_type pos )
+			{ return record( pos, all_fields() ); }
+
+			const_reference operator[]( size_type pos ) const
+			{ return const_record( pos, all_fields() ); }
+
+			/// Returns the record at index pos. Throws std::out_of_range if pos is not below size().
+			reference at( size_type pos )
+			{
+				if( pos >= m_size )
+					throw std::out_of_range("error in at(): out of range");
+				return (*this)[pos];
+			}
+
+			const_reference at( size_type pos ) const
+			{
+				if( pos >= m_size )
+					throw std::out_of_range("error in at(): out of range");
+				return (*this)[pos];
+			}
+
+			/// Return the first record.
+			reference front( )
+			{ return (*this)[0]; }
+
+			const_reference front( ) const
+			{ return (*this)[0]; }
+
+			/// Return the last record.
+			reference back( )
+			{ return (*this)[m_size - 1]; }
+
+			const_reference back( ) const
+			{ return (*this)[m_size - 1]; }
+
+			/// Returns field I of the record at index pos.
+			template< size_t I >
+			field_type<I> & get( size_type pos )
+			{ return std::get<I>( m_columns )[pos]; }
+
+			template< size_t I >
+			const field_type<I> & get( size_type pos ) const
+			{ return std::get<I>( m_columns )[pos]; }
+
+			/// Returns the array of field I.
+			template< size_t I >
+			column_view< field_type<I> > column( )
+			{ return column_view< field_type<I> >{ std::get<I>( m_columns ), m_size }; }
+
+			template< size_t I >
+			column_view< const field_type<I> > column( ) const
+			{ return column_view< const field_type<I> >{ std::get<I>( m_columns ), m_size }; }
+
+			iterator begin( )
+			{ return iterator( this, 0 ); }
+
+			iterator end( )
+			{ return iterator( this, m_size ); }
+
+			const_iterator begin( ) const
+			{ return const_iterator( this, 0 ); }
+
+			const_iterator end( ) const
+			{ return const_iterator( this, m_size ); }
+
+			const_iterator cbegin( ) const
+			{ return begin(); }
+
+			const_iterator cend( ) const
+			{ return end(); }
+
+			/// Appends a copy of record.
+			void push_back( const value_type & record )
+			{ append( std::tuple<const Ts&...>( record ) ); }
+
+			/// Appends record, its fields moved.
+			void push_back( value_type && record )
+			{ append( move_fields( record, all_fields() ) ); }
+
+			/// Appends a record whose fields are built from values, one per field.
+			template< typename... Args >
+			void emplace_back( Args&&... values )
+			{
+				static_assert( sizeof...(Args) == sizeof...(Ts), "emplace_back() takes one value per field" );
+				append( std::forward_as_tuple( std::forward<Args>( values )... ) );
+			}
+
+			/// Removes the last record.
+			void pop_back( )
+			{
+				destroy( m_size - 1, m_size, field<0>() );
+				--m_size;
+			}
+
+			/// Removes every record. The capacity is kept.
+			void clear( )
+			{
+				destroy( 0, m_size, field<0>() );
+				m_size = 0;
+			}
+
+			/// Resizes the list to count records. New fields are value-initialized.
+			void resize( size_type count )
+			{ resize( count, value_type() ); }
+
+			/// Resizes the list to count records. New records are copies of record.
+			void resize( size_type count, const value_type & record )
+			{
+				if( count <= m_size )
+				{
+					destroy( count, m_size, field<0>() );
+					m_size = count;
+					return;
+				}
+
+				value_type copy( record ); // record may be in the list, which growth moves.
+				if( count > m_capacity )
+					reallocate( grow( count ) );
+				while( m_size < count )
+					push_back( copy );
+			}
+
+			/// Reallocates the arrays to hold new_cap records.
+			void reserve( size_type new_cap )
+			{
+				if( new_cap > m_capacity )
+					reallocate( new_cap );
+			}
+
+			/// Reallocates the arrays to hold only the records.
+			void shrink_to_fit( )
+			{
+				if( m_size < m_capacity )
+					reallocate( m_size );
+			}
+
+			/// Exchanges the contents of the two lists.
+			void swap( basic_soa_vector & other ) noexcept
+			{
+				std::swap( m_columns, other.m_columns );
+				std::swap( m_size, other.m_size );
+				std::swap( m_capacity, other.m_capacity );
+			}
+
+		protected:
+			//=== Records
+			template< size_t... Is >
+			reference record( size_type pos, soa_indices<Is...> )
+			{ return reference( std::get<Is>( m_columns )[pos]... ); }
+
+			template< size_t... Is >
+			const_reference const_record( size_type pos, soa_indices<Is...> ) const
+			{ return const_reference( std::get<Is>( m_columns )[pos]... ); }
+
+			/// Returns rvalue references to the fields of record.
+			template< size_t... Is >
+			static std::tuple<Ts&&...> move_fields( value_type & record, soa_indices<Is...> )
+			{ return std::tuple<Ts&&...>( std::move( std::get<Is>( record ) )... ); }
+
+			/// Appends the record whose fields are built from the references in args.
+			template< typename Args >
+			void append( Args && args )
+			{
+				if( m_size == m_capacity )
+				{
+					// args may refer into the list, which growth moves: the record is built in the new arrays first.
+					size_type new_cap = grow( m_size + 1 );
+					columns fresh = allocate( new_cap );
+					try
+					{
+						construct( fresh, m_size, args, field<0>() );
+						adopt( fresh, new_cap, 1 ); // Destroys the new record if it throws.
+					}
+					catch( ... ) { deallocate( fresh, new_cap ); throw; }
+				}
+				else
+					construct( m_columns, m_size, args, field<0>() );
+
+				++m_size;
+			}
+
+			//=== Fields, from field I on
+			/// Builds field I on of the record at pos in cols from the references in args.
+			template< typename Args, size_t I >
+			static void construct( const columns & cols, size_type pos, Args & args, field<I> )
+			{
+				typedef typename std::tuple_element< I, typename std::decay<Args>::type >::type arg_type;
+				auto * slot = std::get<I>( cols ) + pos;
+				::new( static_cast<void*>( slot ) ) field_type<I>( std::forward<arg_type>( std::get<I>( args ) ) );
+
+				try { construct( cols, pos, args, field<I + 1>() ); }
+				catch( ... ) { destroy_at( slot ); throw; }
+			}
+
+			template< typename Args >
+			static void construct( const columns &, size_type, Args &, past_fields )
+			{/*empty*/}
+
+			/// Copy-constructs field I on of the records of other into cols.
+			template< size_t I >
+			void copy_fields( const columns & cols, const basic_soa_vector & other, field<I> )
+			{
+				copy_column( std::get<I>( other.m_columns ), other.m_size, std::get<I>( cols ) );
+				try { copy_fields( cols, other, field<I + 1>() ); }
+				catch( ... ) { destroy_range( std::get<I>( cols ), 0, other.m_size ); throw; }
+			}
+
+			void copy_fields( const columns &, const basic_soa_vector &, past_fields )
+			{/*empty*/}
+
+			/// Destroys field I on of the records [first, last).
+			template< size_t I >
+			void destroy( size_type first, size_type last, field<I> )
+			{
+				destroy_range( std::get<I>( m_columns ), first, last );
+				destroy( first, last, field<I + 1>() );
+			}
+
+			void destroy( size_type, size_type, past_fields )
+			{/*empty*/}
+
+			//=== Storage
+			/// Returns the capacity after growing to hold at least required records.
+			size_type grow( size_type required ) const
+			{
+				size_type capacity = Growth::grow( m_capacity, required, record_size() );
+				return capacity < required ? required : capacity;
+			}
+
+			/// Returns the bytes of a record, over all the arrays.
+			static constexpr size_t record_size( )
+			{ return sum_sizes( field<0>() ); }
+
+			template< size_t I >
+			static constexpr size_t sum_sizes( field<I> )
+			{ return sizeof( field_type<I> ) + sum_sizes( field<I + 1>() ); }
+
+			static constexpr size_t sum_sizes( past_fields )
+			{ return 0; }
+
+			/// Returns arrays for count records, each allocated apart.
+			static columns allocate( size_type count )
+			{
+				columns cols{};
+				if( count != 0 )
+					allocate_fields( cols, count, field<0>() );
+				return cols;
+			}
+
+			template< size_t I >
+			static void allocate_fields( columns & cols, size_type count, field<I> )
+			{
+				std::allocator< field_type<I> > alloc;
+				std::get<I>( cols ) = alloc.allocate( count );
+				try { allocate_fields( cols, count, field<I + 1>() ); }
+				catch( ... ) { alloc.deallocate( std::get<I>( cols ), count ); throw; }
+			}
+
+			static void allocate_fields( columns &, size_type, past_fields )
+			{/*empty*/}
+
+			/// Gives back the arrays cols of count records. Their elements are destroyed already.
+			static void deallocate( const columns & cols, size_type count )
+			{
+				if( count != 0 )
+					deallocate_fields( cols, count, field<0>() );
+			}
+
+			template< size_t I >
+			static void deallocate_fields( const columns & cols, size_type count, field<I> )
+			{
+				std::allocator< field_type<I> >().deallocate( std::get<I>( cols ), count );
+				deallocate_fields( cols, count, field<I + 1>() );
+			}
+
+			static void deallocate_fields( const columns &, size_type, past_fields )
+			{/*empty*/}
+
+			/// Moves the records to arrays of new_cap records.
+			void reallocate( size_type new_cap )
+			{
+				columns fresh = allocate( new_cap );
+				try { adopt( fresh, new_cap, 0 ); }
+				catch( ... ) { deallocate( fresh, new_cap ); throw; }
+			}
+
+			/// Relocates the records into fresh, of new_cap records, and makes it the storage.
+			/// built records past the current ones are in fresh already and destroyed if a relocation throws.
+			void adopt( const columns & fresh, size_type new_cap, size_type built )
+			{
+				try
+				{
+					// Copies first, which may throw and leave the list untouched.
+					relocate( fresh, std::false_type(), field<0>() );
+				}
+				catch( ... )
+				{
+					destroy_fields_of( fresh, m_size, m_size + built, field<0>() );
+					throw;
+				}
+
+				try
+				{
+					// Then the moves, which throw only for fields that cannot be copied.
+					relocate( fresh, std::true_type(), field<0>() );
+				}
+				catch( ... )
+				{
+					destroy_relocated( fresh, std::false_type(), field<0>() );
+					destroy_fields_of( fresh, m_size, m_size + built, field<0>() );
+					throw;
+				}
+
+				destroy( 0, m_size, field<0>() );
+				deallocate( m_columns, m_capacity );
+				m_columns = fresh;
+				m_capacity = new_cap;
+			}
+
+			/// Relocates field I on into fresh: those moved without throwing if Moves, the others if not.
+			template< bool Moves, size_t I >
+			void relocate( const columns & fresh, std::integral_constant<bool, Moves> moves, field<I> )
+			{
+				typedef field_type<I> type;
+				const bool moved = relocated_by_move<type>::value;
+				if( moved == Moves )
+				{
+					type * source = std::get<I>( m_columns );
+					type * dest = std::get<I>( fresh );
+					size_type i{0u};
+					try
+					{
+						for( ; i < m_size ; ++i )
+							::new( static_cast<void*>( dest + i ) ) type( std::move_if_noexcept( source[i] ) );
+					}
+					catch( ... ) { destroy_range( dest, 0, i ); throw; }
+				}
+
+				try { relocate( fresh, moves, field<I + 1>() ); }
+				catch( ... )
+				{
+					if( moved == Moves )
+						destroy_range( std::get<I>( fresh ), 0, m_size );
+					throw;
+				}
+			}
+
+			template< bool Moves >
+			void relocate( const columns &, std::integral_constant<bool, Moves>, past_fields )
+			{/*empty*/}
+
+			/// Destroys the current records of field I on in fresh: those moved if Moves, the copied ones if not.
+			template< bool Moves, size_t I >
+			void destroy_relocated( const columns & fresh, std::integral_constant<bool, Moves> moves, field<I> )
+			{
+				if( relocated_by_move< field_type<I> >::value == Moves )
+					destroy_range( std::get<I>( fresh ), 0, m_size );
+				destroy_relocated( fresh, moves, field<I + 1>() );
+			}
+
+			template< bool Moves >
+			void destroy_relocated( const columns &, std::integral_constant<bool, Moves>, past_fields )
+			{/*empty*/}
+
+			/// Destroys field I on of the records [first, last) of cols.
+			template< size_t I >
+			static void destroy_fields_of( const columns & cols, size_type first, size_type last, field<I> )
+			{
+				destroy_range( std::get<I>( cols ), first, last );
+				destroy_fields_of( cols, first, last, field<I + 1>() );
+			}
+
+			static void destroy_fields_of( const columns &, size_type, size_type, past_fields )
+			{/*empty*/}
+
+			//=== Arrays of one field
+			template< typename T >
+			static void destroy_at( T * p )
+			{ p->~T(); }
+
+			template< typename T >
+			static void destroy_range( T * column, size_type first, size_type last )
+			{
+				for( size_type i{first} ; i < last ; ++i )
+					column[i].~T();
+			}
+
+			/// Copy-constructs count elements of source into the raw array dest.
+			template< typename T >
+			static void copy_column( const T * source, size_type count, T * dest )
+			{
+				size_type i{0u};
+				try
+				{
+					for( ; i < count ; ++i )
+						::new( static_cast<void*>( dest + i ) ) T( source[i] );
+				}
+				catch( ... ) { destroy_range( dest, 0, i ); throw; }
+			}
+
+		protected:
+			columns m_columns; //!< One array per field.
+			size_type m_size; //!< Number of records.
+			size_type m_capacity; //!< Records that fit in each array.
+
+		public:
+		/*! \class basic_iterator
+			\brief random access iterator over the records of a soa_vector.
+
+			Dereferencing gives a proxy, a tuple of references to the fields, not a reference to a
+			stored record: algorithms that hold elements by value or swap them through a temporary
+			of value_type do not work with it.
+		*/
+		template< typename V, typename R >
+		class basic_iterator{
+			public:
+				//=== Alias
+				typedef std::ptrdiff_t difference_type; //!< Distance between two iterators.
+				typedef typename basic_soa_vector::value_type value_type; //!< A record, by value.
+				typedef void pointer; //!< No pointer to a proxy.
+				typedef R reference; //!< Proxy to the record.
+				typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
+
+				//=== Constructor
+				basic_iterator( V * list = nullptr, size_type index = 0 )
+					: m_list{list}, m_index{index}
+				{/*empty*/}
+
+				/// An iterator converts to a const_iterator.
+				template< typename W, typename S, typename = typename std::enable_if<
+					std::is_convertible<W*, V*>::value >::type >
+				basic_iterator( const basic_iterator<W, S> & other )
+					: m_list{other.m_list}, m_index{other.m_index}
+				{/*empty*/}
+
+				//=== Operators
+				reference operator*( ) const
+				{ return (*m_list)[m_index]; }
+
+				reference operator[]( difference_type n ) const
+				{ return (*m_list)[m_index + n]; }
+
+				basic_iterator & operator++( )
+				{ ++m_index; return *this; }
+
+				basic_iterator operator++( int )
+				{ basic_iterator old( *this ); ++m_index; return old; }
+
+				basic_iterator & operator--( )
+				{ --m_index; return *this; }
+
+				basic_iterator operator--( int )
+				{ basic_iterator old( *this ); --m_index; return old; }
+
+				basic_iterator & operator+=( difference_type n )
+				{ m_index += n; return *this; }
+
+				basic_iterator & operator-=( difference_type n )
+				{ m_index -= n; return *this; }
+
+				basic_iterator operator+( difference_type n ) const
+				{ return basic_iterator( m_list, m_index + n ); }
+
+				basic_iterator operator-( difference_type n ) const
+				{ return basic_iterator( m_list, m_index - n ); }
+
+				difference_type operator-( const basic_iterator & rhs ) const
+				{ return (difference_type) m_index - (difference_type) rhs.m_index; }
+
+				bool operator==( const basic_iterator & rhs ) const
+				{ return m_index == rhs.m_index; }
+
+				bool operator!=( const basic_iterator & rhs ) const
+				{ return m_index != rhs.m_index; }
+
+				bool operator<( const basic_iterator & rhs ) const
+				{ return m_index < rhs.m_index; }
+
+				bool operator>( const basic_iterator & rhs ) const
+				{ return m_index > rhs.m_index; }
+
+				bool operator<=( const basic_iterator & rhs ) const
+				{ return m_index <= rhs.m_index; }
+
+				bool operator>=( const basic_iterator & rhs ) const
+				{ return m_index >= rhs.m_index; }
+
+			private:
+				template< typename, typename > friend class basic_iterator;
+
+				V * m_list; //!< Iterated list.
+				size_type m_index; //!< Index of the pointed record.
+		};
+	};
+
+	template< typename Growth, typename... Ts >
+	constexpr size_t basic_soa_vector<Growth, Ts...>::fields;
+
+	/// Structure-of-arrays list of records of fields Ts..., growing by doubling.
+	template< typename... Ts >
+	using soa_vector = basic_soa_vector< growth::doubling, Ts... >;
+
+	/// Exchanges the contents of the two lists.
+	template< typename Growth, typename... Ts >
+	void swap( basic_soa_vector<Growth, Ts...> & lhs, basic_soa_vector<Growth, Ts...> & rhs ) noexcept
+	{ lhs.swap( rhs ); }
+
+} // namespace sc
+
+#endif
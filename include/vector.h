@@ -3,100 +3,186 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include "growth.h"
+#include "simd.h"
+
+#ifdef SC_VECTOR_INSTRUMENT
+#include "instrument.h"
+#endif
 
 /*! \namespace sc
     \brief namespace to differ from std
 */
 namespace sc{
-	
+
+	/*! \struct is_trivially_relocatable
+		\brief tells whether a T may be moved to new storage with a raw memory copy.
+
+		A relocated object is never destroyed at its old address. Holds for every trivially
+		copyable type; specialize it to std::true_type for types like a unique owning pointer.
+	*/
+	template< typename T >
+	struct is_trivially_relocatable
+		: std::integral_constant< bool, std::is_trivially_copyable<T>::value >
+	{/*empty*/};
+
 	/*! \class Vector
     	\brief means like std::vector
 
     	With this class we try to implement our own vector.
+
+    	Storage is obtained uninitialized from Alloc and elements are built in place,
+    	so only the live range [0, size()) is ever constructed or destroyed.
+    	Growth decides the capacity to reallocate to when the storage is full (see growth.h).
+
+    	Defining SC_VECTOR_INSTRUMENT before including this header, in every translation unit of
+    	the program, makes each vector count its allocations and relocations (see instrument.h).
 	*/
-	template< typename T >
+	template< typename T, typename Alloc = std::allocator<T>, typename Growth = growth::doubling >
 	class vector{
 
 		protected:
 			//=== Alias
 			typedef size_t size_type; //!< Type of size.
+			typedef std::allocator_traits<Alloc> alloc_traits; //!< Allocator interface.
 			static constexpr size_type initial_capacity=0; //!< Default value is 0.
 			static constexpr size_type initial_size=0; //!< Default value is 0.
+			typedef std::integral_constant< bool, is_trivially_relocatable<T>::value > trivial_relocation; //!< Moves are raw memory copies.
+			typedef std::integral_constant< bool, not trivial_relocation::value and not std::is_nothrow_move_constructible<T>::value
+				and std::is_copy_constructible<T>::value > relocates_by_copy; //!< Relocation copies: the move may throw.
+
+			/// Tells whether copying from It is a raw memory copy: It points to trivially copyable T.
+			template< typename It >
+			struct is_raw_copy
+				: std::integral_constant< bool, std::is_trivially_copyable<T>::value and std::is_pointer<It>::value
+					and std::is_same< typename std::remove_cv< typename std::remove_pointer<It>::type >::type, T >::value >
+			{/*empty*/};
 
 		public:
 			class my_iterator;
+			class my_const_iterator;
+			typedef T value_type; //!< Type of the elements.
+			typedef T & reference; //!< What operator[] returns; a proxy for sc::vector<bool>.
+			typedef const T & const_reference; //!< What the const operator[] returns.
+			typedef Alloc allocator_type; //!< Type of the allocator.
+			typedef Growth growth_policy; //!< Growth policy of the storage.
+			typedef my_iterator iterator; //!< Random access iterator.
+			typedef my_const_iterator const_iterator; //!< Random access iterator to const elements.
 
 			//=== Constructors
-			/// Default constructor
+			/// Default constructor. Allocates nothing.
 			vector( )
-				: m_capacity{initial_capacity}, m_size{initial_size}, arr{new T[initial_capacity]}
+				: m_capacity{initial_capacity}, m_size{initial_size}, arr{nullptr}, m_front{0}, m_alloc()
 			{/*empty*/}
 
-			/// Constructor with a defined size
-			explicit vector( size_type count )
-				: m_capacity{count}, m_size{initial_size}, arr{new T[count]}
+			/// Empty vector that will draw its storage from alloc.
+			explicit vector( const Alloc & alloc )
+				: m_capacity{initial_capacity}, m_size{initial_size}, arr{nullptr}, m_front{0}, m_alloc(alloc)
 			{/*empty*/}
 
+			/// Constructor with a defined capacity. No element is constructed.
+			explicit vector( size_type count, const Alloc & alloc = Alloc() )
+				: m_capacity{count}, m_size{initial_size}, arr{nullptr}, m_front{0}, m_alloc(alloc)
+			{
+				arr = allocate( m_capacity );
+				note_peaks();
+			}
+
 			/// Constructor with elements in [first, last) range.
 			template< typename InputIt >
-			vector( InputIt first, InputIt last )
-				: m_capacity{(size_type)(last - first)}, m_size{(size_type)(last - first)}, arr{new T[m_capacity]}
+			vector( InputIt first, InputIt last, const Alloc & alloc = Alloc() )
+				: m_capacity{(size_type)(last - first)}, m_size{initial_size}, arr{nullptr}, m_front{0}, m_alloc(alloc)
 			{
-				size_type count{0};
-				while(first != last)
-					arr[count++] = *(first++);
+				arr = allocate( m_capacity );
+				try { construct_copies( first, m_capacity, arr ); }
+				catch( ... ) { deallocate( arr, m_capacity ); throw; }
+				m_size = m_capacity;
+				note_peaks();
 			}
 
 			/// Copy constructor.
 			vector( const vector& other )
-				: m_capacity{other.capacity()}, m_size{other.size()}, arr{new T[m_capacity]}
+				: m_capacity{other.capacity()}, m_size{initial_size}, arr{nullptr}, m_front{0},
+				  m_alloc(alloc_traits::select_on_container_copy_construction( other.m_alloc ))
 			{
-				for( size_type i{0u} ; i < m_size ; i++ )
-					arr[i] = other.arr[i];
+				arr = allocate( m_capacity );
+				try { construct_copies( other.arr, other.m_size, arr ); }
+				catch( ... ) { deallocate( arr, m_capacity ); throw; }
+				m_size = other.m_size;
+				note_peaks();
+			}
+
+			/// Move constructor. Steals the storage of other, leaving it empty.
+			vector( vector&& other ) noexcept
+				: m_capacity{other.m_capacity}, m_size{other.m_size}, arr{other.arr}, m_front{other.m_front},
+				  m_alloc(std::move( other.m_alloc ))
+			{
+				other.m_capacity = initial_capacity;
+				other.m_size = initial_size;
+				other.arr = nullptr;
+				other.m_front = 0;
+				note_peaks();
 			}
 
 			/// std::initializer_list copy constructor.
-			vector( std::initializer_list<T> ilist )
-				: m_capacity{ilist.size()}, m_size{ilist.size()}, arr{new T[m_capacity]}
+			vector( std::initializer_list<T> ilist, const Alloc & alloc = Alloc() )
+				: m_capacity{ilist.size()}, m_size{initial_size}, arr{nullptr}, m_front{0}, m_alloc(alloc)
 			{
-				size_type count{0};
-				for( const T& e : ilist )
-					arr[count++] = e;
+				arr = allocate( m_capacity );
+				try { construct_copies( ilist.begin(), m_capacity, arr ); }
+				catch( ... ) { deallocate( arr, m_capacity ); throw; }
+				m_size = m_capacity;
+				note_peaks();
 			}
 
 			/// Destructor.
 			~vector( )
 			{
-				delete arr;
+				release();
 			}
 
 			//=== Iterators
 			/// Returns an iterator pointing to the first item in the list
 			my_iterator begin()
 			{
-				my_iterator iter(&arr[0]);
+				my_iterator iter(arr);
 				return iter;
 			}
 
-			/// Returns a constant iterator pointing to the first item in the list.
+			/// Returns an iterator pointing to the position just after the last element of the list.
 			my_iterator end()
 			{
-				my_iterator iter(&arr[m_size]);
+				my_iterator iter(arr + m_size);
 				return iter;
 			}
 
-			/// Returns an iterator pointing to the position just after the last element of the list.
-			my_iterator cbegin() const
+			/// Returns a constant iterator pointing to the first item of a constant list.
+			my_const_iterator begin() const
+			{ return cbegin(); }
+
+			/// Returns a constant iterator pointing to the position just after the last element of a constant list.
+			my_const_iterator end() const
+			{ return cend(); }
+
+			/// Returns a constant iterator pointing to the first item in the list.
+			my_const_iterator cbegin() const
 			{
-				my_const_iterator iter(&arr[0]);	
+				my_const_iterator iter(arr);
 				return iter;
 			}
 
 			/// Returns a constant iterator pointing to the position just after the last element of the list.
-			my_iterator cend() const
+			my_const_iterator cend() const
 			{
-				my_const_iterator iter(&arr[m_size]);
-				return iter;	
+				my_const_iterator iter(arr + m_size);
+				return iter;
 			}
 
 
@@ -106,74 +192,121 @@ namespace sc{
 			size_type size( ) const
 			{return this->m_size;}
 
-			/// Delete all array elements.
+			/// Returns a copy of the allocator.
+			allocator_type get_allocator( ) const
+			{return m_alloc;}
+
+#ifdef SC_VECTOR_INSTRUMENT
+			/// Returns what this vector did with its storage so far.
+			const vector_stats & stats( ) const
+			{return m_stats;}
+#endif
+
+			/// Delete all array elements. The storage is kept.
 			void clear( )
 			{
-				delete arr;
-
+				destroy( arr, arr + m_size );
 				this->m_size = initial_size;
-				this->arr = new T[m_capacity];
+				rewind();
 			}
 
 			/// Checks if the array is empty.
 			bool empty( )
 			{return m_size == initial_size;}
-			
-			/// Adds value to the front of the list.
+
+			/// Adds value to the front of the list. Amortized O(1): free slots are kept before the first element.
 			void push_front( const T & value )
+			{ emplace_front( value ); }
+
+			/// Moves value to the front of the list.
+			void push_front( T && value )
+			{ emplace_front( std::move( value ) ); }
+
+			/// Builds a new element at the front of the list from args.
+			template< typename... Args >
+			T & emplace_front( Args&&... args )
 			{
-				if( m_size == m_capacity )
+				if( m_front == 0 and m_size == initial_size and m_capacity != 0 )
+					return emplace_back( std::forward<Args>( args )... );
+
+				// With at least as much back slack as elements, the list shifts up into it instead of growing:
+				// a smaller slack would be spent in a few calls, each moving the whole list.
+				if( m_front == 0 and ( m_size == m_capacity or m_capacity - m_size < m_size ) )
+					return realloc_emplace_front( std::forward<Args>( args )... );
+
+				if( m_front == 0 )
 				{
-					if( m_capacity != 0 )
-						reserve( m_capacity * 2 );
-					else
-						reserve( 1 );
+					// Build the element before shifting: args may refer to an element of this list.
+					T value( std::forward<Args>( args )... );
+					shift_up( ( m_capacity - m_size + 1 ) / 2 );
+					alloc_traits::construct( m_alloc, arr - 1, std::move( value ) );
 				}
+				else
+					alloc_traits::construct( m_alloc, arr - 1, std::forward<Args>( args )... );
 
-				vector<T> aux = *this;
-				delete arr;
+				--arr;
+				--m_front;
+				++m_capacity;
+				++m_size;
+				note_peaks();
 
-				arr = new T[m_capacity];
-				arr[0] = value;
-				m_size++;
-				for(size_type i{1u} ; i < m_size ; i++ )
-					arr[i] = aux.arr[i-1];
+				return arr[0];
 			}
 
 			/// Adds value to the end of the list.
 			void push_back( const T & value )
+			{ emplace_back( value ); }
+
+			/// Moves value to the end of the list.
+			void push_back( T && value )
+			{ emplace_back( std::move( value ) ); }
+
+			/// Adds copies of the elements in the range [first; last) to the end of the list, growing the storage at most once.
+			template< typename InItr >
+			void push_back( InItr first, InItr last )
+			{ insert_range( m_size, first, (size_type)(last - first) ); }
+
+			/// Adds copies of the elements of range, any container with begin() and end(), to the end of the list.
+			template< typename Range >
+			void append_range( const Range & range )
+			{
+				using std::begin;
+				using std::end;
+				push_back( begin( range ), end( range ) );
+			}
+
+			/// Builds a new element at the end of the list from args.
+			template< typename... Args >
+			T & emplace_back( Args&&... args )
 			{
 				if( m_size == m_capacity )
-				{
-					if( m_capacity != 0 )
-						reserve( m_capacity * 2 );
-					else
-						reserve( 1 );
-				}
+					return realloc_emplace( m_size, std::forward<Args>( args )... );
 
-				arr[m_size] = value;
+				alloc_traits::construct( m_alloc, arr + m_size, std::forward<Args>( args )... );
 				m_size++;
+				note_peaks();
+
+				return arr[m_size-1];
 			}
-			
+
 			/// Removes the object at the end of the list.
 			void pop_back( )
 			{
 				m_size--;
+				alloc_traits::destroy( m_alloc, arr + m_size );
 			}
 
-			/// Removes the object at the front of the list.
+			/// Removes the object at the front of the list. O(1): its slot becomes front slack.
 			void pop_front( )
 			{
-				vector<T> aux = *this;
-				delete arr;
-
-				this->m_size--;
-				this->arr = new T[m_capacity];
-
-				for( size_type i{0u}; i < m_size; i++ )
-				{
-					arr[i] = aux[i+1];
-				}
+				alloc_traits::destroy( m_alloc, arr );
+				++arr;
+				++m_front;
+				--m_capacity;
+				--m_size;
+
+				if( m_size == initial_size )
+					rewind();
 			}
 
 			/// Returns the object at the end of the list.
@@ -192,22 +325,35 @@ namespace sc{
 			void assign( size_type count, const T & value )
 			{
 				if( count > m_capacity ){
-					reserve( count );
-					this->m_capacity = count;
+					T * new_arr = allocate( count );
+					try { construct_fill( new_arr, count, value ); }
+					catch( ... ) { deallocate( new_arr, count ); throw; }
+
+					destroy( arr, arr + m_size );
+					adopt( new_arr, count );
 				}
+				else{
+					size_type common = count < m_size ? count : m_size;
+					for( size_type i{0u} ; i < common ; i++ )
+						arr[i] = value;
 
-				delete arr;
-				this->m_size = count;
-				this->arr = new T[m_capacity];
+					if( count > m_size )
+						construct_fill( arr + m_size, count - m_size, value );
+					else
+						destroy( arr + count, arr + m_size );
+				}
 
-				for( size_type i{0u} ; i < m_size ; i++ )
-					arr[i] = value;
+				this->m_size = count;
+				note_peaks();
 			}
 
 			/// Return the object at the index position.
 			T & operator[]( size_type pos )
 			{ return arr[pos]; }
 
+			const T & operator[]( size_type pos ) const
+			{ return arr[pos]; }
+
 			/// Returns the object at the index pos in the array.
 			T & at( size_type pos )
 			{
@@ -217,7 +363,22 @@ namespace sc{
 					return arr[pos];
 			}
 
-			/// Return the capacity of array.
+			const T & at( size_type pos ) const
+			{
+				if( not (pos < m_size) )
+					throw std::out_of_range("error in at(): out of range");
+				return arr[pos];
+			}
+
+			/// Resizes the list to count elements. New elements are value-initialized.
+			void resize( size_type count )
+			{ resize_with( count ); }
+
+			/// Resizes the list to count elements. New elements are copies of value.
+			void resize( size_type count, const T & value )
+			{ resize_with( count, value ); }
+
+			/// Return the capacity of array: how many elements fit from the first one on without reallocation.
 			size_type capacity( ) const
 			{return m_capacity;}
 
@@ -227,257 +388,941 @@ namespace sc{
 				if( new_cap <= m_capacity )
 					return;
 
-				vector<T> aux = *this;
-
-				delete arr;
-				this->m_capacity = new_cap;
-				this->arr = new T[m_capacity];
+				if( new_cap <= m_front + m_capacity and reclaim_front() )
+					return;
 
-				for( size_type i{0u} ; i < m_size ; i++ )
-					arr[i] = aux[i];
+				reallocate( new_cap );
 			}
 
-			/// Desaloc unused storage
+			/// Desaloc unused storage, front slack included.
 			void shrink_to_fit( )
 			{
-				if( m_size == m_capacity )
+				if( m_size == m_capacity and m_front == 0 )
 					return;
 
-				vector<T> aux = *this;
-				
-				delete arr;
-				this->m_capacity = m_size;
-				this->arr = new T[m_capacity];
-
-				for( size_type i{0u} ; i < m_size ; i++ )
-					arr[i] = aux[i];
-			}			
+				reallocate( m_size );
+			}
 
 		public:
 			//=== Operators overload
 			/// Operator= overload for vectors
 			vector& operator=( const vector& other )
 			{
-				if( m_size != initial_size )
-					delete arr;
+				if( this == &other )
+					return *this;
 
-				this->m_capacity = other.capacity();
-				this->m_size = other.size();
-				this->arr = new T[m_capacity];
+				if( alloc_traits::propagate_on_container_copy_assignment::value and m_alloc != other.m_alloc )
+					release();
+				copy_allocator( other.m_alloc, typename alloc_traits::propagate_on_container_copy_assignment() );
 
-				for( size_type i{0u} ; i < m_size ; i++ )
-					arr[i] = other.arr[i];
+				assign_range( other.arr, other.m_size );
 
 				return *this;
 			}
 
-			/// Operator= overload for initializer_list
-			vector& operator=( std::initializer_list<T> ilist )
+			/// Move assignment. Releases the current storage and steals the storage of other.
+			vector& operator=( vector&& other )
+				noexcept( alloc_traits::propagate_on_container_move_assignment::value )
 			{
-				if( m_size != initial_size )
-					delete arr;
-
-				this->m_capacity = ilist.size() * 2;
-				this->m_size = ilist.size();
-				this->arr = new T[m_capacity];
-
-				size_type count{0};
-				for( const T& e : ilist )
-					arr[count++] = e;
+				if( this != &other )
+					move_assign( other, typename alloc_traits::propagate_on_container_move_assignment() );
 
 				return *this;
 			}
 
-			/// Operator== overload for vectors comparison
-			bool operator==( const vector& rhs )
+			/// Operator= overload for initializer_list
+			vector& operator=( std::initializer_list<T> ilist )
 			{
-				if( this->m_size == rhs.size() )
+				if( ilist.size() > m_capacity )
 				{
-					for(int i=0; i<(int)this->m_size; i++)
-					{
-						if(this->arr[i] != rhs.arr[i]) return false;
-					}
-					return true;
+					clear();
+					reserve( grown_capacity( ilist.size() ) );
 				}
-				else return false;
+
+				assign_range( ilist.begin(), ilist.size() );
+
+				return *this;
 			}
 
+			/// Operator== overload for vectors comparison. Integers and floating point numbers are compared
+			/// a register at a time (see simd.h).
+			bool operator==( const vector& rhs ) const
+			{ return m_size == rhs.m_size and simd::equal( arr, rhs.arr, m_size ); }
+
 			/// Operator!= overload for vectors comparison
-			bool operator!=( const vector& rhs )
-			{
-				if( this->m_size == rhs.size() )
-				{
-					for(int i=0; i<(int)this->m_size; i++)
-					{
-						if(this->arr[i] != rhs.arr[i]) return true;
-					}
-					return false;
-				}
-				else return true;
-			}
+			bool operator!=( const vector& rhs ) const
+			{ return not( *this == rhs ); }
 
 			//=== Operations
 			/// Adds value into the list before pos. Returns an iterator to the position of the inserted item.
 			my_iterator insert ( my_iterator pos, const T & value )
+			{ return emplace( pos, value ); }
+
+			/// Moves value into the list before pos. Returns an iterator to the position of the inserted item.
+			my_iterator insert ( my_iterator pos, T && value )
+			{ return emplace( pos, std::move( value ) ); }
+
+			/// Builds a new element from args before pos. Returns an iterator to the position of the new item.
+			template< typename... Args >
+			my_iterator emplace( my_iterator pos, Args&&... args )
 			{
-				vector<T> aux = *this;
-				size_type range_size = 1; 
 				size_type posi = pos - arr;
-				size_type total_size = (size_type)(m_size + range_size);
 
-				reserve( total_size );
+				if( m_size == m_capacity )
+				{
+					realloc_emplace( posi, std::forward<Args>( args )... );
+					return my_iterator( arr + posi );
+				}
 
-				for( size_type i = m_size ; i >= posi ; i-- )
+				if( posi == m_size )
 				{
-					arr[i+range_size] = arr[i];
+					alloc_traits::construct( m_alloc, arr + m_size, std::forward<Args>( args )... );
+					m_size++;
+					note_peaks();
+					return my_iterator( arr + posi );
 				}
-				
-				arr[posi] = value;
 
-				m_size = total_size;
+				// Build the element before shifting: args may refer to an element of this list.
+				T value( std::forward<Args>( args )... );
+				note_relocated( m_size - posi, false );
+				insert_in_place( posi, std::make_move_iterator( &value ), 1, trivial_relocation() );
+				note_peaks();
 
-				return pos;
+				return my_iterator( arr + posi );
 			}
 
 			///inserts elements from the range [first; last) before pos.
 			template< typename InItr >
 			my_iterator insert( my_iterator pos, InItr first, InItr last )
 			{
-				vector<T> aux = *this;
-				size_type range_size = last-first; 
+				return insert_range( pos - arr, first, (size_type)(last - first) );
+			}
+
+			/// Inserts elements from the initializer list ilist before pos.
+			my_iterator insert( my_iterator pos, std::initializer_list< T > ilist )
+			{
+				return insert_range( pos - arr, ilist.begin(), ilist.size() );
+			}
+
+			/// Removes the object at position pos. Returns an iterator to the element that follows pos before the call.
+			my_iterator erase( my_iterator pos )
+			{
 				size_type posi = pos - arr;
-				size_type total_size = (size_type)(m_size + range_size);
+				note_relocated( m_size - posi - 1, false );
+				erase_range( posi, 1, trivial_relocation() );
 
-				reserve( total_size );
+				return my_iterator( arr + posi );
+			}
+
+			/// Removes elements in the range [first; last). Returns an iterator to the element that follows the range.
+			my_iterator erase( my_iterator first, my_iterator last )
+			{
+				size_type posi = first - arr;
+				note_relocated( m_size - posi - ( last - first ), false );
+				erase_range( posi, last - first, trivial_relocation() );
+
+				return my_iterator( arr + posi );
+			}
 
-				for( size_type i = m_size ; i >= posi ; i-- )
+			/// Removes the object at position pos in O(1), by moving the last element into its place:
+			/// the order of the list is not kept. Returns an iterator to the element now at pos.
+			my_iterator unordered_erase( my_iterator pos )
+			{
+				size_type posi = pos - arr;
+				if( posi + 1 != m_size )
 				{
-					arr[i+range_size] = arr[i];
+					note_relocated( 1, false );
+					arr[posi] = std::move( arr[m_size - 1] );
 				}
-				
-				while( first != last )
+				pop_back();
+
+				return my_iterator( arr + posi );
+			}
+
+			/// Removes every element for which pred returns true, moving each survivor at most once.
+			/// Keeps the order of the survivors. Returns the number of removed elements.
+			template< typename Pred >
+			size_type remove_if( Pred pred )
+			{
+				size_type before = m_size;
+				compact( pred, trivial_relocation() );
+				return before - m_size;
+			}
+
+			/// Removes every element equal to value. Returns the number of removed elements.
+			size_type remove( const T & value )
+			{
+				// value may be an element of the list: compare against a copy.
+				const T target( value );
+				return remove_if( [&target]( const T & e ) { return e == target; } );
+			}
+
+			/// Removes the elements at the indices in [first, last), sorted in increasing order (an index
+			/// may repeat), moving each survivor at most once. Throws std::invalid_argument, and removes
+			/// nothing, if the indices are not sorted or not below size(). Returns the number of removed elements.
+			template< typename ForwardIt >
+			size_type erase_indices( ForwardIt first, ForwardIt last )
+			{
+				size_type previous{0u};
+				for( ForwardIt it = first ; it != last ; ++it )
 				{
-					arr[posi++] = *(first++);
+					size_type index = *it;
+					if( not ( index < m_size ) )
+						throw std::invalid_argument("error in erase_indices(): index out of range");
+					if( index < previous )
+						throw std::invalid_argument("error in erase_indices(): indices not sorted");
+					previous = index;
 				}
 
-				m_size = total_size;
+				size_type before = m_size;
+				erase_sorted( first, last, trivial_relocation() );
+				return before - m_size;
+			}
 
-				return pos;
+			/// Removes the elements at the sorted indices of range, any container with begin() and end().
+			template< typename Range >
+			size_type erase_indices( const Range & indices )
+			{
+				using std::begin;
+				using std::end;
+				return erase_indices( begin( indices ), end( indices ) );
 			}
 
-			/// Inserts elements from the initializer list ilist before pos.
-			my_iterator insert( my_iterator pos, std::initializer_list< T > ilist )
+			/// Removes the elements at the sorted indices of ilist.
+			size_type erase_indices( std::initializer_list< size_type > ilist )
+			{ return erase_indices( ilist.begin(), ilist.end() ); }
+
+			/// Replaces the contents of the list with copies of the elements in the range [first; last).
+			template< typename InItr >
+			void assign( InItr first, InItr last )
 			{
-				vector<T> aux = *this;
-				size_type range_size = ilist.size(); 
-				size_type posi = pos - arr;
-				size_type total_size = (size_type)(m_size + range_size);
+				assign_range( first, (size_type)(last - first) );
+			}
+
+			/// Replaces the contents of the list with the elements of ilist.
+			void assign( std::initializer_list< T > ilist )
+			{
+				assign_range( ilist.begin(), ilist.size() );
+			}
+
+			//=== Search
+			// Integers and floating point numbers are scanned a register at a time (see simd.h).
+			/// Returns an iterator to the first element equal to value, or end().
+			my_iterator find( const T & value )
+			{ return my_iterator( arr + simd::find( arr, m_size, value ) ); }
+
+			/// Returns a constant iterator to the first element equal to value, or end().
+			my_const_iterator find( const T & value ) const
+			{ return my_const_iterator( arr + simd::find( arr, m_size, value ) ); }
+
+			/// Returns how many elements are equal to value.
+			size_type count( const T & value ) const
+			{ return simd::count( arr, m_size, value ); }
 
-				reserve( total_size );
+			/// Checks if an element is equal to value.
+			bool contains( const T & value ) const
+			{ return simd::find( arr, m_size, value ) != m_size; }
 
-				for( size_type i = m_size ; i >= posi ; i-- )
+			/// Returns the first smallest element. The list must not be empty.
+			const T & min( ) const
+			{ return arr[ simd::min_index( arr, m_size ) ]; }
+
+			/// Returns the first largest element. The list must not be empty.
+			const T & max( ) const
+			{ return arr[ simd::max_index( arr, m_size ) ]; }
+
+		protected:
+			//=== Storage helpers
+			/// Returns raw storage for n elements, or nullptr if n is 0.
+			T * allocate( size_type n )
+			{
+				if( n == 0 )
+					return nullptr;
+
+				T * p = alloc_traits::allocate( m_alloc, n );
+				note_allocate( n );
+				return p;
+			}
+
+			/// Gives back the raw storage p of n elements.
+			void deallocate( T * p, size_type n )
+			{
+				if( p != nullptr )
 				{
-					arr[i+range_size] = arr[i];
+					alloc_traits::deallocate( m_alloc, p, n );
+					note_deallocate( n );
 				}
-				
-				for( const T& e : ilist )
+			}
+
+			/// Destroys the elements in [first, last).
+			void destroy( T * first, T * last )
+			{
+				for( ; first != last ; ++first )
+					alloc_traits::destroy( m_alloc, first );
+			}
+
+			/// Destroys all elements and gives the storage back, leaving an empty vector.
+			void release( )
+			{
+				destroy( arr, arr + m_size );
+				deallocate( arr - m_front, m_front + m_capacity );
+				this->arr = nullptr;
+				this->m_front = 0;
+				this->m_capacity = initial_capacity;
+				this->m_size = initial_size;
+			}
+
+			/// Copy-constructs count elements from first into the raw storage dest. Returns first advanced by count.
+			template< typename It >
+			It construct_copies( It first, size_type count, T * dest )
+			{ return construct_copies( first, count, dest, is_raw_copy<It>() ); }
+
+			/// Copies a contiguous range of trivially copyable elements with a single memcpy.
+			template< typename It >
+			It construct_copies( It first, size_type count, T * dest, std::true_type )
+			{
+				if( count != 0 )
+					std::memcpy( static_cast<void*>( dest ), first, count * sizeof(T) );
+				return first + count;
+			}
+
+			template< typename It >
+			It construct_copies( It first, size_type count, T * dest, std::false_type )
+			{
+				size_type i{0u};
+				try {
+					for( ; i < count ; ++i, ++first )
+						alloc_traits::construct( m_alloc, dest + i, *first );
+				}
+				catch( ... ) { destroy( dest, dest + i ); throw; }
+
+				return first;
+			}
+
+			/// Constructs count elements from args (copies of a value, or value-initialized) into the raw storage dest.
+			template< typename... Args >
+			void construct_fill( T * dest, size_type count, const Args&... args )
+			{
+				size_type i{0u};
+				try {
+					for( ; i < count ; ++i )
+						alloc_traits::construct( m_alloc, dest + i, args... );
+				}
+				catch( ... ) { destroy( dest, dest + i ); throw; }
+			}
+
+			/// Moves the elements into the raw storage dest, leaving gap free slots before index pos.
+			void relocate( T * dest, size_type pos, size_type gap )
+			{
+				relocate( dest, pos, gap, trivial_relocation() );
+				note_relocated( m_size, relocates_by_copy::value );
+			}
+
+			/// Relocation of trivially relocatable elements: at most two memcpy calls, nothing to destroy.
+			void relocate( T * dest, size_type pos, size_type gap, std::true_type )
+			{
+				if( pos != 0 )
+					std::memcpy( static_cast<void*>( dest ), arr, pos * sizeof(T) );
+				if( pos != m_size )
+					std::memcpy( static_cast<void*>( dest + pos + gap ), arr + pos, (m_size - pos) * sizeof(T) );
+			}
+
+			/// The originals are destroyed only once every element was built, so a throwing copy leaves the list intact.
+			void relocate( T * dest, size_type pos, size_type gap, std::false_type )
+			{
+				size_type i{0u};
+				try {
+					for( ; i < m_size ; ++i )
+						alloc_traits::construct( m_alloc, dest + i + (i < pos ? 0 : gap), std::move_if_noexcept( arr[i] ) );
+				}
+				catch( ... ) {
+					for( size_type j{0u} ; j < i ; ++j )
+						alloc_traits::destroy( m_alloc, dest + j + (j < pos ? 0 : gap) );
+					throw;
+				}
+
+				destroy( arr, arr + m_size );
+			}
+
+			/// Frees the current storage and takes over the new_cap slots at new_arr, whose elements were already relocated.
+			/// The first front slots are left as front slack.
+			void adopt( T * new_arr, size_type new_cap, size_type front = 0 )
+			{
+				if( new_arr != arr - m_front and arr != nullptr )
 				{
-					arr[posi++] = e;
+					deallocate( arr - m_front, m_front + m_capacity );
+					note_reallocation();
 				}
+				this->arr = new_arr + front;
+				this->m_front = front;
+				this->m_capacity = new_cap - front;
+				note_peaks();
+			}
 
-				m_size = total_size;
+			/// Gives the front slack of an empty list back to the capacity.
+			void rewind( )
+			{
+				this->arr -= m_front;
+				this->m_capacity += m_front;
+				this->m_front = 0;
+			}
 
-				return pos;
+			/// Moves the elements down to the start of the storage, when the front slack is at least as
+			/// large as the list: the move is then paid by the pop_front calls that made the slack.
+			bool reclaim_front( )
+			{
+				if( m_front == 0 or m_front < m_size )
+					return false;
+
+				T * base = arr - m_front;
+				relocate( base, m_size, 0 );
+				adopt( base, m_front + m_capacity );
+
+				return true;
 			}
 
-			/// Removes the object at position pos. Returns an iterator to the element that follows pos before the call.
-			my_iterator erase( my_iterator pos )
+			/// Moves the elements into a new storage of new_cap elements.
+			void reallocate( size_type new_cap )
 			{
-				size_type posi = pos - arr;
-				for( size_type i{posi} ; i < m_size ; i++ )
+				T * new_arr = allocate( new_cap );
+				try { relocate( new_arr, m_size, 0 ); }
+				catch( ... ) { deallocate( new_arr, new_cap ); throw; }
+
+				adopt( new_arr, new_cap );
+			}
+
+			/// Capacity to grow to when the storage is full.
+			size_type next_capacity( ) const
+			{ return grow( m_capacity, m_capacity + 1 ); }
+
+			/// Capacity to grow to when at least required elements must fit.
+			size_type grown_capacity( size_type required ) const
+			{ return grow( m_capacity, required ); }
+
+			/// Asks the growth policy for the capacity after capacity, never less than required.
+			static size_type grow( size_type capacity, size_type required )
+			{
+				size_type new_cap = Growth::grow( capacity, required, sizeof(T) );
+				return new_cap < required ? required : new_cap;
+			}
+
+			/// Grows the storage and builds a new element from args at index pos.
+			template< typename... Args >
+			T & realloc_emplace( size_type pos, Args&&... args )
+			{
+				// With more front slack than elements, the list slides down into it instead of growing.
+				bool slide = m_front > m_size;
+				size_type new_cap = slide ? m_front + m_capacity : next_capacity();
+				T * new_arr = slide ? arr - m_front : allocate( new_cap );
+
+				// The new element is built first: args may refer to an element of the old storage.
+				try {
+					alloc_traits::construct( m_alloc, new_arr + pos, std::forward<Args>( args )... );
+					try { relocate( new_arr, pos, 1 ); }
+					catch( ... ) { alloc_traits::destroy( m_alloc, new_arr + pos ); throw; }
+				}
+				catch( ... ) {
+					if( not slide )
+						deallocate( new_arr, new_cap );
+					throw;
+				}
+
+				adopt( new_arr, new_cap );
+				m_size++;
+				note_peaks();
+
+				return arr[pos];
+			}
+
+			/// Moves the list k slots up into its back slack, which turns them into front slack.
+			void shift_up( size_type k )
+			{
+				shift_up( k, trivial_relocation() );
+				note_relocated( m_size, false );
+			}
+
+			void shift_up( size_type k, std::true_type )
+			{
+				std::memmove( static_cast<void*>( arr + k ), arr, m_size * sizeof(T) );
+				this->arr += k;
+				this->m_front += k;
+				this->m_capacity -= k;
+			}
+
+			void shift_up( size_type k, std::false_type )
+			{
+				// The last min(k, size) elements land on raw storage, the others on moved-from elements.
+				size_type raw = k < m_size ? k : m_size;
+				for( size_type i{m_size} ; i > m_size - raw ; --i )
+					alloc_traits::construct( m_alloc, arr + i - 1 + k, std::move( arr[i-1] ) );
+				std::move_backward( arr, arr + m_size - raw, arr + m_size - raw + k );
+				destroy( arr, arr + raw );
+
+				this->arr += k;
+				this->m_front += k;
+				this->m_capacity -= k;
+			}
+
+			/// Grows the storage with free slots before the list, as many as the growth policy would add
+			/// to its size, and builds a new element from args in the last of them.
+			template< typename... Args >
+			T & realloc_emplace_front( Args&&... args )
+			{
+				size_type front = grow( m_size, m_size + 1 ) - m_size;
+				size_type new_cap = front + m_capacity;
+				T * new_arr = allocate( new_cap );
+
+				try {
+					alloc_traits::construct( m_alloc, new_arr + front - 1, std::forward<Args>( args )... );
+					try { relocate( new_arr + front, m_size, 0 ); }
+					catch( ... ) { alloc_traits::destroy( m_alloc, new_arr + front - 1 ); throw; }
+				}
+				catch( ... ) { deallocate( new_arr, new_cap ); throw; }
+
+				adopt( new_arr, new_cap, front - 1 );
+				m_size++;
+				note_peaks();
+
+				return arr[0];
+			}
+
+			/// Inserts count elements read from first before index pos.
+			template< typename It >
+			my_iterator insert_range( size_type pos, It first, size_type count )
+			{
+				// A position past the end inserts nothing.
+				if( pos > m_size )
+					return end();
+				if( count == 0 )
+					return my_iterator( arr + pos );
+
+				if( m_size + count > m_capacity and ( m_size + count > m_front + m_capacity or not reclaim_front() ) )
+				{
+					// Geometric growth: repeated bulk inserts reallocate O(log n) times.
+					size_type new_cap = grown_capacity( m_size + count );
+					T * new_arr = allocate( new_cap );
+					try {
+						construct_copies( first, count, new_arr + pos );
+						try { relocate( new_arr, pos, count ); }
+						catch( ... ) { destroy( new_arr + pos, new_arr + pos + count ); throw; }
+					}
+					catch( ... ) { deallocate( new_arr, new_cap ); throw; }
+
+					adopt( new_arr, new_cap );
+					m_size += count;
+				}
+				else if( pos == m_size )
 				{
-					arr[i-1] = arr[i];
+					// Append: no tail to shift.
+					construct_copies( first, count, arr + m_size );
+					m_size += count;
 				}
+				else
+				{
+					note_relocated( m_size - pos, false );
+					insert_in_place( pos, first, count, trivial_relocation() );
+				}
+				note_peaks();
 
-				m_size--;
+				return my_iterator( arr + pos );
+			}
+
+			/// Resizes the list to count elements, building the new ones from args.
+			/// The storage grows at most once, with the growth policy.
+			template< typename... Args >
+			void resize_with( size_type count, const Args&... args )
+			{
+				if( count <= m_size )
+				{
+					destroy( arr + count, arr + m_size );
+					m_size = count;
+					return;
+				}
+
+				if( count > m_capacity and ( count > m_front + m_capacity or not reclaim_front() ) )
+				{
+					size_type new_cap = grown_capacity( count );
+					T * new_arr = allocate( new_cap );
+
+					// The new elements are built first: args may refer to an element of the old storage.
+					try {
+						construct_fill( new_arr + m_size, count - m_size, args... );
+						try { relocate( new_arr, m_size, 0 ); }
+						catch( ... ) { destroy( new_arr + m_size, new_arr + count ); throw; }
+					}
+					catch( ... ) { deallocate( new_arr, new_cap ); throw; }
 
-				return my_iterator( &arr[posi-1] );
+					adopt( new_arr, new_cap );
+				}
+				else
+					construct_fill( arr + m_size, count - m_size, args... );
+
+				m_size = count;
+				note_peaks();
 			}
 
-			/// Removes elements in the range [first; last).
-			my_iterator erase( my_iterator first, my_iterator last )
+			/// Inserts count elements read from first before index pos, when they fit in the capacity.
+			/// The tail is shifted with a single memmove and the new elements are built in the hole.
+			template< typename It >
+			void insert_in_place( size_type pos, It first, size_type count, std::true_type )
 			{
-				size_type range_size = last - first;
-				size_type posi = first - arr;
+				T * hole = arr + pos;
+				std::memmove( static_cast<void*>( hole + count ), hole, (m_size - pos) * sizeof(T) );
+				try { construct_copies( first, count, hole ); }
+				catch( ... ) {
+					std::memmove( static_cast<void*>( hole ), hole + count, (m_size - pos) * sizeof(T) );
+					throw;
+				}
 
-				for( size_type i{posi} ; i < m_size - range_size ; i++ )
+				m_size += count;
+			}
+
+			template< typename It >
+			void insert_in_place( size_type pos, It first, size_type count, std::false_type )
+			{
+				size_type tail = m_size - pos;
+				T * old_end = arr + m_size;
+
+				if( tail > count )
+				{
+					// The last count elements go to raw storage, the rest of the tail is shifted over live ones.
+					for( size_type i{0u} ; i < count ; ++i )
+						alloc_traits::construct( m_alloc, old_end + i, std::move( *(old_end - count + i) ) );
+					m_size += count;
+					std::move_backward( arr + pos, old_end - count, old_end );
+					for( size_type i{0u} ; i < count ; ++i, ++first )
+						arr[pos + i] = *first;
+				}
+				else
 				{
-					arr[i-1] = arr[i-1+range_size];
+					// The whole tail goes to raw storage, behind the part of the range that does not fit over it.
+					It mid = first;
+					for( size_type i{0u} ; i < tail ; ++i )
+						++mid;
+					if( count > tail )
+						construct_copies( mid, count - tail, old_end );
+					for( size_type i{0u} ; i < tail ; ++i )
+						alloc_traits::construct( m_alloc, old_end + count - tail + i, std::move( arr[pos + i] ) );
+					m_size += count;
+					for( size_type i{0u} ; i < tail ; ++i, ++first )
+						arr[pos + i] = *first;
 				}
+			}
 
-				return my_iterator( &arr[posi] );
+			/// Removes count elements starting at index pos, closing the hole with a single memmove.
+			void erase_range( size_type pos, size_type count, std::true_type )
+			{
+				// A list that never allocated has no storage to hand to memmove.
+				if( count == 0 )
+					return;
+				destroy( arr + pos, arr + pos + count );
+				std::memmove( static_cast<void*>( arr + pos ), arr + pos + count, (m_size - pos - count) * sizeof(T) );
+				m_size -= count;
 			}
 
-			/// Replaces the contents with count copies of value value.
-			template< typename InItr >
-			void assign( InItr first, InItr last )
+			void erase_range( size_type pos, size_type count, std::false_type )
 			{
-				size_type range_size = last-first;
+				// An empty range would move-assign each element of the tail onto itself.
+				if( count == 0 )
+					return;
+				std::move( arr + pos + count, arr + m_size, arr + pos );
+				destroy( arr + m_size - count, arr + m_size );
+				m_size -= count;
+			}
 
-				if( range_size > m_capacity ){
-					reserve( range_size );
-					this->m_capacity = range_size;
+			/// Removes the elements pred returns true for in one pass: removed ones are destroyed in place
+			/// and survivors are relocated with raw copies into the slots freed before them.
+			template< typename Pred >
+			void compact( Pred & pred, std::true_type )
+			{
+				size_type kept{0u}, i{0u}, moved{0u};
+				try
+				{
+					for( ; i < m_size ; ++i )
+					{
+						if( pred( arr[i] ) )
+							alloc_traits::destroy( m_alloc, arr + i );
+						else
+						{
+							if( kept != i )
+							{
+								std::memcpy( static_cast<void*>( arr + kept ), arr + i, sizeof(T) );
+								++moved;
+							}
+							++kept;
+						}
+					}
+				}
+				catch( ... )
+				{
+					// pred threw: close the hole before the elements it did not see.
+					std::memmove( static_cast<void*>( arr + kept ), arr + i, (m_size - i) * sizeof(T) );
+					m_size = kept + m_size - i;
+					throw;
 				}
+				note_relocated( moved, false );
+				m_size = kept;
+			}
 
-				delete arr;
-				this->m_size = range_size;
-				this->arr = new T[m_capacity];
+			/// Removes the elements pred returns true for in one pass: survivors are move assigned over
+			/// the removed ones, and the tail is destroyed.
+			template< typename Pred >
+			void compact( Pred & pred, std::false_type )
+			{
+				size_type kept{0u}, i{0u}, moved{0u};
+				try
+				{
+					for( ; i < m_size ; ++i )
+					{
+						if( not pred( arr[i] ) )
+						{
+							if( kept != i )
+							{
+								arr[kept] = std::move( arr[i] );
+								++moved;
+							}
+							++kept;
+						}
+					}
+				}
+				catch( ... )
+				{
+					std::move( arr + i, arr + m_size, arr + kept );
+					destroy( arr + kept + m_size - i, arr + m_size );
+					m_size = kept + m_size - i;
+					throw;
+				}
+				note_relocated( moved, false );
+				destroy( arr + kept, arr + m_size );
+				m_size = kept;
+			}
 
-				size_type count{0u};
-				while( first != last )
-					arr[count++] = *(first++);
+			/// Removes the elements at the sorted indices in [first, last): each run of survivors between
+			/// two of them is moved down with one memmove.
+			template< typename ForwardIt >
+			void erase_sorted( ForwardIt first, ForwardIt last, std::true_type )
+			{
+				if( first == last )
+					return;
+
+				size_type kept = *first, next = kept, start = kept;
+				for( ; first != last ; ++first )
+				{
+					size_type index = *first;
+					if( index < next )
+						continue;
+					std::memmove( static_cast<void*>( arr + kept ), arr + next, (index - next) * sizeof(T) );
+					kept += index - next;
+					alloc_traits::destroy( m_alloc, arr + index );
+					next = index + 1;
+				}
+				std::memmove( static_cast<void*>( arr + kept ), arr + next, (m_size - next) * sizeof(T) );
+				kept += m_size - next;
+				note_relocated( kept - start, false );
+				m_size = kept;
 			}
 
-			/// Replaces the contents of the list with copies of the elements in the range [first; last).
-			void assign( std::initializer_list< T > ilist )
+			template< typename ForwardIt >
+			void erase_sorted( ForwardIt first, ForwardIt last, std::false_type )
+			{
+				if( first == last )
+					return;
+
+				size_type kept = *first, next = kept, start = kept;
+				for( ; first != last ; ++first )
+				{
+					size_type index = *first;
+					if( index < next )
+						continue;
+					std::move( arr + next, arr + index, arr + kept );
+					kept += index - next;
+					next = index + 1;
+				}
+				std::move( arr + next, arr + m_size, arr + kept );
+				kept += m_size - next;
+				note_relocated( kept - start, false );
+				destroy( arr + kept, arr + m_size );
+				m_size = kept;
+			}
+
+			/// Replaces the contents with count elements read from first.
+			template< typename It >
+			void assign_range( It first, size_type count )
+			{
+				if( count > m_capacity )
+				{
+					T * new_arr = allocate( count );
+					try { construct_copies( first, count, new_arr ); }
+					catch( ... ) { deallocate( new_arr, count ); throw; }
+
+					destroy( arr, arr + m_size );
+					adopt( new_arr, count );
+				}
+				else if( is_raw_copy<It>::value )
+				{
+					// Trivially copyable elements are overwritten in one block. memmove: first may point into arr.
+					// The cast lets *first be an rvalue, as through the move iterators of move_assign().
+					if( count != 0 )
+						std::memmove( static_cast<void*>( arr ), &static_cast<const T&>( *first ), count * sizeof(T) );
+				}
+				else
+				{
+					size_type common = count < m_size ? count : m_size;
+					for( size_type i{0u} ; i < common ; ++i, ++first )
+						arr[i] = *first;
+
+					if( count > m_size )
+						construct_copies( first, count - m_size, arr + m_size );
+					else
+						destroy( arr + count, arr + m_size );
+				}
+
+				this->m_size = count;
+				note_peaks();
+			}
+
+			//=== Instrumentation hooks: empty unless SC_VECTOR_INSTRUMENT is defined.
+			/// Counts a storage of n elements drawn from the allocator.
+			void note_allocate( size_type n )
+			{
+#ifdef SC_VECTOR_INSTRUMENT
+				m_stats.allocations++;
+				m_stats.bytes_allocated += n * sizeof(T);
+				instrument::shared().allocations++;
+				instrument::shared().bytes_allocated += n * sizeof(T);
+#endif
+			}
+
+			/// Counts a storage of n elements given back to the allocator.
+			void note_deallocate( size_type n )
+			{
+#ifdef SC_VECTOR_INSTRUMENT
+				m_stats.bytes_freed += n * sizeof(T);
+				instrument::shared().bytes_freed += n * sizeof(T);
+#endif
+			}
+
+			/// Counts a storage that replaced the previous one.
+			void note_reallocation( )
+			{
+#ifdef SC_VECTOR_INSTRUMENT
+				m_stats.reallocations++;
+				instrument::shared().reallocations++;
+#endif
+			}
+
+			/// Counts n elements relocated or shifted by the vector, copied or moved.
+			void note_relocated( size_type n, bool copied )
+			{
+#ifdef SC_VECTOR_INSTRUMENT
+				if( copied )
+				{
+					m_stats.elements_copied += n;
+					instrument::shared().elements_copied += n;
+				}
+				else
+				{
+					m_stats.elements_moved += n;
+					instrument::shared().elements_moved += n;
+				}
+#endif
+			}
+
+			/// Records the current storage and size if they are the largest so far.
+			void note_peaks( )
 			{
-				if( ilist.size() > m_capacity ){
-					reserve( ilist.size() );
-					this->m_capacity = ilist.size();
+#ifdef SC_VECTOR_INSTRUMENT
+				if( m_front + m_capacity > m_stats.peak_capacity )
+				{
+					m_stats.peak_capacity = m_front + m_capacity;
+					instrument::raise( instrument::shared().peak_capacity, m_stats.peak_capacity );
 				}
+				if( m_size > m_stats.peak_size )
+				{
+					m_stats.peak_size = m_size;
+					instrument::raise( instrument::shared().peak_size, m_size );
+				}
+#endif
+			}
 
-				delete arr;
-				this->m_size = ilist.size();
-				this->arr = new T[m_capacity];
+			/// Takes the allocator of other when the allocator propagates on copy assignment.
+			void copy_allocator( const Alloc & other, std::true_type )
+			{ m_alloc = other; }
 
-				size_type count{0u};
-				for( const T& e : ilist )
-					arr[count++] = e;
+			void copy_allocator( const Alloc &, std::false_type )
+			{/*empty*/}
+
+			/// Move assignment with an allocator that travels with the storage.
+			void move_assign( vector & other, std::true_type )
+			{
+				release();
+				m_alloc = std::move( other.m_alloc );
+				steal( other );
 			}
-			
-			
+
+			/// Move assignment with an allocator that stays: the storage can only be stolen from an equal allocator.
+			void move_assign( vector & other, std::false_type )
+			{
+				if( m_alloc == other.m_alloc )
+				{
+					release();
+					steal( other );
+				}
+				else
+				{
+					assign_range( std::make_move_iterator( other.arr ), other.m_size );
+					other.clear();
+				}
+			}
+
+			/// Takes the storage of other, leaving it empty.
+			void steal( vector & other )
+			{
+				this->m_capacity = other.m_capacity;
+				this->m_size = other.m_size;
+				this->arr = other.arr;
+				this->m_front = other.m_front;
+
+				other.m_capacity = initial_capacity;
+				other.m_size = initial_size;
+				other.arr = nullptr;
+				other.m_front = 0;
+			}
+
 		protected:
 			size_type m_capacity; //!< capacity of the array (alocated memory).
 			size_type m_size; //!< size of the array.
-			T * arr; //!< T type array pointer.
-		
+			T * arr; //!< T type array pointer, to the first element.
+			size_type m_front; //!< free slots of the storage before arr (front slack).
+			Alloc m_alloc; //!< Allocator that provides the storage.
+#ifdef SC_VECTOR_INSTRUMENT
+			vector_stats m_stats; //!< Counters of this vector.
+#endif
+
 		public:
 
 		/*! \class my_iterator
 			
 			With this class we're trying to implement an iterator class for vectors.
+			It is a random access iterator: a thin wrapper over T* whose arithmetic is O(1).
 		*/
 		class my_iterator{
 			private:
 				T * it; //!< Iterator pointer
 				typedef my_iterator iterator; 
+				friend class my_const_iterator;
 
 			public:
 				//=== Alias
 				typedef size_t size_type; //!< Type of size.
+				typedef std::ptrdiff_t difference_type; //!< Distance between two iterators.
+				typedef T value_type; //!< Type of the pointed element.
+				typedef T * pointer; //!< Pointer to the element.
+				typedef T & reference; //!< Reference to the element.
+				typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
 				
 				//=== Constructor
-				my_iterator(T* it)
+				my_iterator(T* it = nullptr)
 					:it{it}
 				{/*empty*/}
 
@@ -489,8 +1334,8 @@ namespace sc{
 
 			public:
 				//=== Operators
-				iterator operator++(void)
-				{ return iterator( ++it ); }
+				iterator& operator++(void)
+				{ ++it; return *this; }
 
 				iterator operator++(int)
 				{ 
@@ -499,11 +1344,17 @@ namespace sc{
 					return temp;
 				}
 
-				T& operator*()
+				T& operator*() const
 				{ return *it; }
 
-				iterator operator--(void)
-				{ return iterator( --it ); }
+				T* operator->() const
+				{ return it; }
+
+				T& operator[]( difference_type n ) const
+				{ return it[n]; }
+
+				iterator& operator--(void)
+				{ --it; return *this; }
 
 				iterator operator--(int)
 				{
@@ -512,58 +1363,49 @@ namespace sc{
 					return temp;
 				}
 
-				friend iterator operator+(int n, iterator it)
-				{
-					for( int i = 0 ; i < n ; i++ )
-						it++;
-					return iterator( it );
-				}
+				iterator& operator+=( difference_type n )
+				{ it += n; return *this; }
 
-				friend iterator operator+(iterator it, int n)
-				{
-					for( int i = 0 ; i < n ; i++ )
-						it++;
-					return iterator( it );
-				}
+				iterator& operator-=( difference_type n )
+				{ it -= n; return *this; }
 
-				friend iterator operator-(int n, iterator it)
-				{
-					for( int i = 0 ; i < n ; i++ )
-						it--;
-					return iterator( it );
-				}
+				friend iterator operator+(difference_type n, iterator it)
+				{ return iterator( it.it + n ); }
 
-				friend iterator operator-(iterator it, int n)
-				{
-					for( int i = 0 ; i < n ; i++ )
-						it--;
-					return iterator( it );
-				}
+				friend iterator operator+(iterator it, difference_type n)
+				{ return iterator( it.it + n ); }
 
-				friend size_type operator-(iterator it1, iterator it2)
-				{
-					return it1.it - it2.it;
-				}
+				friend iterator operator-(iterator it, difference_type n)
+				{ return iterator( it.it - n ); }
 
-				iterator operator->()
-				{
-					return iterator( it );
-				}
+				friend difference_type operator-(iterator it1, iterator it2)
+				{ return it1.it - it2.it; }
 
 				bool operator==( const iterator& it2) const
 				{ return it == it2.it; }
 
 				bool operator!=( const iterator& it2) const
 				{ return it != it2.it; }
+
+				bool operator<( const iterator& it2) const
+				{ return it < it2.it; }
+
+				bool operator>( const iterator& it2) const
+				{ return it > it2.it; }
+
+				bool operator<=( const iterator& it2) const
+				{ return it <= it2.it; }
+
+				bool operator>=( const iterator& it2) const
+				{ return it >= it2.it; }
 		}; // class my_iterator
 		
 
-		/*! \class my_constiterator
+		/*! \class my_const_iterator
 			
 			With this class we're trying to implement an constant iterator class for vectors.
+			Any my_iterator converts to it.
 		*/
-
-
 		class my_const_iterator{
 			private:
 				const T * it; //!< Iterator pointer
@@ -572,12 +1414,22 @@ namespace sc{
 			public:
 				//=== Alias
 				typedef size_t size_type; //!< Type of size.
+				typedef std::ptrdiff_t difference_type; //!< Distance between two iterators.
+				typedef T value_type; //!< Type of the pointed element.
+				typedef const T * pointer; //!< Pointer to the element.
+				typedef const T & reference; //!< Reference to the element.
+				typedef std::random_access_iterator_tag iterator_category; //!< Iterator category.
 				
 				//=== Constructor
-				my_const_iterator(T* it)
+				my_const_iterator(const T* it = nullptr)
 					:it{it}
 				{/*empty*/}
 
+				/// Conversion from a mutable iterator.
+				my_const_iterator(const my_iterator& other)
+					:it{other.it}
+				{/*empty*/}
+
 				//=== Destructor
 				~my_const_iterator()
 				{/*empty*/}
@@ -586,75 +1438,87 @@ namespace sc{
 
 			public:
 				//=== Operators
-				const iterator operator++(void)
-				{ return iterator( ++it ); }
+				iterator& operator++(void)
+				{ ++it; return *this; }
 
-				const iterator operator++(int)
+				iterator operator++(int)
 				{ 
 					iterator temp( it );
 					it++;
 					return temp;
 				}
 
-				const T& operator*()
+				const T& operator*() const
 				{ return *it; }
 
-				const iterator operator--(void)
-				{ return iterator( --it ); }
+				const T* operator->() const
+				{ return it; }
+
+				const T& operator[]( difference_type n ) const
+				{ return it[n]; }
+
+				iterator& operator--(void)
+				{ --it; return *this; }
 
-				const iterator operator--(int)
+				iterator operator--(int)
 				{
 					iterator temp( it );
 					it--;
 					return temp;
 				}
 
-				friend const iterator operator+(int n, iterator it)
-				{
-					for( int i = 0 ; i < n ; i++ )
-						it++;
-					return iterator( it );
-				}
+				iterator& operator+=( difference_type n )
+				{ it += n; return *this; }
 
-				friend const iterator operator+(iterator it, int n)
-				{
-					for( int i = 0 ; i < n ; i++ )
-						it++;
-					return iterator( it );
-				}
+				iterator& operator-=( difference_type n )
+				{ it -= n; return *this; }
 
-				friend const iterator operator-(int n, iterator it)
-				{
-					for( int i = 0 ; i < n ; i++ )
-						it--;
-					return iterator( it );
-				}
+				friend iterator operator+(difference_type n, iterator it)
+				{ return iterator( it.it + n ); }
 
-				friend const iterator operator-(iterator it, int n)
-				{
-					for( int i = 0 ; i < n ; i++ )
-						it--;
-					return iterator( it );
-				}
+				friend iterator operator+(iterator it, difference_type n)
+				{ return iterator( it.it + n ); }
 
-				friend const size_type operator-(iterator it1, iterator it2)
-				{
-					return it1.it - it2.it;
-				}
+				friend iterator operator-(iterator it, difference_type n)
+				{ return iterator( it.it - n ); }
 
-				const iterator operator->()
-				{
-					return iterator( it );
-				}
-				const bool operator==( const iterator& it2) const
-				{ return it == it2.it; }
+				friend difference_type operator-(iterator it1, iterator it2)
+				{ return it1.it - it2.it; }
 
-				const bool operator!=( const iterator& it2) const
-				{ return it != it2.it; }
-		}; // class my_iterator
+				friend bool operator==( const iterator& it1, const iterator& it2 )
+				{ return it1.it == it2.it; }
+
+				friend bool operator!=( const iterator& it1, const iterator& it2 )
+				{ return it1.it != it2.it; }
+
+				friend bool operator<( const iterator& it1, const iterator& it2 )
+				{ return it1.it < it2.it; }
+
+				friend bool operator>( const iterator& it1, const iterator& it2 )
+				{ return it1.it > it2.it; }
+
+				friend bool operator<=( const iterator& it1, const iterator& it2 )
+				{ return it1.it <= it2.it; }
+
+				friend bool operator>=( const iterator& it1, const iterator& it2 )
+				{ return it1.it >= it2.it; }
+		}; // class my_const_iterator
 		
 	}; // class vector
 
+	/// Removes every element of vec equal to value, in one pass. Returns the number of removed elements.
+	template< typename T, typename Alloc, typename Growth >
+	size_t erase( vector<T, Alloc, Growth> & vec, const T & value )
+	{ return vec.remove( value ); }
+
+	/// Removes every element of vec for which pred returns true, in one pass. Returns the number of removed elements.
+	template< typename T, typename Alloc, typename Growth, typename Pred >
+	size_t erase_if( vector<T, Alloc, Growth> & vec, Pred pred )
+	{ return vec.remove_if( pred ); }
+
 } // namespace sc
 
-#endif
+// sc::vector<bool> stores its flags packed in words.
+#include "bit_vector.h"
+
+#endif
\ No newline at end of file
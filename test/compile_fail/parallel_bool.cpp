@@ -0,0 +1,10 @@
+// Must not compile: the parallel algorithms need addressable elements, sc::vector<bool> packs them.
+#include "parallel.h"
+
+int main()
+{
+    sc::vector<bool> flags;
+    flags.resize( 100000 );
+    sc::parallel::fill( flags, true );
+    return 0;
+}
@@ -0,0 +1,11 @@
+// Must not compile: an sc::vector<bool> is loaded whole, not read a chunk at a time.
+#include <sstream>
+
+#include "serialize.h"
+
+int main()
+{
+    std::stringstream buffer;
+    auto in = sc::io::reader<bool>( buffer );
+    return in.done() ? 0 : 1;
+}
@@ -0,0 +1,9 @@
+// Must not compile: sc::small_vector<bool, N> has no inline buffer for packed flags.
+#include "small_vector.h"
+
+int main()
+{
+    sc::small_vector<bool, 8> flags;
+    flags.push_back( true );
+    return flags.size() == 1 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "aligned_allocator.h"  // header file for tested functions
+
+
+// ============================================================================
+// TESTING ALIGNED ALLOCATOR
+// ============================================================================
+
+namespace {
+    bool aligned( const void * p, size_t alignment )
+    { return reinterpret_cast<std::uintptr_t>( p ) % alignment == 0; }
+
+    /// Checks whether the mapping holding p was advised MADV_HUGEPAGE, from /proc/self/smaps.
+    bool advised_huge( const void * p )
+    {
+        std::ifstream smaps( "/proc/self/smaps" );
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>( p );
+        std::string line;
+        bool inside{false};
+        while( std::getline( smaps, line ) )
+        {
+            std::uintptr_t first, last;
+            char dash;
+            std::istringstream range( line );
+            if( range >> std::hex >> first >> dash >> last and dash == '-' )
+                inside = first <= address and address < last;
+            else if( inside and line.compare( 0, 8, "VmFlags:" ) == 0 )
+                return line.find( " hg" ) != std::string::npos;
+        }
+        return false;
+    }
+}
+
+TEST(AlignedAllocator, SmallBlocksAreAligned)
+{
+    sc::aligned_allocator<char, 64> bytes;
+    for( size_t n{1u} ; n < 1000 ; n += 37 )
+    {
+        char * p = bytes.allocate( n );
+        EXPECT_TRUE( aligned( p, 64 ) );
+        bytes.deallocate( p, n );
+    }
+
+    sc::aligned_allocator<double, 4096> pages;
+    double * p = pages.allocate( 3 );
+    EXPECT_TRUE( aligned( p, 4096 ) );
+    pages.deallocate( p, 3 );
+
+    // Never below the alignment of the type.
+    EXPECT_EQ( ( sc::aligned_allocator<long double, 1>::alignment ), alignof(long double) );
+}
+
+TEST(AlignedAllocator, LargeBlocksUseHugePages)
+{
+    sc::aligned_allocator<int> alloc;
+    size_t n = sc::huge_page_size; // 8 MiB of ints.
+    EXPECT_TRUE( alloc.is_huge( n * sizeof(int) ) );
+
+    int * p = alloc.allocate( n );
+    EXPECT_TRUE( aligned( p, sc::huge_page_size ) );
+    p[0] = 1;
+    p[n - 1] = 2;
+    EXPECT_EQ( p[n / 2], 0 );
+
+    std::ifstream thp( "/sys/kernel/mm/transparent_hugepage/enabled" );
+    if( thp )
+    {
+        EXPECT_TRUE( advised_huge( p ) );
+    }
+    alloc.deallocate( p, n );
+
+    sc::aligned_allocator<int, 64, sc::no_huge_pages> plain;
+    EXPECT_FALSE( plain.is_huge( n * sizeof(int) ) );
+}
+
+TEST(AlignedAllocator, AlignedVector)
+{
+    sc::aligned_vector<float, 64> vec;
+    for( int i{0} ; i < 1000 ; ++i )
+    {
+        vec.push_back( i * 0.5f );
+        ASSERT_TRUE( aligned( &vec[0], 64 ) );
+    }
+    EXPECT_EQ( vec[999], 499.5f );
+    EXPECT_EQ( vec.max(), 499.5f );
+
+    // Crossing the threshold moves the storage to huge pages.
+    sc::aligned_vector<double, 64, ( 1 << 20 )> big;
+    big.resize( 1 << 18, 1.0 );
+    EXPECT_TRUE( aligned( &big[0], sc::huge_page_size ) );
+    big.resize( 10 );
+    big.shrink_to_fit();
+    EXPECT_TRUE( aligned( &big[0], 64 ) );
+    EXPECT_EQ( big.count( 1.0 ), 10u );
+
+    sc::aligned_vector<std::string, 128> strings{ "a", "b" };
+    EXPECT_TRUE( aligned( &strings[0], 128 ) );
+    EXPECT_TRUE( ( sc::aligned_allocator<int>() == sc::aligned_allocator<int>() ) );
+}
@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "vector.h"             // header file for tested functions
+
+
+// ============================================================================
+// TESTING BIT-PACKED VECTOR OF BOOL
+// ============================================================================
+
+namespace {
+
+    /// Checks flags against reference, one by one, through indexes and iterators.
+    void expect_same( const sc::vector<bool> & flags, const std::vector<bool> & reference )
+    {
+        ASSERT_EQ( flags.size(), reference.size() );
+        for( size_t i = 0 ; i < reference.size() ; ++i )
+            ASSERT_EQ( flags[i], reference[i] ) << "at " << i;
+        EXPECT_TRUE( std::equal( flags.begin(), flags.end(), reference.begin() ) );
+    }
+}
+
+TEST(BitVector, PackedStorageAndProxies)
+{
+    sc::vector<bool> flags;
+    for( int i = 0 ; i < 1000 ; ++i )
+        flags.push_back( i % 3 == 0 );
+    EXPECT_EQ( flags.size(), 1000u );
+    EXPECT_EQ( flags.capacity() % 64, 0u );
+    EXPECT_GE( flags.capacity(), 1000u );
+
+    EXPECT_TRUE( flags.front() );
+    EXPECT_TRUE( flags.back() );
+    EXPECT_FALSE( flags[1] );
+    EXPECT_THROW( flags.at( 1000 ), std::out_of_range );
+
+    // Writes through the proxies touch one bit.
+    flags[1] = true;
+    flags.at( 3 ) = false;
+    flags[4] = flags[0];
+    flags[6].flip();
+    EXPECT_TRUE( flags[1] );
+    EXPECT_FALSE( flags[3] );
+    EXPECT_TRUE( flags[4] );
+    EXPECT_FALSE( flags[6] );
+    EXPECT_FALSE( flags[5] );
+    EXPECT_TRUE( ~flags[5] );
+
+    flags.pop_back();
+    EXPECT_EQ( flags.size(), 999u );
+    EXPECT_FALSE( flags.back() );
+    flags.push_back( false );
+    EXPECT_FALSE( flags.back() );
+
+    // A reserved capacity is rounded up to whole words.
+    sc::vector<bool> reserved( 100 );
+    EXPECT_TRUE( reserved.empty() );
+    EXPECT_EQ( reserved.capacity(), 128u );
+}
+
+TEST(BitVector, MatchesStdVectorBool)
+{
+    std::mt19937 gen( 17 );
+    sc::vector<bool> flags;
+    std::vector<bool> reference;
+
+    for( int step = 0 ; step < 3000 ; ++step )
+    {
+        size_t n = reference.size();
+        switch( gen() % 7 )
+        {
+            case 0:
+            case 1:
+            {
+                bool value = gen() % 2;
+                flags.push_back( value );
+                reference.push_back( value );
+                break;
+            }
+            case 2:
+            {
+                size_t pos = gen() % ( n + 1 );
+                bool value = gen() % 2;
+                auto it = flags.insert( flags.begin() + pos, value );
+                reference.insert( reference.begin() + pos, value );
+                EXPECT_EQ( (size_t) ( it - flags.begin() ), pos );
+                break;
+            }
+            case 3:
+                if( n != 0 )
+                {
+                    size_t first = gen() % n;
+                    size_t last = first + gen() % ( std::min<size_t>( n - first, 150 ) + 1 );
+                    flags.erase( flags.begin() + first, flags.begin() + last );
+                    reference.erase( reference.begin() + first, reference.begin() + last );
+                }
+                break;
+            case 4:
+            {
+                size_t count = gen() % 400;
+                bool value = gen() % 2;
+                flags.resize( count, value );
+                reference.resize( count, value );
+                break;
+            }
+            case 5:
+                if( n != 0 )
+                {
+                    size_t pos = gen() % n;
+                    flags.erase( flags.begin() + pos );
+                    reference.erase( reference.begin() + pos );
+                }
+                break;
+            default:
+                if( n != 0 )
+                {
+                    size_t pos = gen() % n;
+                    flags[pos].flip();
+                    reference[pos].flip();
+                }
+        }
+        expect_same( flags, reference );
+
+        size_t set = std::count( reference.begin(), reference.end(), true );
+        ASSERT_EQ( flags.count( true ), set );
+        ASSERT_EQ( flags.count( false ), reference.size() - set );
+        ASSERT_EQ( (size_t) ( flags.find( false ) - flags.begin() ),
+                   (size_t) ( std::find( reference.begin(), reference.end(), false ) - reference.begin() ) );
+    }
+}
+
+TEST(BitVector, FindFirstAndNext)
+{
+    sc::vector<bool> flags;
+    flags.resize( 1000 );
+    EXPECT_EQ( flags.find_first(), 1000u );
+    EXPECT_FALSE( flags.contains( true ) );
+
+    std::vector<size_t> set{ 0, 63, 64, 65, 127, 500, 999 };
+    for( size_t i : set )
+        flags[i] = true;
+
+    std::vector<size_t> found;
+    for( size_t i = flags.find_first() ; i != flags.size() ; i = flags.find_next( i ) )
+        found.push_back( i );
+    EXPECT_EQ( found, set );
+    EXPECT_EQ( flags.find_next( 999 ), 1000u );
+    EXPECT_TRUE( flags.find( true ) == flags.begin() );
+
+    // Searching false never lands on the zeroed bits past the end.
+    sc::vector<bool> full;
+    full.resize( 130, true );
+    EXPECT_TRUE( full.find( false ) == full.end() );
+    EXPECT_FALSE( full.contains( false ) );
+    EXPECT_EQ( full.count( true ), 130u );
+}
+
+TEST(BitVector, BitwiseOperators)
+{
+    std::mt19937 gen( 3 );
+    sc::vector<bool> a, b;
+    for( int i = 0 ; i < 1000 ; ++i )
+    {
+        a.push_back( gen() % 2 );
+        b.push_back( gen() % 3 == 0 );
+    }
+
+    sc::vector<bool> both = a & b, either = a | b, one = a ^ b;
+    for( size_t i = 0 ; i < a.size() ; ++i )
+    {
+        ASSERT_EQ( both[i], a[i] and b[i] );
+        ASSERT_EQ( either[i], a[i] or b[i] );
+        ASSERT_EQ( one[i], a[i] != b[i] );
+    }
+
+    sc::vector<bool> flipped( a );
+    flipped.flip();
+    EXPECT_EQ( flipped.count( true ), a.count( false ) );
+    EXPECT_TRUE( ( flipped & a ).find_first() == a.size() );
+    flipped ^= a;
+    EXPECT_EQ( flipped.count( true ), a.size() );
+
+    b.pop_back();
+    EXPECT_THROW( a &= b, std::invalid_argument );
+    EXPECT_THROW( a | b, std::invalid_argument );
+}
+
+TEST(BitVector, CopiesAlgorithmsAndErase)
+{
+    sc::vector<bool> flags{ true, false, false, true, true };
+    sc::vector<bool> copy( flags );
+    EXPECT_TRUE( copy == flags );
+    copy[2] = true;
+    EXPECT_TRUE( copy != flags );
+
+    sc::vector<bool> moved( std::move( copy ) );
+    EXPECT_TRUE( copy.empty() );
+    copy = moved;
+    EXPECT_TRUE( copy == moved );
+    copy = { false, true };
+    EXPECT_EQ( copy.size(), 2u );
+    EXPECT_TRUE( copy[1] );
+
+    // Standard algorithms run over the proxy iterators.
+    std::reverse( flags.begin(), flags.end() );
+    EXPECT_TRUE( flags == ( sc::vector<bool>{ true, true, false, false, true } ) );
+    std::sort( flags.begin(), flags.end() );
+    EXPECT_TRUE( flags == ( sc::vector<bool>{ false, false, true, true, true } ) );
+    const sc::vector<bool> & view = flags;
+    EXPECT_EQ( std::count( view.begin(), view.end(), true ), 3 );
+
+    EXPECT_EQ( sc::erase( flags, false ), 2u );
+    EXPECT_TRUE( flags == ( sc::vector<bool>{ true, true, true } ) );
+    flags.assign( 200, false );
+    flags[70] = true;
+    EXPECT_EQ( sc::erase_if( flags, []( bool value ) { return value; } ), 1u );
+    EXPECT_EQ( flags.size(), 199u );
+    EXPECT_EQ( flags.count( false ), 199u );
+
+    flags.resize( 10 );
+    flags.shrink_to_fit();
+    EXPECT_EQ( flags.capacity(), 64u );
+    flags.clear();
+    flags.shrink_to_fit();
+    EXPECT_EQ( flags.capacity(), 0u );
+}
+
+TEST(BitVector, SharesVectorApi)
+{
+    sc::vector<bool> flags;
+    EXPECT_FALSE( flags.emplace_back( false ) );
+    flags.emplace_back( 1 );
+    flags.push_front( true );
+    flags.emplace_front();
+    EXPECT_TRUE( flags == ( sc::vector<bool>{ false, true, false, true } ) );
+
+    flags.front() = true;
+    flags.back().flip();
+    flags.pop_front();
+    EXPECT_TRUE( flags == ( sc::vector<bool>{ true, false, false } ) );
+    EXPECT_FALSE( flags.min() );
+    EXPECT_TRUE( flags.max() );
+
+    auto it = flags.emplace( flags.begin() + 1, true );
+    EXPECT_EQ( it - flags.begin(), 1 );
+    it = flags.insert( flags.end(), { true, true } );
+    EXPECT_EQ( it - flags.begin(), 4 );
+    EXPECT_TRUE( flags == ( sc::vector<bool>{ true, true, false, false, true, true } ) );
+
+    // The last flag moves into the hole.
+    it = flags.unordered_erase( flags.begin() + 2 );
+    EXPECT_TRUE( *it );
+    EXPECT_TRUE( flags == ( sc::vector<bool>{ true, true, true, false, true } ) );
+
+    sc::vector<bool> set( 3 );
+    set.resize( 3, true );
+    EXPECT_TRUE( set.min() );
+    set.append_range( std::vector<bool>{ false } );
+    EXPECT_FALSE( set.min() );
+    EXPECT_EQ( set.size(), 4u );
+}
+
+TEST(BitVector, RangeInsertAndEraseIndices)
+{
+    std::mt19937 gen( 29 );
+    sc::vector<bool> flags;
+    std::vector<bool> reference;
+
+    for( int step = 0 ; step < 400 ; ++step )
+    {
+        size_t n = reference.size();
+        if( gen() % 3 != 0 or n < 10 )
+        {
+            // A range crossing words, inserted anywhere.
+            std::vector<bool> range( gen() % 200 );
+            for( size_t i = 0 ; i < range.size() ; ++i )
+                range[i] = gen() % 2;
+            size_t pos = gen() % ( n + 1 );
+            auto it = flags.insert( flags.begin() + pos, range.begin(), range.end() );
+            reference.insert( reference.begin() + pos, range.begin(), range.end() );
+            EXPECT_EQ( (size_t) ( it - flags.begin() ), pos );
+        }
+        else
+        {
+            std::vector<size_t> indices;
+            for( size_t i = 0 ; i < n ; i += 1 + gen() % 90 )
+                indices.push_back( i );
+            indices.push_back( indices.back() );
+            EXPECT_EQ( flags.erase_indices( indices ), indices.size() - 1 );
+            for( size_t i = indices.size() - 1 ; i-- > 0 ; )
+                reference.erase( reference.begin() + indices[i] );
+        }
+        expect_same( flags, reference );
+        ASSERT_EQ( flags.count( true ), (size_t) std::count( reference.begin(), reference.end(), true ) );
+    }
+
+    EXPECT_THROW( flags.erase_indices( { 2u, 1u } ), std::invalid_argument );
+    EXPECT_THROW( flags.erase_indices( { flags.size() } ), std::invalid_argument );
+}
+
+TEST(BitVector, AppendsItsOwnFlags)
+{
+    sc::vector<bool> flags;
+    for( int i = 0 ; i < 100 ; ++i )
+        flags.push_back( i % 3 == 0 );
+    flags.shrink_to_fit();
+
+    // The range is read through proxies into the storage that growth replaces.
+    sc::vector<bool> twice( flags );
+    twice.push_back( twice.begin(), twice.end() );
+    ASSERT_EQ( twice.size(), 200u );
+    for( size_t i = 0 ; i < 200 ; ++i )
+        ASSERT_EQ( twice[i], i % 100 % 3 == 0 ) << "at " << i;
+
+    twice.insert( twice.begin() + 1, twice.begin(), twice.begin() + 70 );
+    EXPECT_EQ( twice.size(), 270u );
+    EXPECT_TRUE( twice[0] );
+    EXPECT_TRUE( twice[1] );
+    EXPECT_FALSE( twice[2] );
+    EXPECT_TRUE( twice[71] == flags[1] );
+}
@@ -0,0 +1,221 @@
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "concurrent_vector.h"  // header file for tested functions
+
+
+// ============================================================================
+// TESTING CONCURRENT VECTOR
+// ============================================================================
+
+namespace {
+    /// Copy constructor throws when the value is negative.
+    struct Picky
+    {
+        int value;
+        Picky( int v ) : value{v} {}
+        Picky( const Picky & other ) : value{other.value}
+        {
+            if( value < 0 )
+                throw std::runtime_error( "negative" );
+        }
+    };
+
+    /// Allocator that throws std::bad_alloc once budget allocations were made.
+    template< typename T >
+    struct BudgetAllocator
+    {
+        typedef T value_type;
+        static int budget;
+
+        BudgetAllocator( ) = default;
+        template< typename U >
+        BudgetAllocator( const BudgetAllocator<U> & ) {}
+
+        T * allocate( size_t n )
+        {
+            if( budget == 0 )
+                throw std::bad_alloc();
+            --budget;
+            return std::allocator<T>().allocate( n );
+        }
+
+        void deallocate( T * p, size_t n )
+        { std::allocator<T>().deallocate( p, n ); }
+
+        bool operator==( const BudgetAllocator & ) const { return true; }
+        bool operator!=( const BudgetAllocator & ) const { return false; }
+    };
+
+    template< typename T >
+    int BudgetAllocator<T>::budget = -1;
+}
+
+TEST(ConcurrentVector, PushBackAndIndex)
+{
+    sc::concurrent_vector<std::string> vec;
+    EXPECT_TRUE( vec.empty() );
+
+    for( int i{0} ; i < 1000 ; ++i )
+        EXPECT_EQ( vec.push_back( std::to_string( i ) ), (size_t) i );
+
+    ASSERT_EQ( vec.size(), 1000u );
+    for( int i{0} ; i < 1000 ; ++i )
+        ASSERT_EQ( vec[i], std::to_string( i ) );
+    EXPECT_GE( vec.capacity(), 1000u );
+    EXPECT_EQ( vec.at( 999 ), "999" );
+    EXPECT_THROW( vec.at( 1000 ), std::out_of_range );
+}
+
+TEST(ConcurrentVector, ReferencesStayValid)
+{
+    sc::concurrent_vector<int> vec;
+    vec.push_back( 42 );
+    int * first = &vec[0];
+    int * hundredth = &vec[ vec.grow_by( 100, 7 ) + 99 ];
+
+    vec.grow_by( 1 << 16 );
+    EXPECT_EQ( first, &vec[0] );
+    EXPECT_EQ( hundredth, &vec[100] );
+    EXPECT_EQ( *first, 42 );
+    EXPECT_EQ( vec[ vec.size() - 1 ], 0 );
+}
+
+TEST(ConcurrentVector, GrowByRange)
+{
+    std::vector<int> source( 50 );
+    for( int i{0} ; i < 50 ; ++i )
+        source[i] = i;
+
+    sc::concurrent_vector<int> vec{ -1, -2 };
+    EXPECT_EQ( vec.grow_by( source.begin(), source.end() ), 2u );
+    ASSERT_EQ( vec.size(), 52u );
+    EXPECT_TRUE( std::equal( source.begin(), source.end(), vec.begin() + 2 ) );
+    EXPECT_EQ( vec.end() - vec.begin(), 52 );
+
+    sc::concurrent_vector<int>::const_iterator it = vec.begin();
+    EXPECT_EQ( *it, -1 );
+}
+
+TEST(ConcurrentVector, ConcurrentAppends)
+{
+    const size_t threads = 8;
+    const size_t per_thread = 20000;
+    sc::concurrent_vector<size_t> vec;
+
+    std::vector<std::thread> workers;
+    for( size_t t{0u} ; t < threads ; ++t )
+        workers.emplace_back( [&vec, t, per_thread]() {
+            for( size_t i{0u} ; i < per_thread ; ++i )
+            {
+                if( i % 100 == 0 )
+                {
+                    size_t first = vec.grow_by( 10, t * per_thread + i );
+                    EXPECT_EQ( vec[first + 9], t * per_thread + i );
+                }
+                size_t index = vec.push_back( t * per_thread + i );
+                EXPECT_EQ( vec[index], t * per_thread + i );
+            }
+        } );
+    for( auto & worker : workers )
+        worker.join();
+
+    ASSERT_EQ( vec.size(), threads * per_thread + threads * ( per_thread / 100 ) * 10 );
+
+    // Every value pushed by push_back shows up once; grow_by added ten more of every hundredth.
+    std::vector<size_t> seen( threads * per_thread, 0 );
+    for( size_t v : vec )
+        seen[v]++;
+    for( size_t v{0u} ; v < seen.size() ; ++v )
+        ASSERT_EQ( seen[v], v % per_thread % 100 == 0 ? 11u : 1u );
+}
+
+TEST(ConcurrentVector, ConcurrentReserve)
+{
+    sc::concurrent_vector<int> vec;
+    std::vector<std::thread> workers;
+    for( int t{0} ; t < 4 ; ++t )
+        workers.emplace_back( [&vec]() { vec.reserve( 100000 ); } );
+    for( auto & worker : workers )
+        worker.join();
+
+    EXPECT_GE( vec.capacity(), 100000u );
+    EXPECT_EQ( vec.size(), 0u );
+}
+
+TEST(ConcurrentVector, ThrowingConstructorLeavesEmptySlot)
+{
+    sc::concurrent_vector<Picky> vec;
+    vec.push_back( Picky( 1 ) );
+    EXPECT_THROW( vec.push_back( Picky( -1 ) ), std::runtime_error );
+    vec.push_back( Picky( 3 ) );
+
+    std::vector<Picky> source{ Picky( 4 ), Picky( 5 ), Picky( 6 ) };
+    source[1].value = -5;
+    EXPECT_THROW( vec.grow_by( source.begin(), source.end() ), std::runtime_error );
+    ASSERT_EQ( vec.size(), 6u );
+    EXPECT_EQ( vec[3].value, 4 );
+
+    // The copy leaves the empty slots out.
+    sc::concurrent_vector<Picky> copy( vec );
+    ASSERT_EQ( copy.size(), 3u );
+    EXPECT_EQ( copy[0].value, 1 );
+    EXPECT_EQ( copy[1].value, 3 );
+    EXPECT_EQ( copy[2].value, 4 );
+}
+
+TEST(ConcurrentVector, FailedSegmentLeavesEmptySlots)
+{
+    typedef BudgetAllocator<std::string> Alloc;
+    Alloc::budget = 1;
+    {
+        sc::concurrent_vector<std::string, Alloc> vec;
+        const std::string text( 40, 'x' );
+        size_t pushed = 0;
+        try {
+            for( ; pushed < 100 ; ++pushed )
+                vec.push_back( text );
+        }
+        catch( const std::bad_alloc & ) {}
+        ASSERT_EQ( pushed, sc::concurrent_vector<std::string>::first_segment );
+        EXPECT_THROW( vec.grow_by( 3, text ), std::bad_alloc );
+        ASSERT_EQ( vec.size(), pushed + 4 );
+
+        // The destructor and the copy skip the claimed slots, whose segment does not exist.
+        sc::concurrent_vector<std::string, Alloc> copy;
+        Alloc::budget = -1;
+        copy = vec;
+        EXPECT_EQ( copy.size(), pushed );
+        EXPECT_EQ( copy[pushed - 1], text );
+
+        vec.push_back( "after" );
+        EXPECT_EQ( vec[pushed + 4], "after" );
+    }
+    Alloc::budget = -1;
+}
+
+TEST(ConcurrentVector, CopyMoveAndClear)
+{
+    sc::concurrent_vector<std::string> vec( 100, "x" );
+    sc::concurrent_vector<std::string> copy( vec );
+    EXPECT_EQ( copy.size(), 100u );
+    EXPECT_EQ( copy[99], "x" );
+
+    sc::concurrent_vector<std::string> moved( std::move( copy ) );
+    EXPECT_EQ( moved.size(), 100u );
+    EXPECT_EQ( copy.size(), 0u );
+
+    copy = moved;
+    EXPECT_EQ( copy.size(), 100u );
+
+    size_t capacity = moved.capacity();
+    moved.clear();
+    EXPECT_TRUE( moved.empty() );
+    EXPECT_EQ( moved.capacity(), capacity );
+    moved.push_back( "y" );
+    EXPECT_EQ( moved[0], "y" );
+}
@@ -0,0 +1,180 @@
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "flat_map.h"           // header file for tested functions
+
+
+// ============================================================================
+// TESTING SORTED VECTOR AND FLAT MAP
+// ============================================================================
+
+TEST(SortedVector, InsertFindErase)
+{
+    sc::sorted_vector<int> set{ 5, 1, 4, 1, 3 };
+    EXPECT_EQ( set.items(), ( sc::vector<int>{ 1, 3, 4, 5 } ) );
+
+    auto inserted = set.insert( 2 );
+    EXPECT_TRUE( inserted.second );
+    EXPECT_EQ( *inserted.first, 2 );
+    inserted = set.insert( 4 );
+    EXPECT_FALSE( inserted.second );
+    EXPECT_EQ( inserted.first - set.begin(), 3 );
+
+    EXPECT_TRUE( set.contains( 3 ) );
+    EXPECT_EQ( set.count( 6 ), 0u );
+    EXPECT_TRUE( set.find( 6 ) == set.end() );
+    EXPECT_EQ( *set.lower_bound( 0 ), 1 );
+    EXPECT_TRUE( set.upper_bound( 5 ) == set.end() );
+    EXPECT_EQ( *set.upper_bound( 3 ), 4 );
+
+    EXPECT_EQ( set.erase( 3 ), 1u );
+    EXPECT_EQ( set.erase( 3 ), 0u );
+    auto next = set.erase( set.find( 1 ) );
+    EXPECT_EQ( *next, 2 );
+    EXPECT_EQ( set.items(), ( sc::vector<int>{ 2, 4, 5 } ) );
+
+    // Descending order.
+    sc::sorted_vector< int, std::greater<int> > down{ 1, 3, 2 };
+    EXPECT_EQ( down.items(), ( sc::vector<int>{ 3, 2, 1 } ) );
+}
+
+TEST(SortedVector, InsertBatchMatchesStdSet)
+{
+    std::mt19937 gen( 5 );
+    sc::sorted_vector<int> flat;
+    std::set<int> reference;
+
+    for( int round = 0 ; round < 50 ; ++round )
+    {
+        std::vector<int> batch;
+        int count = (int) ( gen() % 200 );
+        for( int i = 0 ; i < count ; ++i )
+            batch.push_back( (int) ( gen() % 5000 ) );
+
+        size_t before = reference.size();
+        reference.insert( batch.begin(), batch.end() );
+        EXPECT_EQ( flat.insert_batch( batch.begin(), batch.end() ), reference.size() - before );
+        ASSERT_TRUE( std::equal( flat.begin(), flat.end(), reference.begin() ) );
+        ASSERT_EQ( flat.size(), reference.size() );
+    }
+
+    // Keys past the last one are appended.
+    int last = *( flat.end() - 1 );
+    EXPECT_EQ( flat.insert_batch( { last + 2, last + 1, last + 2 } ), 2u );
+    EXPECT_EQ( *( flat.end() - 1 ), last + 2 );
+}
+
+TEST(FlatMap, Access)
+{
+    sc::flat_map<std::string, int> map{ { "b", 2 }, { "a", 1 }, { "b", 20 } };
+    ASSERT_EQ( map.size(), 2u );
+    EXPECT_EQ( map.at( "b" ), 2 );
+    EXPECT_THROW( map.at( "z" ), std::out_of_range );
+
+    map["c"] += 3;
+    map["a"] += 10;
+    EXPECT_EQ( map.at( "c" ), 3 );
+    EXPECT_EQ( map.at( "a" ), 11 );
+
+    auto result = map.insert( std::make_pair( std::string( "a" ), 0 ) );
+    EXPECT_FALSE( result.second );
+    EXPECT_EQ( result.first->second, 11 );
+    result = map.insert_or_assign( "a", 0 );
+    EXPECT_FALSE( result.second );
+    EXPECT_EQ( map.at( "a" ), 0 );
+    result = map.insert_or_assign( "aa", 5 );
+    EXPECT_TRUE( result.second );
+    EXPECT_EQ( ( result.first - 1 )->first, "a" );
+
+    map.find( "b" )->second = 7;
+    const auto & view = map;
+    EXPECT_EQ( view.find( "b" )->second, 7 );
+    EXPECT_EQ( view.at( "b" ), 7 );
+
+    map.erase( map.find( "aa" ) );
+    EXPECT_EQ( map.erase( "c" ), 1u );
+    std::vector< std::pair<std::string, int> > expected{ { "a", 0 }, { "b", 7 } };
+    EXPECT_TRUE( std::equal( map.begin(), map.end(), expected.begin() ) );
+}
+
+TEST(FlatMap, BatchesMatchStdMap)
+{
+    std::mt19937 gen( 9 );
+    sc::flat_map<int, std::string> flat;
+    std::map<int, std::string> reference;
+
+    for( int round = 0 ; round < 40 ; ++round )
+    {
+        std::vector< std::pair<int, std::string> > batch;
+        int count = (int) ( gen() % 300 );
+        for( int i = 0 ; i < count ; ++i )
+            batch.emplace_back( (int) ( gen() % 2000 ), std::to_string( round ) + "." + std::to_string( i ) );
+
+        size_t before = reference.size();
+        if( round % 2 == 0 )
+        {
+            // The first pair of a key wins, and keys already there keep their value.
+            for( auto & p : batch )
+                reference.insert( p );
+            EXPECT_EQ( flat.insert_batch( batch.begin(), batch.end() ), reference.size() - before );
+        }
+        else
+        {
+            // The last pair of a key wins, over the values already there too.
+            for( auto & p : batch )
+                reference[p.first] = p.second;
+            EXPECT_EQ( flat.insert_or_assign_batch( batch.begin(), batch.end() ), reference.size() - before );
+        }
+
+        ASSERT_EQ( flat.size(), reference.size() );
+        auto it = reference.begin();
+        for( const auto & p : flat )
+        {
+            ASSERT_EQ( p.first, it->first );
+            ASSERT_EQ( p.second, it->second );
+            ++it;
+        }
+    }
+}
+
+namespace {
+
+    /// Value whose copies throw, while armed, if it holds 30. It has no move constructor, so the
+    /// merge copies the elements of the map.
+    struct Fragile
+    {
+        int value;
+        static bool armed;
+
+        Fragile( int v = 0 ) : value{v} {}
+        Fragile( const Fragile & other ) : value{other.value}
+        {
+            if( armed and value == 30 )
+                throw std::runtime_error( "copy" );
+        }
+        Fragile & operator=( const Fragile & ) = default;
+    };
+
+    bool Fragile::armed = false;
+}
+
+TEST(FlatMap, ThrowingMergeLeavesTheMap)
+{
+    sc::flat_map<int, Fragile> map{ { 1, Fragile( 10 ) }, { 3, Fragile( 30 ) } };
+    std::vector< std::pair<int, Fragile> > batch{ { 2, Fragile( 20 ) } };
+
+    Fragile::armed = true;
+    EXPECT_THROW( map.insert_batch( batch.begin(), batch.end() ), std::runtime_error );
+    Fragile::armed = false;
+
+    ASSERT_EQ( map.size(), 2u );
+    EXPECT_EQ( map.at( 1 ).value, 10 );
+    EXPECT_EQ( map.at( 3 ).value, 30 );
+    EXPECT_FALSE( map.contains( 2 ) );
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"        // gtest lib
+#include "vector.h"             // header file for tested functions
+#include "small_vector.h"
+
+
+// ============================================================================
+// TESTING GROWTH POLICIES
+// ============================================================================
+
+namespace {
+    // Grows by 10 elements at a time.
+    size_t by_ten( size_t capacity, size_t, size_t )
+    { return capacity + 10; }
+}
+
+TEST(Growth, Doubling)
+{
+    EXPECT_EQ( sc::growth::doubling::grow( 0, 1, 4 ), 1u );
+    EXPECT_EQ( sc::growth::doubling::grow( 8, 9, 4 ), 16u );
+    EXPECT_EQ( sc::growth::doubling::grow( 8, 40, 4 ), 40u );
+}
+
+TEST(Growth, FactorOneAndHalf)
+{
+    EXPECT_EQ( sc::growth::factor_1_5::grow( 0, 1, 4 ), 1u );
+    EXPECT_EQ( sc::growth::factor_1_5::grow( 100, 101, 4 ), 151u );
+    EXPECT_EQ( sc::growth::factor_1_5::grow( 100, 400, 4 ), 400u );
+}
+
+TEST(Growth, SizeClass)
+{
+    typedef sc::growth::size_class<> policy;
+
+    EXPECT_EQ( policy::round_up( 1 ), 16u );
+    EXPECT_EQ( policy::round_up( 17 ), 20u );
+    EXPECT_EQ( policy::round_up( 100 ), 112u );
+    EXPECT_EQ( policy::round_up( 1024 ), 1024u );
+    EXPECT_EQ( policy::round_up( 1025 ), 1280u );
+    EXPECT_EQ( policy::round_up( 5 * 4096 + 1 ), 6 * 4096u );
+
+    // 1.5 * 10 + 1 = 16 ints = 64 bytes, a size class already.
+    EXPECT_EQ( policy::grow( 10, 11, 4 ), 16u );
+    // 1.5 * 20 + 1 = 31 ints = 124 bytes, rounded to 128.
+    EXPECT_EQ( policy::grow( 20, 21, 4 ), 32u );
+}
+
+TEST(Growth, LinearAbove)
+{
+    typedef sc::growth::linear_above< 1024, 256 > policy;
+
+    EXPECT_EQ( policy::grow( 100, 101, 4 ), 200u );
+    EXPECT_EQ( policy::grow( 256, 257, 4 ), 320u );
+    EXPECT_EQ( policy::grow( 1000, 1001, 4 ), 1064u );
+}
+
+TEST(Growth, VectorUsesPolicy)
+{
+    sc::vector<int, std::allocator<int>, sc::growth::factor_1_5> vec;
+    std::vector<size_t> capacities;
+
+    for( auto i{0} ; i < 100 ; ++i )
+    {
+        if( vec.capacity() == vec.size() )
+            capacities.push_back( vec.capacity() );
+        vec.push_back( i );
+    }
+
+    std::vector<size_t> expected{ 0, 1, 2, 4, 7, 11, 17, 26, 40, 61, 92 };
+    EXPECT_EQ( capacities, expected );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], (int) i );
+}
+
+TEST(Growth, UserFunction)
+{
+    sc::vector<int, std::allocator<int>, sc::growth::function<by_ten>> vec;
+
+    for( auto i{0} ; i < 25 ; ++i )
+        vec.push_back( i );
+    EXPECT_EQ( vec.capacity(), 30u );
+
+    for( auto i{0} ; i < 25 ; ++i )
+        vec.push_front( i );
+    EXPECT_EQ( vec.size(), 50u );
+    EXPECT_EQ( vec.front(), 24 );
+    EXPECT_EQ( vec.back(), 24 );
+}
+
+TEST(Growth, ListAssign)
+{
+    sc::vector<int> vec;
+
+    vec = { 1, 2, 3, 4, 5 };
+    EXPECT_EQ( vec.capacity(), 5u );
+
+    sc::small_vector<int, 2, std::allocator<int>, sc::growth::factor_1_5> small{ 1, 2 };
+    small.push_back( 3 );
+    EXPECT_EQ( small.capacity(), 4u );
+}
@@ -0,0 +1,158 @@
+#include <string>
+#include <cstdint>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "memory_resource.h"    // header file for tested functions
+#include "small_vector.h"
+
+
+// ============================================================================
+// TESTING MEMORY RESOURCES
+// ============================================================================
+
+namespace {
+    // Resource that counts what goes through it.
+    class counting_resource : public sc::pmr::memory_resource
+    {
+        public:
+            long allocations = 0;
+            long bytes = 0;
+
+        protected:
+            void * do_allocate( size_t n, size_t alignment ) override
+            {
+                allocations++;
+                bytes += n;
+                return sc::pmr::new_delete_resource()->allocate( n, alignment );
+            }
+
+            void do_deallocate( void * p, size_t n, size_t alignment ) override
+            {
+                bytes -= n;
+                sc::pmr::new_delete_resource()->deallocate( p, n, alignment );
+            }
+    };
+}
+
+TEST(MemoryResource, NewDeleteOverAligned)
+{
+    auto * resource = sc::pmr::new_delete_resource();
+
+    void * p = resource->allocate( 100, 256 );
+    EXPECT_EQ( reinterpret_cast<std::uintptr_t>( p ) % 256, 0u );
+    resource->deallocate( p, 100, 256 );
+
+    EXPECT_TRUE( *resource == *sc::pmr::new_delete_resource() );
+}
+
+TEST(MemoryResource, MonotonicArena)
+{
+    counting_resource upstream;
+    {
+        sc::pmr::monotonic_buffer_resource arena( 4096, &upstream );
+
+        for( auto round{0} ; round < 100 ; ++round )
+        {
+            sc::pmr::vector<int> vec( &arena );
+            for( auto i{0} ; i < 10 ; ++i )
+                vec.push_back( i );
+            ASSERT_EQ( vec[9], 9 );
+        }
+
+        // A hundred vectors and their growths came from a few chunks.
+        EXPECT_LE( upstream.allocations, 4 );
+        EXPECT_GT( upstream.bytes, 0 );
+
+        arena.release();
+        EXPECT_EQ( upstream.bytes, 0 );
+
+        sc::pmr::vector<std::string> strings( &arena );
+        strings.emplace_back( "after release" );
+        EXPECT_EQ( strings[0], "after release" );
+    }
+    EXPECT_EQ( upstream.bytes, 0 );
+}
+
+TEST(MemoryResource, MonotonicInitialBuffer)
+{
+    counting_resource upstream;
+    alignas(16) char buffer[1024];
+    sc::pmr::monotonic_buffer_resource arena( buffer, sizeof(buffer), &upstream );
+
+    sc::pmr::vector<long> vec( &arena );
+    vec.reserve( 64 );
+    EXPECT_EQ( upstream.allocations, 0 );
+    EXPECT_GE( (void*) &vec[0], (void*) buffer );
+    EXPECT_LT( (void*) &vec[0], (void*) ( buffer + sizeof(buffer) ) );
+
+    vec.reserve( 1000 );
+    EXPECT_EQ( upstream.allocations, 1 );
+
+    void * aligned = arena.allocate( 8, 64 );
+    EXPECT_EQ( reinterpret_cast<std::uintptr_t>( aligned ) % 64, 0u );
+}
+
+TEST(MemoryResource, PoolReusesBlocks)
+{
+    counting_resource upstream;
+    {
+        sc::pmr::unsynchronized_pool_resource pool( &upstream );
+
+        for( auto round{0} ; round < 1000 ; ++round )
+        {
+            sc::pmr::vector<int> vec( &pool );
+            for( auto i{0} ; i < 100 ; ++i )
+                vec.push_back( i );
+            ASSERT_EQ( vec.size(), 100 );
+        }
+        // Every growth step reused a block of the pools.
+        EXPECT_LE( upstream.allocations, 8 );
+
+        // Large requests go upstream and come back one by one.
+        long before = upstream.bytes;
+        {
+            sc::pmr::vector<char> big( &pool );
+            big.reserve( 100000 );
+            EXPECT_GT( upstream.bytes, before + 100000 );
+        }
+        EXPECT_EQ( upstream.bytes, before );
+    }
+    EXPECT_EQ( upstream.bytes, 0 );
+}
+
+TEST(MemoryResource, ResourceStaysWithVector)
+{
+    sc::pmr::monotonic_buffer_resource arena;
+    sc::pmr::vector<int> vec( &arena );
+    vec = { 1, 2, 3 };
+
+    // A copy uses the default resource, a move keeps the storage and the resource.
+    sc::pmr::vector<int> copy( vec );
+    EXPECT_EQ( copy.get_allocator().resource(), sc::pmr::new_delete_resource() );
+
+    sc::pmr::vector<int> moved( std::move( vec ) );
+    EXPECT_EQ( moved.get_allocator().resource(), &arena );
+    ASSERT_EQ( moved.size(), 3 );
+
+    // Assignment between resources copies the elements.
+    copy = std::move( moved );
+    EXPECT_EQ( copy.get_allocator().resource(), sc::pmr::new_delete_resource() );
+    ASSERT_EQ( copy.size(), 3 );
+    EXPECT_EQ( copy[2], 3 );
+}
+
+TEST(MemoryResource, SmallVectorSpillsToArena)
+{
+    counting_resource upstream;
+    sc::pmr::monotonic_buffer_resource arena( 1024, &upstream );
+    sc::small_vector<int, 4, sc::pmr::polymorphic_allocator<int>> vec( &arena );
+
+    for( auto i{0} ; i < 4 ; ++i )
+        vec.push_back( i );
+    EXPECT_EQ( upstream.allocations, 0 );
+
+    vec.push_back( 4 );
+    EXPECT_FALSE( vec.is_inline() );
+    EXPECT_EQ( upstream.allocations, 1 );
+    EXPECT_EQ( vec[4], 4 );
+}
@@ -0,0 +1,211 @@
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <numeric>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include <unistd.h>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "mmap_vector.h"        // header file for tested functions
+
+
+// ============================================================================
+// TESTING MMAP VECTOR
+// ============================================================================
+
+namespace {
+    struct Point
+    {
+        double x, y;
+        int id;
+    };
+
+    /// Path of a scratch file, removed when the test ends.
+    struct scratch_file
+    {
+        std::string path;
+        scratch_file( const char * name )
+            : path{ std::string( "/tmp/sc_mmap_" ) + name + "_" + std::to_string( ::getpid() ) }
+        { std::remove( path.c_str() ); }
+        ~scratch_file( )
+        { std::remove( path.c_str() ); }
+    };
+
+    /// Growth policy that ignores the required capacity: grows by 4 elements.
+    struct by_four
+    {
+        static size_t grow( size_t capacity, size_t, size_t )
+        { return capacity + 4; }
+    };
+}
+
+TEST(MmapVector, PushBackAndIndex)
+{
+    scratch_file file( "push" );
+    sc::mmap_vector<int> vec( file.path );
+    EXPECT_TRUE( vec.empty() );
+
+    for( int i{0} ; i < 10000 ; ++i )
+        vec.push_back( i * 3 );
+
+    ASSERT_EQ( vec.size(), 10000u );
+    EXPECT_GE( vec.capacity(), 10000u );
+    EXPECT_EQ( vec[1234], 3702 );
+    EXPECT_EQ( vec.front(), 0 );
+    EXPECT_EQ( vec.back(), 29997 );
+    EXPECT_THROW( vec.at( 10000 ), std::out_of_range );
+
+    long sum = std::accumulate( vec.begin(), vec.end(), 0L );
+    EXPECT_EQ( sum, 3L * 9999 * 10000 / 2 );
+
+    vec.pop_back();
+    EXPECT_EQ( vec.size(), 9999u );
+}
+
+TEST(MmapVector, ContentsPersist)
+{
+    scratch_file file( "persist" );
+    {
+        sc::mmap_vector<Point> vec( file.path );
+        for( int i{0} ; i < 5000 ; ++i )
+            vec.emplace_back( Point{ i * 0.5, -i * 1.0, i } );
+        vec[42].id = -42;
+    }
+
+    sc::mmap_vector<Point> again( file.path );
+    ASSERT_EQ( again.size(), 5000u );
+    EXPECT_EQ( again[42].id, -42 );
+    EXPECT_EQ( again[4999].x, 4999 * 0.5 );
+
+    again.push_back( Point{ 1, 2, 3 } );
+    EXPECT_EQ( again.size(), 5001u );
+
+    sc::mmap_vector<Point> reader( file.path, sc::mmap_vector<Point>::read_only );
+    EXPECT_EQ( reader.size(), 5001u );
+    EXPECT_EQ( reader.back().id, 3 );
+    EXPECT_THROW( reader.push_back( Point{ 0, 0, 0 } ), std::logic_error );
+}
+
+TEST(MmapVector, ReserveGrowsTheFile)
+{
+    scratch_file file( "reserve" );
+    sc::mmap_vector<uint64_t> vec( file.path );
+    vec.resize( 10, 7 );
+    vec.reserve( 1 << 20 );
+    EXPECT_EQ( vec.capacity(), 1u << 20 );
+    EXPECT_EQ( vec.size(), 10u );
+    EXPECT_EQ( vec[9], 7u );
+
+    std::ifstream in( file.path, std::ios::binary | std::ios::ate );
+    EXPECT_EQ( (size_t) in.tellg(), 64 + ( 8u << 20 ) );
+
+    vec.shrink_to_fit();
+    EXPECT_EQ( vec.capacity(), 10u );
+    in.close();
+    in.open( file.path, std::ios::binary | std::ios::ate );
+    EXPECT_EQ( (size_t) in.tellg(), 64 + 80u );
+    vec.sync();
+}
+
+TEST(MmapVector, GrowsToTheRequiredCapacity)
+{
+    scratch_file file( "growth" );
+    sc::mmap_vector<int, by_four> vec( file.path );
+
+    // The policy answers less than a range needs: the file grows to fit it anyway.
+    std::vector<int> values( 1000 );
+    std::iota( values.begin(), values.end(), 0 );
+    vec.push_back( values.begin(), values.end() );
+    ASSERT_EQ( vec.size(), 1000u );
+    EXPECT_GE( vec.capacity(), 1000u );
+    EXPECT_EQ( vec[999], 999 );
+
+    for( int i{1000} ; i < 1010 ; ++i )
+        vec.push_back( i );
+    EXPECT_GE( vec.capacity(), 1010u );
+    EXPECT_EQ( std::accumulate( vec.begin(), vec.end(), 0L ), 1009L * 1010 / 2 );
+}
+
+TEST(MmapVector, AppendsItsOwnElements)
+{
+    scratch_file file( "self" );
+    sc::mmap_vector<long> vec( file.path );
+    for( long i{0} ; i < 1000000 ; ++i )
+        vec.push_back( i );
+    vec.shrink_to_fit();
+
+    // The range lies in the mapping, which the growth of the file remaps.
+    vec.push_back( vec.begin(), vec.end() );
+    ASSERT_EQ( vec.size(), 2000000u );
+    EXPECT_EQ( vec[1000000], 0 );
+    EXPECT_EQ( vec[1999999], 999999 );
+
+    vec.shrink_to_fit();
+    vec.push_back( vec.begin() + 10, vec.begin() + 20 );
+    ASSERT_EQ( vec.size(), 2000010u );
+    EXPECT_EQ( vec[2000000], 10 );
+    EXPECT_EQ( vec.back(), 19 );
+}
+
+TEST(MmapVector, Bools)
+{
+    // One byte per flag, as laid out in memory: the iterators are pointers into the mapping.
+    scratch_file file( "bools" );
+    {
+        sc::mmap_vector<bool> flags( file.path );
+        for( int i{0} ; i < 1000 ; ++i )
+            flags.push_back( i % 7 == 0 );
+        const bool * first = flags.begin();
+        EXPECT_EQ( first, flags.data() );
+        EXPECT_EQ( std::count( flags.begin(), flags.end(), true ), 143 );
+    }
+
+    sc::mmap_vector<bool> flags( file.path, sc::mmap_vector<bool>::read_only );
+    ASSERT_EQ( flags.size(), 1000u );
+    EXPECT_TRUE( flags[994] );
+    EXPECT_FALSE( flags[995] );
+}
+
+TEST(MmapVector, TruncateAndRange)
+{
+    scratch_file file( "truncate" );
+    {
+        sc::mmap_vector<int> vec( file.path );
+        vec.resize( 100 );
+    }
+
+    sc::mmap_vector<int> vec( file.path, sc::mmap_vector<int>::truncate );
+    EXPECT_EQ( vec.size(), 0u );
+
+    int source[] = { 1, 2, 3, 4 };
+    vec.push_back( source, source + 4 );
+    vec.push_back( source, source + 4 );
+    ASSERT_EQ( vec.size(), 8u );
+    EXPECT_EQ( vec[5], 2 );
+
+    sc::mmap_vector<int> moved( std::move( vec ) );
+    EXPECT_EQ( moved.size(), 8u );
+    EXPECT_EQ( vec.size(), 0u );
+}
+
+TEST(MmapVector, RejectsOtherFiles)
+{
+    scratch_file file( "other" );
+    EXPECT_THROW( sc::mmap_vector<int>( file.path, sc::mmap_vector<int>::read_only ), std::system_error );
+
+    {
+        sc::mmap_vector<int> vec( file.path );
+        vec.push_back( 1 );
+    }
+    EXPECT_THROW( sc::mmap_vector<double>( file.path ), std::runtime_error );
+
+    {
+        std::ofstream out( file.path, std::ios::binary | std::ios::trunc );
+        out << std::string( 100, 'x' );
+    }
+    EXPECT_THROW( sc::mmap_vector<int>( file.path ), std::runtime_error );
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "packed_int_vector.h"  // header file for tested functions
+
+
+// ============================================================================
+// TESTING PACKED INTEGER VECTOR
+// ============================================================================
+
+namespace {
+
+    /// Checks list against reference through operator[], the iterators and for_each().
+    template< typename List, typename T >
+    void expect_same( const List & list, const std::vector<T> & reference )
+    {
+        ASSERT_EQ( list.size(), reference.size() );
+        for( size_t i = 0 ; i < reference.size() ; ++i )
+            ASSERT_EQ( list[i], reference[i] ) << "at " << i;
+        EXPECT_TRUE( std::equal( list.begin(), list.end(), reference.begin() ) );
+
+        std::vector<T> visited;
+        list.for_each( [&visited]( T value ) { visited.push_back( value ); } );
+        EXPECT_EQ( visited, reference );
+    }
+
+    /// Fills both packings with values drawn by draw and checks them.
+    template< typename T, typename Draw >
+    void round_trip( Draw draw )
+    {
+        std::mt19937_64 gen( sizeof(T) );
+        std::vector<T> reference;
+        for( int i = 0 ; i < 1300 ; ++i )
+            reference.push_back( draw( gen, i ) );
+
+        sc::packed_int_vector<T> frame( reference.begin(), reference.end() );
+        sc::packed_int_vector<T, sc::packing::delta> delta( reference.begin(), reference.end() );
+        expect_same( frame, reference );
+        expect_same( delta, reference );
+    }
+}
+
+TEST(PackedIntVector, RoundTripsEveryType)
+{
+    // Any value, the extremes included.
+    auto any = []( std::mt19937_64 & gen, int i ) -> uint64_t
+    {
+        if( i % 97 == 0 )
+            return i % 2 ? ~uint64_t(0) : 0;
+        return gen();
+    };
+    round_trip<int8_t>( any );
+    round_trip<uint16_t>( any );
+    round_trip<int32_t>( any );
+    round_trip<uint32_t>( any );
+    round_trip<int64_t>( any );
+    round_trip<uint64_t>( any );
+
+    // Small values around zero, then sorted ones crossing the sign.
+    round_trip<int64_t>( []( std::mt19937_64 & gen, int ) { return (int64_t) ( gen() % 21 ) - 10; } );
+    round_trip<int32_t>( []( std::mt19937_64 & gen, int i ) { return i * 1000 - 600000 + (int) ( gen() % 50 ); } );
+    round_trip<int64_t>( []( std::mt19937_64 &, int i ) { return std::numeric_limits<int64_t>::min() + i * ( int64_t(1) << 53 ); } );
+    round_trip<uint64_t>( []( std::mt19937_64 &, int i ) { return ~uint64_t(0) - 1299 + i; } );
+}
+
+TEST(PackedIntVector, CompressesNarrowValues)
+{
+    // Millisecond timestamps, 1 to 64 ms apart: a block spans about 20 bits.
+    std::mt19937_64 gen( 1 );
+    std::vector<uint64_t> stamps;
+    uint64_t now = 1700000000000u;
+    for( int i = 0 ; i < 256 * 400 ; ++i )
+        stamps.push_back( now += 1 + gen() % 64 );
+
+    sc::packed_int_vector<uint64_t> frame( stamps.begin(), stamps.end() );
+    sc::packed_int_vector<uint64_t, sc::packing::delta> delta( stamps.begin(), stamps.end() );
+    frame.shrink_to_fit();
+    delta.shrink_to_fit();
+    expect_same( frame, stamps );
+    expect_same( delta, stamps );
+
+    size_t plain = stamps.size() * sizeof(uint64_t);
+    EXPECT_LT( frame.storage_bytes() * 3, plain );
+    EXPECT_LT( delta.storage_bytes(), frame.storage_bytes() );
+
+    // Values on the line of their block take no bit at all.
+    sc::packed_int_vector<uint32_t, sc::packing::delta> ids;
+    for( uint32_t i = 0 ; i < 256 * 100 ; ++i )
+        ids.push_back( 5000 + 3 * i );
+    ids.shrink_to_fit();
+    EXPECT_LT( ids.storage_bytes(), 100 * 64u );
+    EXPECT_EQ( ids[12345], 5000u + 3 * 12345 );
+}
+
+TEST(PackedIntVector, PushAndPopAcrossBlocks)
+{
+    sc::packed_int_vector<int> list;
+    std::vector<int> reference;
+    EXPECT_TRUE( list.empty() );
+
+    std::mt19937 gen( 8 );
+    for( int round = 0 ; round < 30 ; ++round )
+    {
+        int pushes = (int) ( gen() % 700 ), pops = (int) ( gen() % 700 );
+        for( int i = 0 ; i < pushes ; ++i )
+        {
+            int value = (int) ( gen() % 100000 ) - 50000;
+            list.push_back( value );
+            reference.push_back( value );
+        }
+        for( int i = 0 ; i < pops and not reference.empty() ; ++i )
+        {
+            list.pop_back();
+            reference.pop_back();
+        }
+        expect_same( list, reference );
+    }
+
+    if( not reference.empty() )
+    {
+        EXPECT_EQ( list.front(), reference.front() );
+        EXPECT_EQ( list.back(), reference.back() );
+    }
+    EXPECT_THROW( list.at( list.size() ), std::out_of_range );
+
+    list.clear();
+    EXPECT_TRUE( list.empty() );
+    list.push_back( 7 );
+    EXPECT_EQ( list.at( 0 ), 7 );
+}
+
+TEST(PackedIntVector, RandomAccessIterators)
+{
+    std::vector<uint32_t> sorted( 3000 );
+    for( uint32_t i = 0 ; i < sorted.size() ; ++i )
+        sorted[i] = i * 7 + i % 5;
+    sc::packed_int_vector<uint32_t, sc::packing::delta> list( sorted.begin(), sorted.end() );
+
+    // Binary search jumps from block to block.
+    for( uint32_t value : { 0u, 700u, 701u, 14000u, 20995u, 30000u } )
+    {
+        auto it = std::lower_bound( list.begin(), list.end(), value );
+        auto expected = std::lower_bound( sorted.begin(), sorted.end(), value );
+        EXPECT_EQ( it - list.begin(), expected - sorted.begin() );
+    }
+
+    auto it = list.end();
+    --it;
+    EXPECT_EQ( *it, sorted.back() );
+    EXPECT_EQ( list.begin()[1000], sorted[1000] );
+    EXPECT_EQ( *( 2 + list.begin() ), sorted[2] );
+    EXPECT_EQ( std::accumulate( list.begin(), list.end(), uint64_t(0) ),
+               std::accumulate( sorted.begin(), sorted.end(), uint64_t(0) ) );
+
+    sc::packed_int_vector<uint32_t, sc::packing::delta> copy( list );
+    EXPECT_TRUE( copy == list );
+    copy.pop_back();
+    EXPECT_TRUE( copy != list );
+    sc::packed_int_vector<uint32_t> short_list{ 1, 2, 3 };
+    EXPECT_EQ( short_list.size(), 3u );
+}
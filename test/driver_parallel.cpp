@@ -0,0 +1,185 @@
+#include <string>
+#include <numeric>
+#include <thread>
+#include <mutex>
+#include <set>
+#include <cstdint>
+#include <stdexcept>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "parallel.h"           // header file for tested functions
+
+
+// ============================================================================
+// TESTING PARALLEL ALGORITHMS
+// ============================================================================
+
+namespace {
+    const size_t big = 1 << 20; // Well above the threshold.
+
+    sc::vector<long> iota( size_t n )
+    {
+        sc::vector<long> vec;
+        vec.reserve( n );
+        for( size_t i{0u} ; i < n ; ++i )
+            vec.push_back( (long) i );
+        return vec;
+    }
+}
+
+TEST(Parallel, ChunksOnCacheLines)
+{
+    alignas(64) static int data[100000];
+    const int * p = data + 3;
+
+    auto bounds = sc::parallel::chunk_bounds( p, 99990, 16 );
+    ASSERT_GE( bounds.size(), 3u );
+    EXPECT_EQ( bounds.front(), 0u );
+    EXPECT_EQ( bounds.back(), 99990u );
+    for( size_t i{1u} ; i + 1 < bounds.size() ; ++i )
+    {
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>( p + bounds[i] ) % 64, 0u );
+        EXPECT_GT( bounds[i], bounds[i-1] );
+    }
+
+    // A chunk holds at least min_chunk elements.
+    EXPECT_EQ( sc::parallel::chunk_bounds( p, 5000, 16 ).size(), 3u );
+}
+
+TEST(Parallel, ForEachAndTransform)
+{
+    sc::parallel::thread_pool pool( 4 );
+    sc::parallel::execution exec( &pool );
+    auto vec = iota( big );
+
+    sc::parallel::for_each( vec, []( long & x ) { x *= 2; }, exec );
+    sc::parallel::transform( vec, []( long x ) { return x + 1; }, exec );
+    for( size_t i{0u} ; i < big ; ++i )
+        ASSERT_EQ( vec[i], (long) ( 2 * i + 1 ) );
+
+    sc::vector<std::string> text;
+    sc::parallel::transform( vec, text, []( long x ) { return std::to_string( x ); }, exec );
+    ASSERT_EQ( text.size(), big );
+    EXPECT_EQ( text[0], "1" );
+    EXPECT_EQ( text[big - 1], std::to_string( 2 * big - 1 ) );
+}
+
+TEST(Parallel, Reduce)
+{
+    sc::parallel::thread_pool pool( 3 );
+    sc::parallel::execution exec( &pool );
+    auto vec = iota( big + 7 );
+
+    long n = (long) vec.size();
+    EXPECT_EQ( sc::parallel::reduce( vec, 0L, exec ), n * ( n - 1 ) / 2 );
+    EXPECT_EQ( sc::parallel::reduce( vec, 5L, []( long a, long b ) { return a > b ? a : b; }, exec ), n - 1 );
+
+    // Not commutative: the chunks are combined in order.
+    sc::vector<std::string> words;
+    for( size_t i{0u} ; i < 50000 ; ++i )
+        words.push_back( std::string( 1, char( 'a' + i % 26 ) ) );
+    std::string joined = sc::parallel::reduce( words, std::string( ">" ), exec );
+    ASSERT_EQ( joined.size(), 50001u );
+    EXPECT_EQ( joined.substr( 0, 4 ), ">abc" );
+    EXPECT_EQ( joined[27], 'a' );
+
+    sc::vector<long> empty;
+    EXPECT_EQ( sc::parallel::reduce( empty, 42L, exec ), 42L );
+}
+
+TEST(Parallel, ReduceToBool)
+{
+    // Each chunk writes its flag to its own slot: no two chunks share a word.
+    sc::parallel::thread_pool pool( 4 );
+    sc::parallel::execution exec( &pool );
+    sc::vector<long> vec;
+    vec.resize( 2000000 );
+    auto any = []( bool a, bool b ) { return a or b; };
+
+    EXPECT_FALSE( sc::parallel::reduce( vec, false, any, exec ) );
+    vec[1999999] = 3;
+    EXPECT_TRUE( sc::parallel::reduce( vec, false, any, exec ) );
+    EXPECT_FALSE( sc::parallel::reduce( vec, true, []( bool a, bool b ) { return a and b; }, exec ) );
+}
+
+TEST(Parallel, FillAndCopy)
+{
+    sc::parallel::thread_pool pool( 4 );
+    sc::parallel::execution exec( &pool );
+
+    sc::vector<int> vec( big );
+    vec.resize( big );
+    sc::parallel::fill( vec, 7, exec );
+    EXPECT_EQ( vec.count( 7 ), big );
+
+    sc::vector<int> copy{ 1, 2, 3 };
+    sc::parallel::copy( vec, copy, exec );
+    EXPECT_TRUE( copy == vec );
+
+    sc::vector<std::string> strings;
+    strings.resize( 100000, "x" );
+    sc::vector<std::string> strings_copy;
+    sc::parallel::copy( strings, strings_copy, exec );
+    EXPECT_TRUE( strings_copy == strings );
+}
+
+TEST(Parallel, SerialBelowThreshold)
+{
+    sc::parallel::thread_pool pool( 4 );
+    std::mutex lock;
+    std::set<std::thread::id> threads;
+    auto record = [&]( long & ) {
+        std::lock_guard<std::mutex> guard( lock );
+        threads.insert( std::this_thread::get_id() );
+    };
+
+    auto small = iota( 1000 );
+    sc::parallel::for_each( small, record, sc::parallel::execution( &pool ) );
+    EXPECT_EQ( threads.size(), 1u );
+    EXPECT_EQ( *threads.begin(), std::this_thread::get_id() );
+
+    // A pool without threads runs everything on the caller.
+    sc::parallel::thread_pool none( 0 );
+    threads.clear();
+    auto vec = iota( big );
+    sc::parallel::for_each( vec, record, sc::parallel::execution( &none ) );
+    EXPECT_EQ( threads.size(), 1u );
+}
+
+TEST(Parallel, ExceptionsReachTheCaller)
+{
+    sc::parallel::thread_pool pool( 4 );
+    auto vec = iota( big );
+
+    EXPECT_THROW( sc::parallel::for_each( vec, []( long & x ) {
+        if( x == (long) big - 5 )
+            throw std::runtime_error( "bad element" );
+    }, sc::parallel::execution( &pool ) ), std::runtime_error );
+
+    // The pool still works afterwards.
+    EXPECT_EQ( sc::parallel::reduce( vec, 0L, sc::parallel::execution( &pool ) ), (long) big * ( (long) big - 1 ) / 2 );
+}
+
+TEST(Parallel, NestedCalls)
+{
+    sc::parallel::thread_pool pool( 2 );
+    sc::parallel::execution exec( &pool, 1 );
+
+    // Every element runs an inner parallel algorithm on the same pool: workers help instead of blocking.
+    sc::vector<long> outer = iota( 16 );
+    sc::parallel::transform( outer, [&exec]( long x ) {
+        sc::vector<long> inner = iota( 10000 );
+        return sc::parallel::reduce( inner, x, exec );
+    }, exec );
+
+    for( long i{0} ; i < 16 ; ++i )
+        ASSERT_EQ( outer[i], i + 10000L * 9999 / 2 );
+}
+
+TEST(Parallel, DefaultPool)
+{
+    auto vec = iota( big );
+    EXPECT_EQ( sc::parallel::reduce( vec, 0L ), (long) big * ( (long) big - 1 ) / 2 );
+    EXPECT_GE( sc::parallel::default_pool().size(), 1u );
+    EXPECT_THROW( sc::parallel::set_default_threads( 2 ), std::logic_error );
+}
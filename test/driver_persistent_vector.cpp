@@ -0,0 +1,264 @@
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "persistent_vector.h"  // header file for tested functions
+
+
+// ============================================================================
+// TESTING PERSISTENT VECTOR
+// ============================================================================
+
+namespace {
+
+    /// Checks that list holds the elements of expected, by index and by iterator.
+    template< typename T >
+    void expect_same( const sc::persistent_vector<T> & list, const std::vector<T> & expected )
+    {
+        ASSERT_EQ( list.size(), expected.size() );
+        for( size_t i = 0 ; i < expected.size() ; ++i )
+            ASSERT_EQ( list[i], expected[i] ) << "index " << i;
+        EXPECT_TRUE( std::equal( list.begin(), list.end(), expected.begin() ) );
+        EXPECT_EQ( list.end() - list.begin(), (std::ptrdiff_t) expected.size() );
+    }
+
+    template< typename T >
+    sc::persistent_vector<T> build( const std::vector<T> & items )
+    {
+        return sc::persistent_vector<T>( items.begin(), items.end() );
+    }
+
+    std::vector<int> iota( int first, int count )
+    {
+        std::vector<int> items;
+        for( int i = 0 ; i < count ; ++i )
+            items.push_back( first + i );
+        return items;
+    }
+}
+
+TEST(PersistentVector, OldVersionsStayUnchanged)
+{
+    sc::persistent_vector<std::string> v0;
+    sc::persistent_vector<std::string> v1 = v0.push_back( "a" );
+    sc::persistent_vector<std::string> v2 = v1.push_back( "b" );
+    sc::persistent_vector<std::string> v3 = v2.set( 0, "z" );
+
+    EXPECT_TRUE( v0.empty() );
+    ASSERT_EQ( v1.size(), 1u );
+    EXPECT_EQ( v1[0], "a" );
+    ASSERT_EQ( v2.size(), 2u );
+    EXPECT_EQ( v2[0], "a" );
+    EXPECT_EQ( v2.back(), "b" );
+    EXPECT_EQ( v3.front(), "z" );
+    EXPECT_EQ( v3[1], "b" );
+
+    EXPECT_THROW( v3.at( 2 ), std::out_of_range );
+    EXPECT_THROW( v3.set( 2, "x" ), std::out_of_range );
+    EXPECT_THROW( v3.slice( 1, 3 ), std::out_of_range );
+}
+
+TEST(PersistentVector, VersionsShareTheirNodes)
+{
+    std::vector<int> items = iota( 0, 100000 );
+    sc::persistent_vector<int> base = build( items );
+    expect_same( base, items );
+
+    // A new version copies one path only: every other leaf is the same memory.
+    sc::persistent_vector<int> pushed = base.push_back( -1 );
+    sc::persistent_vector<int> changed = base.set( 50000, -2 );
+    EXPECT_EQ( &pushed[0], &base[0] );
+    EXPECT_EQ( &changed[0], &base[0] );
+    EXPECT_EQ( &changed[99999], &base[99999] );
+    EXPECT_NE( &changed[50000], &base[50000] );
+
+    EXPECT_EQ( base[50000], 50000 );
+    EXPECT_EQ( changed[50000], -2 );
+    EXPECT_EQ( pushed.size(), 100001u );
+    EXPECT_EQ( pushed.back(), -1 );
+    EXPECT_EQ( base.size(), 100000u );
+
+    // Every version of a history stays readable.
+    std::vector< sc::persistent_vector<int> > history{ base };
+    for( int i = 0 ; i < 100 ; ++i )
+        history.push_back( history.back().set( (size_t) i * 997, -i ) );
+    for( int i = 0 ; i < 100 ; ++i )
+    {
+        EXPECT_EQ( history[i][(size_t) i * 997], i * 997 );
+        EXPECT_EQ( history[i + 1][(size_t) i * 997], -i );
+        EXPECT_EQ( history[i + 1].size(), 100000u );
+    }
+}
+
+TEST(PersistentVector, ConcatAndSlice)
+{
+    std::vector<int> sizes{ 0, 1, 5, 31, 32, 33, 100, 1024, 1025, 5000, 40000 };
+    for( int a : sizes )
+        for( int b : sizes )
+        {
+            std::vector<int> left = iota( 0, a );
+            std::vector<int> right = iota( a, b );
+            std::vector<int> both = iota( 0, a + b );
+
+            sc::persistent_vector<int> joined = build( left ).concat( build( right ) );
+            expect_same( joined, both );
+
+            size_t first = both.size() / 3;
+            size_t last = both.size() - both.size() / 4;
+            std::vector<int> middle( both.begin() + first, both.begin() + last );
+            expect_same( joined.slice( first, last ), middle );
+        }
+}
+
+TEST(PersistentVector, RandomConcatSliceAndPush)
+{
+    std::mt19937 gen( 17 );
+    sc::persistent_vector<std::string> list;
+    std::vector<std::string> model;
+
+    for( int step = 0 ; step < 400 ; ++step )
+    {
+        switch( gen() % 4 )
+        {
+            case 0:
+            {
+                // Concatenate a piece of random length.
+                int count = (int) ( gen() % 3000 );
+                std::vector<std::string> piece;
+                for( int i = 0 ; i < count ; ++i )
+                    piece.push_back( std::to_string( step * 10000 + i ) );
+                if( gen() % 2 )
+                {
+                    list = list.concat( build( piece ) );
+                    model.insert( model.end(), piece.begin(), piece.end() );
+                }
+                else
+                {
+                    list = build( piece ).concat( list );
+                    model.insert( model.begin(), piece.begin(), piece.end() );
+                }
+                break;
+            }
+            case 1:
+            {
+                // Keep a random range.
+                if( model.empty() )
+                    break;
+                size_t first = gen() % model.size();
+                size_t last = first + gen() % ( model.size() - first + 1 );
+                list = list.slice( first, last );
+                model = std::vector<std::string>( model.begin() + first, model.begin() + last );
+                break;
+            }
+            case 2:
+            {
+                for( int i = 0 ; i < 50 ; ++i )
+                {
+                    list = list.push_back( "p" + std::to_string( i ) );
+                    model.push_back( "p" + std::to_string( i ) );
+                }
+                break;
+            }
+            default:
+            {
+                if( model.empty() )
+                    break;
+                size_t pos = gen() % model.size();
+                list = list.set( pos, "s" );
+                model[pos] = "s";
+            }
+        }
+        expect_same( list, model );
+        if( HasFatalFailure() )
+            return;
+    }
+}
+
+TEST(PersistentVector, TransientBuildsInPlace)
+{
+    sc::persistent_vector<int> base{ 1, 2, 3 };
+    sc::persistent_vector<int>::transient_vector batch = base.transient();
+    for( int i = 4 ; i <= 50000 ; ++i )
+        batch.push_back( i );
+    batch.set( 0, 100 );
+    EXPECT_EQ( batch.size(), 50000u );
+    EXPECT_EQ( batch[0], 100 );
+
+    // The transient never changes the version it started from.
+    expect_same( base, std::vector<int>{ 1, 2, 3 } );
+
+    sc::persistent_vector<int> frozen = batch.persistent();
+    std::vector<int> expected = iota( 1, 50000 );
+    expected[0] = 100;
+    expect_same( frozen, expected );
+
+    // Later changes of the transient copy the nodes again: frozen keeps its contents.
+    const int * leaf = &frozen[0];
+    batch.set( 0, 7 );
+    batch.push_back( 50001 );
+    EXPECT_EQ( frozen[0], 100 );
+    EXPECT_EQ( frozen.size(), 50000u );
+    EXPECT_NE( &batch[0], leaf );
+
+    // In place: a second change of the same leaf keeps its address.
+    const int * copied = &batch[0];
+    batch.set( 1, 8 );
+    EXPECT_EQ( &batch[0], copied );
+    EXPECT_EQ( batch.persistent()[1], 8 );
+}
+
+TEST(PersistentVector, TransientMovesButDoesNotCopy)
+{
+    typedef sc::persistent_vector<int>::transient_vector transient;
+    static_assert( not std::is_copy_constructible<transient>::value, "two copies would share their nodes" );
+    static_assert( not std::is_copy_assignable<transient>::value, "two copies would share their nodes" );
+
+    transient first;
+    for( int i = 0 ; i < 5 ; ++i )
+        first.push_back( i );
+    transient second( std::move( first ) );
+    EXPECT_TRUE( first.empty() );
+
+    // The moved-from transient no longer reaches the nodes it gave away.
+    first.push_back( 100 );
+    second.push_back( 200 );
+    expect_same( first.persistent(), std::vector<int>{ 100 } );
+    expect_same( second.persistent(), std::vector<int>{ 0, 1, 2, 3, 4, 200 } );
+
+    first = std::move( second );
+    EXPECT_TRUE( second.empty() );
+    second.push_back( 300 );
+    first.push_back( 400 );
+    expect_same( second.persistent(), std::vector<int>{ 300 } );
+    expect_same( first.persistent(), std::vector<int>{ 0, 1, 2, 3, 4, 200, 400 } );
+}
+
+TEST(PersistentVector, ThreadsDeriveFromOneVersion)
+{
+    sc::persistent_vector<int> base = build( iota( 0, 20000 ) );
+
+    std::vector<std::thread> threads;
+    std::vector< sc::persistent_vector<int> > results( 4 );
+    for( int t = 0 ; t < 4 ; ++t )
+        threads.emplace_back( [&base, &results, t]( ) {
+            sc::persistent_vector<int> mine = base;
+            for( int i = 0 ; i < 2000 ; ++i )
+                mine = mine.set( (size_t) i * 10, t ).push_back( t );
+            results[t] = mine.slice( 0, 20000 ).concat( base.slice( 0, 100 ) );
+        } );
+    for( auto & th : threads )
+        th.join();
+
+    for( int t = 0 ; t < 4 ; ++t )
+    {
+        ASSERT_EQ( results[t].size(), 20100u );
+        EXPECT_EQ( results[t][0], t );
+        EXPECT_EQ( results[t][19990], t );
+        EXPECT_EQ( results[t][19991], 19991 );
+        EXPECT_EQ( results[t][20099], 99 );
+    }
+    expect_same( base, iota( 0, 20000 ) );
+}
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "segmented_vector.h"   // header file for tested functions
+
+
+// ============================================================================
+// TESTING SEGMENTED VECTOR
+// ============================================================================
+
+namespace {
+
+    /// Small blocks, so that the tests cross many of them.
+    template< typename T >
+    using small_blocks = sc::segmented_vector< T, std::allocator<T>, 4 >;
+
+    /// Element whose constructor throws for negative values.
+    struct Picky
+    {
+        int value;
+
+        explicit Picky( int v )
+            : value{v}
+        {
+            if( v < 0 )
+                throw std::invalid_argument( "negative" );
+        }
+    };
+}
+
+TEST(SegmentedVector, DefaultBlockSize)
+{
+    EXPECT_EQ( sc::segmented_vector<int>::block_size, 4096u );
+    EXPECT_EQ( ( sc::default_block_size<char[3000]>::value ), 4u );
+    EXPECT_EQ( ( sc::default_block_size<char[20000]>::value ), 1u );
+
+    sc::segmented_vector<int> empty;
+    EXPECT_EQ( empty.capacity(), 0u );
+    EXPECT_TRUE( empty.begin() == empty.end() );
+}
+
+TEST(SegmentedVector, GrowthKeepsElementsInPlace)
+{
+    small_blocks<std::string> list;
+    std::vector<const std::string*> addresses;
+    for( int i = 0 ; i < 1000 ; ++i )
+    {
+        list.push_back( std::to_string( i ) );
+        addresses.push_back( &list.back() );
+    }
+    EXPECT_EQ( list.size(), 1000u );
+    EXPECT_EQ( list.capacity(), 1000u );
+
+    for( int i = 0 ; i < 1000 ; ++i )
+    {
+        EXPECT_EQ( &list[i], addresses[i] );
+        EXPECT_EQ( list[i], std::to_string( i ) );
+    }
+    EXPECT_EQ( list.front(), "0" );
+    EXPECT_EQ( list.at( 999 ), "999" );
+    EXPECT_THROW( list.at( 1000 ), std::out_of_range );
+}
+
+TEST(SegmentedVector, HoldsTypesThatCannotMove)
+{
+    sc::segmented_vector<std::mutex> locks;
+    for( int i = 0 ; i < 5000 ; ++i )
+        locks.emplace_back();
+    EXPECT_EQ( locks.size(), 5000u );
+    std::lock_guard<std::mutex> guard( locks[4999] );
+    EXPECT_FALSE( locks[4999].try_lock() );
+}
+
+TEST(SegmentedVector, Iterators)
+{
+    for( size_t n : { 0, 1, 3, 4, 5, 8, 100 } )
+    {
+        small_blocks<int> list;
+        for( size_t i = 0 ; i < n ; ++i )
+            list.push_back( (int) ( n - i ) );
+
+        EXPECT_EQ( (size_t) ( list.end() - list.begin() ), n );
+        EXPECT_EQ( (size_t) std::distance( list.cbegin(), list.cend() ), n );
+
+        std::sort( list.begin(), list.end() );
+        for( size_t i = 0 ; i < n ; ++i )
+            ASSERT_EQ( list[i], (int) i + 1 );
+
+        // Random access agrees with stepping, both ways, across blocks.
+        for( size_t i = 0 ; i <= n ; ++i )
+        {
+            small_blocks<int>::const_iterator it = list.begin() + i;
+            EXPECT_EQ( it - list.cbegin(), (std::ptrdiff_t) i );
+            EXPECT_TRUE( list.end() - ( n - i ) == it );
+            if( i < n )
+            {
+                EXPECT_EQ( *it, (int) i + 1 );
+            }
+        }
+        if( n != 0 )
+        {
+            auto it = list.end();
+            --it;
+            EXPECT_EQ( *it, (int) n );
+            EXPECT_EQ( list.begin()[n - 1], (int) n );
+        }
+    }
+
+    // Blocks reserved past the end do not change where end() is.
+    small_blocks<int> list{ 1, 2, 3, 4 };
+    list.reserve( 20 );
+    auto it = list.begin();
+    for( int i = 0 ; i < 4 ; ++i )
+        ++it;
+    EXPECT_TRUE( it == list.end() );
+    EXPECT_EQ( std::accumulate( list.begin(), list.end(), 0 ), 10 );
+}
+
+TEST(SegmentedVector, ResizeShrinkAndCopy)
+{
+    small_blocks<int> list( 10, 7 );
+    EXPECT_EQ( list.capacity(), 12u );
+
+    list.resize( 3 );
+    EXPECT_EQ( list.capacity(), 12u );
+    list.shrink_to_fit();
+    EXPECT_EQ( list.capacity(), 4u );
+    list.resize( 6 );
+    EXPECT_EQ( list[5], 0 );
+    EXPECT_EQ( list[2], 7 );
+
+    small_blocks<int> copy( list );
+    EXPECT_TRUE( copy == list );
+    copy.pop_back();
+    EXPECT_TRUE( copy != list );
+
+    small_blocks<int> moved( std::move( copy ) );
+    EXPECT_EQ( moved.size(), 5u );
+    EXPECT_TRUE( copy.empty() );
+    copy = moved;
+    EXPECT_TRUE( copy == moved );
+
+    moved.clear();
+    EXPECT_TRUE( moved.empty() );
+    moved.shrink_to_fit();
+    EXPECT_EQ( moved.capacity(), 0u );
+    moved.push_back( 1 );
+    EXPECT_EQ( moved.back(), 1 );
+}
+
+TEST(SegmentedVector, ThrowingConstructorKeepsTheList)
+{
+    small_blocks<Picky> list;
+    for( int i = 0 ; i < 4 ; ++i )
+        list.emplace_back( i );
+    EXPECT_THROW( list.emplace_back( -1 ), std::invalid_argument );
+    EXPECT_EQ( list.size(), 4u );
+    list.emplace_back( 4 );
+    EXPECT_EQ( list[4].value, 4 );
+}
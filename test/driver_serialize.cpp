@@ -0,0 +1,267 @@
+#include <string>
+#include <sstream>
+#include <cstdio>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "serialize.h"          // header file for tested functions
+#include "mmap_vector.h"        // opens the saved files
+
+
+// ============================================================================
+// TESTING SERIALIZATION
+// ============================================================================
+
+namespace {
+    struct Sample
+    {
+        long time;
+        float value;
+    };
+
+    sc::vector<Sample> samples( size_t n )
+    {
+        sc::vector<Sample> vec;
+        for( size_t i{0u} ; i < n ; ++i )
+            vec.push_back( Sample{ (long) i * 10, i * 0.25f } );
+        return vec;
+    }
+}
+
+TEST(Serialize, StreamRoundTrip)
+{
+    sc::vector<Sample> vec = samples( 1000 );
+    std::stringstream buffer;
+    sc::io::save( buffer, vec );
+    EXPECT_EQ( buffer.str().size(), 64 + 1000 * sizeof(Sample) );
+
+    sc::vector<Sample> loaded{ Sample{ -1, -1 } };
+    sc::io::load( buffer, loaded );
+    ASSERT_EQ( loaded.size(), 1000u );
+    for( size_t i{0u} ; i < 1000 ; ++i )
+    {
+        ASSERT_EQ( loaded[i].time, vec[i].time );
+        ASSERT_EQ( loaded[i].value, vec[i].value );
+    }
+}
+
+TEST(Serialize, Strings)
+{
+    sc::vector<std::string> vec{ "", "a", std::string( 1000, 'z' ), "last" };
+    std::stringstream buffer;
+    sc::io::save( buffer, vec );
+
+    sc::vector<std::string> loaded;
+    sc::io::load( buffer, loaded );
+    EXPECT_TRUE( loaded == vec );
+
+    // A list of strings is not one of raw elements.
+    buffer.clear();
+    buffer.seekg( 0 );
+    sc::vector<long> wrong;
+    EXPECT_THROW( sc::io::load( buffer, wrong ), std::runtime_error );
+}
+
+TEST(Serialize, EmptyList)
+{
+    sc::vector<int> vec;
+    std::stringstream buffer;
+    sc::io::save( buffer, vec );
+
+    sc::vector<int> loaded{ 1, 2, 3 };
+    sc::io::load( buffer, loaded );
+    EXPECT_EQ( loaded.size(), 0u );
+}
+
+TEST(Serialize, ChunkedReader)
+{
+    sc::vector<int> vec;
+    for( int i{0} ; i < 10000 ; ++i )
+        vec.push_back( i );
+    std::stringstream buffer;
+    sc::io::save( buffer, vec );
+
+    auto in = sc::io::reader<int>( buffer );
+    EXPECT_EQ( in.size(), 10000u );
+
+    sc::vector<int> chunk;
+    long sum{0};
+    size_t chunks{0u};
+    while( not in.done() )
+    {
+        chunk.clear();
+        EXPECT_LE( in.read( chunk, 4096 ), 4096u );
+        for( int v : chunk )
+            sum += v;
+        ++chunks;
+    }
+    EXPECT_EQ( chunks, 3u );
+    EXPECT_EQ( sum, 9999L * 10000 / 2 );
+    EXPECT_EQ( in.read( chunk, 10 ), 0u );
+}
+
+TEST(Serialize, FileDescriptors)
+{
+    std::string path = "/tmp/sc_serialize_" + std::to_string( ::getpid() );
+    sc::vector<Sample> vec = samples( 5000 );
+    sc::vector<std::string> names{ "one", "two" };
+
+    int fd = ::open( path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+    ASSERT_GE( fd, 0 );
+    sc::io::save( fd, vec );
+    sc::io::save( fd, names );
+    ::lseek( fd, 0, SEEK_SET );
+
+    sc::vector<Sample> loaded;
+    sc::vector<std::string> loaded_names;
+    sc::io::load( fd, loaded );
+    sc::io::load( fd, loaded_names );
+    EXPECT_THROW( sc::io::load( fd, loaded ), std::runtime_error );
+    ::close( fd );
+
+    ASSERT_EQ( loaded.size(), 5000u );
+    EXPECT_EQ( loaded[4999].time, 49990 );
+    EXPECT_TRUE( loaded_names == names );
+    std::remove( path.c_str() );
+}
+
+TEST(Serialize, SavedFileOpensAsMmapVector)
+{
+    std::string path = "/tmp/sc_serialize_mmap_" + std::to_string( ::getpid() );
+    sc::vector<Sample> vec = samples( 300 );
+
+    int fd = ::open( path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    ASSERT_GE( fd, 0 );
+    sc::io::save( fd, vec );
+    ::close( fd );
+
+    {
+        sc::mmap_vector<Sample> mapped( path, sc::mmap_vector<Sample>::read_only );
+        ASSERT_EQ( mapped.size(), 300u );
+        EXPECT_EQ( mapped[299].time, 2990 );
+    }
+    std::remove( path.c_str() );
+}
+
+TEST(Serialize, RejectsBadInput)
+{
+    std::stringstream garbage( std::string( 100, 'x' ) );
+    sc::vector<int> vec;
+    EXPECT_THROW( sc::io::load( garbage, vec ), std::runtime_error );
+
+    sc::vector<int> source{ 1, 2, 3, 4 };
+    std::stringstream buffer;
+    sc::io::save( buffer, source );
+    std::string bytes = buffer.str();
+    std::stringstream truncated( bytes.substr( 0, bytes.size() - 2 ) );
+    EXPECT_THROW( sc::io::load( truncated, vec ), std::runtime_error );
+
+    std::stringstream wrong_size( bytes );
+    sc::vector<short> shorts;
+    EXPECT_THROW( sc::io::load( wrong_size, shorts ), std::runtime_error );
+}
+
+TEST(Serialize, FailedLoadLeavesListUnchanged)
+{
+    sc::vector<Sample> source = samples( 100000 );
+    std::stringstream buffer;
+    sc::io::save( buffer, source );
+    std::string bytes = buffer.str();
+
+    // Cut in the middle of the list, past the first chunk read.
+    std::stringstream truncated( bytes.substr( 0, bytes.size() - 1000 ) );
+    sc::vector<Sample> vec = samples( 3 );
+    EXPECT_THROW( sc::io::load( truncated, vec ), std::runtime_error );
+    ASSERT_EQ( vec.size(), 3u );
+    EXPECT_EQ( vec[2].time, 20 );
+
+    sc::vector<std::string> names{ "one", std::string( 500, 'x' ), "three" };
+    std::stringstream saved;
+    sc::io::save( saved, names );
+    std::string name_bytes = saved.str();
+    std::stringstream cut( name_bytes.substr( 0, name_bytes.size() - 10 ) );
+    sc::vector<std::string> loaded{ "kept" };
+    EXPECT_THROW( sc::io::load( cut, loaded ), std::runtime_error );
+    ASSERT_EQ( loaded.size(), 1u );
+    EXPECT_EQ( loaded[0], "kept" );
+
+    // A reader appends nothing when it fails.
+    std::stringstream again( bytes.substr( 0, bytes.size() - 1000 ) );
+    auto in = sc::io::reader<Sample>( again );
+    sc::vector<Sample> chunk = samples( 2 );
+    EXPECT_THROW( in.read( chunk, in.size() ), std::runtime_error );
+    EXPECT_EQ( chunk.size(), 2u );
+}
+
+TEST(Serialize, SizesBeyondTheStream)
+{
+    // A header that claims far more elements than follow fails when the data ends, without allocating them.
+    sc::io::header h = sc::io::make_header( sizeof(int), uint64_t(1) << 60 );
+    std::string bytes( reinterpret_cast<const char*>( &h ), sizeof(h) );
+    bytes += std::string( 4 * sizeof(int), '\0' );
+    std::stringstream huge( bytes );
+    sc::vector<int> vec{ 7 };
+    EXPECT_THROW( sc::io::load( huge, vec ), std::runtime_error );
+    ASSERT_EQ( vec.size(), 1u );
+    EXPECT_EQ( vec[0], 7 );
+
+    // Same for the length of a string.
+    sc::vector<std::string> names{ "short" };
+    std::stringstream saved;
+    sc::io::save( saved, names );
+    std::string name_bytes = saved.str();
+    uint64_t length = uint64_t(1) << 60;
+    name_bytes.replace( sizeof(sc::io::header), sizeof(length), reinterpret_cast<const char*>( &length ), sizeof(length) );
+    std::stringstream long_name( name_bytes );
+    sc::vector<std::string> loaded;
+    EXPECT_THROW( sc::io::load( long_name, loaded ), std::runtime_error );
+    EXPECT_EQ( loaded.size(), 0u );
+}
+
+TEST(Serialize, Flags)
+{
+    // The words are saved whole, the header counts the flags.
+    for( size_t n : { 0u, 1u, 64u, 65u, 1000u } )
+    {
+        sc::vector<bool> flags;
+        for( size_t i{0u} ; i < n ; ++i )
+            flags.push_back( i % 3 == 1 );
+        std::stringstream buffer;
+        sc::io::save( buffer, flags );
+        EXPECT_EQ( buffer.str().size(), 64 + ( n + 63 ) / 64 * 8 );
+
+        sc::vector<bool> loaded{ true };
+        sc::io::load( buffer, loaded );
+        EXPECT_TRUE( loaded == flags ) << n << " flags";
+    }
+
+    sc::vector<bool> flags{ true, false, true };
+    std::stringstream buffer;
+    sc::io::save( buffer, flags );
+    std::string bytes = buffer.str();
+
+    // The bits past the last flag stay 0 whatever the file holds.
+    std::string dirty( bytes );
+    dirty[64] = char( 0xFF );
+    std::stringstream dirty_stream( dirty );
+    sc::vector<bool> loaded;
+    sc::io::load( dirty_stream, loaded );
+    EXPECT_EQ( loaded.size(), 3u );
+    EXPECT_EQ( loaded.count( true ), 3u );
+    EXPECT_TRUE( loaded.find_next( 2 ) == 3u );
+
+    // Flags are not bytes, and a short file fails leaving the list as it was.
+    std::stringstream as_bytes( bytes );
+    sc::vector<char> chars;
+    EXPECT_THROW( sc::io::load( as_bytes, chars ), std::runtime_error );
+    std::stringstream truncated( bytes.substr( 0, bytes.size() - 1 ) );
+    EXPECT_THROW( sc::io::load( truncated, loaded ), std::runtime_error );
+    EXPECT_EQ( loaded.size(), 3u );
+
+    sc::io::header h = sc::io::make_header( sc::io::packed_flags, uint64_t(1) << 60 );
+    std::stringstream huge( std::string( reinterpret_cast<const char*>( &h ), sizeof(h) ) + std::string( 16, '\0' ) );
+    EXPECT_THROW( sc::io::load( huge, loaded ), std::runtime_error );
+    EXPECT_EQ( loaded.size(), 3u );
+}
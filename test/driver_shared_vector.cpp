@@ -0,0 +1,161 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "shared_vector.h"      // header file for tested functions
+
+
+// ============================================================================
+// TESTING SHARED VECTOR
+// ============================================================================
+
+TEST(SharedVector, CopiesShareTheBuffer)
+{
+    sc::shared_vector<std::string> config{ "a", "b", "c" };
+    EXPECT_EQ( config.use_count(), 1u );
+
+    sc::shared_vector<std::string> copy( config );
+    sc::shared_vector<std::string> assigned;
+    assigned = copy;
+    EXPECT_EQ( config.use_count(), 3u );
+    EXPECT_EQ( &config.get(), &copy.get() );
+    EXPECT_EQ( &config.cbegin()[0], &assigned.cbegin()[0] );
+
+    // Reads through const references do not clone.
+    const auto & view = copy;
+    EXPECT_EQ( view[1], "b" );
+    EXPECT_EQ( view.at( 2 ), "c" );
+    EXPECT_TRUE( view.contains( "a" ) );
+    EXPECT_EQ( config.use_count(), 3u );
+    EXPECT_TRUE( copy == config );
+}
+
+TEST(SharedVector, FirstWriteClones)
+{
+    sc::shared_vector<int> original{ 1, 2, 3 };
+    sc::shared_vector<int> copy( original );
+
+    copy.push_back( 4 );
+    EXPECT_EQ( original.size(), 3u );
+    EXPECT_EQ( copy.size(), 4u );
+    EXPECT_TRUE( original.unique() );
+    EXPECT_TRUE( copy.unique() );
+
+    // A unique owner writes in place.
+    const int * before = &copy.get()[0];
+    copy[0] = 10;
+    EXPECT_EQ( &copy.get()[0], before );
+    EXPECT_EQ( original[0], 1 );
+
+    sc::shared_vector<int> third( copy );
+    third[1] = 20;
+    EXPECT_EQ( copy.get()[1], 2 );
+    EXPECT_EQ( third.get()[1], 20 );
+    EXPECT_TRUE( copy != third );
+}
+
+TEST(SharedVector, Modifiers)
+{
+    sc::shared_vector<int> base{ 1, 2, 3, 4, 5 };
+    sc::shared_vector<int> vec( base );
+
+    vec.insert( vec.cbegin() + 1, 9 );
+    vec.erase( vec.cbegin() + 3 );
+    vec.push_front( 0 );
+    vec.pop_back();
+    EXPECT_TRUE( vec.get() == ( sc::vector<int>{ 0, 1, 9, 2, 4 } ) );
+
+    int more[] = { 7, 8 };
+    vec.insert( vec.cend(), more, more + 2 );
+    vec.erase( vec.cbegin(), vec.cbegin() + 2 );
+    EXPECT_TRUE( vec.get() == ( sc::vector<int>{ 9, 2, 4, 7, 8 } ) );
+
+    sc::shared_vector<int> other( vec );
+    other.clear();
+    EXPECT_TRUE( other.empty() );
+    EXPECT_EQ( vec.size(), 5u );
+
+    other.resize( 3, 6 );
+    other.assign( 2, 5 );
+    EXPECT_TRUE( other.get() == ( sc::vector<int>{ 5, 5 } ) );
+    EXPECT_TRUE( base.get() == ( sc::vector<int>{ 1, 2, 3, 4, 5 } ) );
+}
+
+TEST(SharedVector, Flags)
+{
+    // Reads give the flags by value, writes go through proxies into the clone.
+    sc::shared_vector<bool> flags{ true, false, true };
+    sc::shared_vector<bool> copy( flags );
+    const auto & view = copy;
+    EXPECT_TRUE( view[0] );
+    EXPECT_FALSE( view.at( 1 ) );
+    EXPECT_EQ( flags.use_count(), 2u );
+
+    copy[0] = false;
+    copy.back().flip();
+    copy.push_front( true );
+    EXPECT_TRUE( copy.emplace_back( true ) );
+    copy.insert( copy.cbegin() + 1, false );
+    EXPECT_EQ( flags.use_count(), 1u );
+
+    EXPECT_TRUE( flags == ( sc::shared_vector<bool>{ true, false, true } ) );
+    EXPECT_TRUE( copy == ( sc::shared_vector<bool>{ true, false, false, false, false, true } ) );
+    EXPECT_EQ( copy.count( false ), 4u );
+}
+
+TEST(SharedVector, ArgumentFromTheSharedBuffer)
+{
+    sc::shared_vector<std::string> vec{ std::string( 50, 'x' ) };
+    sc::shared_vector<std::string> copy( vec );
+
+    // The value lives in the buffer being cloned.
+    const auto & view = vec;
+    vec.push_back( view[0] );
+    EXPECT_EQ( vec.size(), 2u );
+    EXPECT_EQ( vec.get()[1], std::string( 50, 'x' ) );
+    EXPECT_EQ( copy.size(), 1u );
+}
+
+TEST(SharedVector, EmptyAndMoved)
+{
+    sc::shared_vector<int> none;
+    EXPECT_TRUE( none.empty() );
+    EXPECT_EQ( none.use_count(), 0u );
+    EXPECT_TRUE( none.cbegin() == none.cend() );
+
+    none.push_back( 1 );
+    sc::shared_vector<int> moved( std::move( none ) );
+    EXPECT_EQ( moved.size(), 1u );
+    EXPECT_EQ( none.use_count(), 0u );
+
+    sc::vector<int> items{ 4, 5 };
+    sc::shared_vector<int> adopted( std::move( items ) );
+    EXPECT_EQ( adopted.back(), 5 );
+}
+
+TEST(SharedVector, ThreadsShareOneBuffer)
+{
+    sc::vector<long> items;
+    for( long i{0} ; i < 10000 ; ++i )
+        items.push_back( i );
+    sc::shared_vector<long> config( std::move( items ) );
+
+    std::vector<std::thread> workers;
+    std::vector<long> sums( 8, 0 );
+    for( size_t t{0u} ; t < 8 ; ++t )
+        workers.emplace_back( [config, &sums, t]() mutable {
+            sc::shared_vector<long> mine( config );
+            if( t % 2 == 0 )
+                mine.push_back( (long) t );
+            for( auto it = mine.cbegin() ; it != mine.cend() ; ++it )
+                sums[t] += *it;
+        } );
+    for( auto & worker : workers )
+        worker.join();
+
+    for( size_t t{0u} ; t < 8 ; ++t )
+        EXPECT_EQ( sums[t], 9999L * 10000 / 2 + ( t % 2 == 0 ? (long) t : 0 ) );
+    EXPECT_EQ( config.use_count(), 1u );
+    EXPECT_EQ( config.size(), 10000u );
+}
@@ -0,0 +1,144 @@
+#include <vector>
+#include <random>
+#include <limits>
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "simd.h"               // header file for tested functions
+#include "vector.h"
+
+
+// ============================================================================
+// TESTING SEARCH AND COMPARISON KERNELS
+// ============================================================================
+
+namespace {
+    // Values drawn from a small set, so that searches hit and miss, extremes of T included.
+    template< typename T >
+    std::vector<T> sample( size_t n, unsigned seed )
+    {
+        std::mt19937 gen( seed );
+        std::uniform_int_distribution<int> pick( 0, 9 );
+        const T values[] = { T(0), T(1), T(2), T(3), T(7), T(-1), T(100),
+                             std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(), T(5) };
+
+        std::vector<T> out( n );
+        for( auto & v : out )
+            v = values[ pick( gen ) ];
+        return out;
+    }
+
+    // Runs every kernel of the dispatch and of each instruction set against the scalar loops.
+    template< typename T >
+    void check_kernels( )
+    {
+        for( size_t n{0u} ; n < 150 ; ++n )
+        {
+            auto a = sample<T>( n, (unsigned) n );
+            auto b = a;
+            const T * p = a.data();
+
+            for( T value : { T(0), T(3), T(100), T(42), std::numeric_limits<T>::max() } )
+            {
+                ASSERT_EQ( sc::simd::find( p, n, value ), sc::simd::scalar::find( p, n, value ) ) << n;
+                ASSERT_EQ( sc::simd::count( p, n, value ), sc::simd::scalar::count( p, n, value ) ) << n;
+#ifdef SC_SIMD_X86
+                ASSERT_EQ( sc::simd::sse2::find( p, n, value ), sc::simd::scalar::find( p, n, value ) ) << n;
+                ASSERT_EQ( sc::simd::sse2::count( p, n, value ), sc::simd::scalar::count( p, n, value ) ) << n;
+                if( sc::simd::has_avx2() )
+                {
+                    ASSERT_EQ( sc::simd::avx2::find( p, n, value ), sc::simd::scalar::find( p, n, value ) ) << n;
+                    ASSERT_EQ( sc::simd::avx2::count( p, n, value ), sc::simd::scalar::count( p, n, value ) ) << n;
+                }
+#endif
+            }
+
+            ASSERT_TRUE( sc::simd::equal( p, b.data(), n ) );
+            if( n != 0 )
+            {
+                b[n / 2] = T(42);
+                ASSERT_FALSE( sc::simd::equal( p, b.data(), n ) ) << n;
+#ifdef SC_SIMD_X86
+                ASSERT_FALSE( sc::simd::sse2::equal( p, b.data(), n ) ) << n;
+                if( sc::simd::has_avx2() )
+                {
+                    ASSERT_FALSE( sc::simd::avx2::equal( p, b.data(), n ) ) << n;
+                }
+#endif
+
+                ASSERT_EQ( sc::simd::min_index( p, n ), sc::simd::scalar::min_index( p, n ) ) << n;
+                ASSERT_EQ( sc::simd::max_index( p, n ), sc::simd::scalar::max_index( p, n ) ) << n;
+#ifdef SC_SIMD_X86
+                ASSERT_EQ( sc::simd::sse2::min_index( p, n ), sc::simd::scalar::min_index( p, n ) ) << n;
+                ASSERT_EQ( sc::simd::sse2::max_index( p, n ), sc::simd::scalar::max_index( p, n ) ) << n;
+                if( sc::simd::has_avx2() )
+                {
+                    ASSERT_EQ( sc::simd::avx2::min_index( p, n ), sc::simd::scalar::min_index( p, n ) ) << n;
+                    ASSERT_EQ( sc::simd::avx2::max_index( p, n ), sc::simd::scalar::max_index( p, n ) ) << n;
+                }
+#endif
+            }
+        }
+    }
+}
+
+TEST(Simd, SignedIntegers)
+{
+    check_kernels<std::int8_t>();
+    check_kernels<std::int16_t>();
+    check_kernels<std::int32_t>();
+    check_kernels<std::int64_t>();
+}
+
+TEST(Simd, UnsignedIntegers)
+{
+    check_kernels<std::uint8_t>();
+    check_kernels<std::uint16_t>();
+    check_kernels<std::uint32_t>();
+    check_kernels<std::uint64_t>();
+}
+
+TEST(Simd, FloatingPoint)
+{
+    check_kernels<float>();
+    check_kernels<double>();
+
+    // Same rules as operator==: NaN never matches, 0.0 matches -0.0.
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> a( 40, 1.0 );
+    a[35] = nan;
+    a[37] = -0.0;
+    EXPECT_EQ( sc::simd::find( a.data(), a.size(), nan ), a.size() );
+    EXPECT_EQ( sc::simd::find( a.data(), a.size(), 0.0 ), 37u );
+    EXPECT_FALSE( sc::simd::equal( a.data(), a.data(), a.size() ) );
+}
+
+TEST(Simd, VectorMembers)
+{
+    sc::vector<int> vec;
+    for( auto i{0} ; i < 1000 ; ++i )
+        vec.push_back( ( i * 7919 ) % 1009 - 500 );
+
+    EXPECT_EQ( vec.find( 9 ) - vec.begin(), 89 );
+    EXPECT_EQ( vec.find( 1000 ), vec.end() );
+    EXPECT_TRUE( vec.contains( -500 ) );
+    EXPECT_FALSE( vec.contains( 600 ) );
+    EXPECT_EQ( vec.count( 0 ), 1u );
+    EXPECT_EQ( vec.min(), -500 );
+    EXPECT_EQ( vec.max(), 508 );
+    EXPECT_EQ( &vec.min(), &vec[0] );
+
+    const sc::vector<int> copy( vec );
+    EXPECT_TRUE( copy == vec );
+    EXPECT_EQ( copy.find( 9 ) - copy.begin(), 89 );
+    vec[999] = 1;
+    EXPECT_TRUE( copy != vec );
+
+    sc::vector<std::string> words{ "b", "a", "c", "a" };
+    EXPECT_EQ( words.count( "a" ), 2u );
+    EXPECT_EQ( words.find( "c" ) - words.begin(), 2 );
+    EXPECT_EQ( words.min(), "a" );
+    EXPECT_EQ( &words.min(), &words[1] );
+    EXPECT_EQ( words.max(), "c" );
+}
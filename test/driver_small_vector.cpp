@@ -0,0 +1,131 @@
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <algorithm>            // std::sort
+
+#include "gtest/gtest.h"        // gtest lib
+#include "small_vector.h"       // header file for tested functions
+
+
+// ============================================================================
+// TESTING SMALL VECTOR
+// ============================================================================
+
+TEST(SmallVector, DefaultConstructor)
+{
+    sc::small_vector<int, 8> vec;
+
+    EXPECT_EQ( vec.size(), 0 );
+    EXPECT_EQ( vec.capacity(), 8 );
+    EXPECT_TRUE( vec.empty() );
+    EXPECT_TRUE( vec.is_inline() );
+}
+
+TEST(SmallVector, StaysInline)
+{
+    sc::small_vector<int, 8> vec{ 4, 3, 5 };
+
+    // The back slack holds more than the list: it shifts up into it rather than leaving the buffer,
+    // and the free slots are split between the two ends.
+    for( auto i{2} ; i >= 0 ; --i )
+        vec.push_front( i );
+    vec.push_back( 6 );
+    vec.push_back( 7 );
+
+    EXPECT_TRUE( vec.is_inline() );
+    ASSERT_EQ( vec.size(), 8 );
+
+    std::sort( vec.begin(), vec.end() );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], (int) i );
+}
+
+TEST(SmallVector, SpillsToHeap)
+{
+    sc::small_vector<std::string, 4> vec;
+
+    for( auto i{0} ; i < 20 ; ++i )
+        vec.emplace_back( i+1, 'a' );
+
+    EXPECT_FALSE( vec.is_inline() );
+    ASSERT_EQ( vec.size(), 20 );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], std::string( i+1, 'a' ) );
+
+    // Back to the inline buffer once it fits again.
+    while( vec.size() > 3 )
+        vec.pop_back();
+    vec.shrink_to_fit();
+    EXPECT_TRUE( vec.is_inline() );
+    EXPECT_EQ( vec.capacity(), 4 );
+    EXPECT_EQ( vec[2], "aaa" );
+}
+
+TEST(SmallVector, CopyAndMove)
+{
+    sc::small_vector<std::string, 4> small{ "a", "b" };
+    sc::small_vector<std::string, 4> large{ "a", "b", "c", "d", "e", "f" };
+
+    // Copies.
+    sc::small_vector<std::string, 4> copy( large );
+    EXPECT_FALSE( copy.is_inline() );
+    ASSERT_EQ( copy.size(), 6 );
+    copy = small;
+    ASSERT_EQ( copy.size(), 2 );
+    EXPECT_EQ( copy[1], "b" );
+
+    // Moving an inline vector moves its elements.
+    sc::small_vector<std::string, 4> moved( std::move( small ) );
+    EXPECT_TRUE( moved.is_inline() );
+    ASSERT_EQ( moved.size(), 2 );
+    EXPECT_EQ( moved[0], "a" );
+    EXPECT_TRUE( small.empty() );
+
+    // Moving a spilled vector steals its heap storage.
+    const std::string * storage = &large[0];
+    moved = std::move( large );
+    EXPECT_FALSE( moved.is_inline() );
+    EXPECT_EQ( &moved[0], storage );
+    ASSERT_EQ( moved.size(), 6 );
+    EXPECT_EQ( moved[5], "f" );
+    EXPECT_TRUE( large.empty() );
+    EXPECT_TRUE( large.is_inline() );
+    EXPECT_EQ( large.capacity(), 4 );
+
+    large.push_back( "z" );
+    EXPECT_EQ( large.front(), "z" );
+}
+
+TEST(SmallVector, MovesWithoutThrowing)
+{
+    static_assert( std::is_nothrow_move_constructible< sc::small_vector<std::string, 4> >::value, "moves are noexcept" );
+    static_assert( std::is_nothrow_move_assignable< sc::small_vector<int, 4> >::value, "moves are noexcept" );
+
+    // A std::vector that grows moves its small vectors: the spilled ones keep their heap storage.
+    std::vector< sc::small_vector<std::string, 2> > lists( 1 );
+    lists[0] = { "a", "b", "c" };
+    const std::string * storage = &lists[0][0];
+    for( auto i{0} ; i < 10 ; ++i )
+        lists.emplace_back();
+
+    EXPECT_EQ( &lists[0][0], storage );
+    ASSERT_EQ( lists[0].size(), 3 );
+    EXPECT_EQ( lists[0][2], "c" );
+}
+
+TEST(SmallVector, SharesVectorApi)
+{
+    sc::small_vector<int, 4> vec{ 1, 2, 5 };
+
+    vec.insert( vec.begin()+2, { 3, 4 } );
+    vec.erase( vec.begin() );
+    ASSERT_EQ( vec.size(), 4 );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], (int) i+2 );
+
+    const sc::small_vector<int, 4> & cref = vec;
+    auto sum{0};
+    for( const auto & e : cref )
+        sum += e;
+    EXPECT_EQ( sum, 14 );
+}
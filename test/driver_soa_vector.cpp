@@ -0,0 +1,204 @@
+#include <string>
+#include <tuple>
+#include <numeric>
+#include <stdexcept>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "soa_vector.h"         // header file for tested functions
+
+
+// ============================================================================
+// TESTING SOA VECTOR
+// ============================================================================
+
+namespace {
+    /// Copy constructor throws when armed is set and the value is negative.
+    struct Fragile
+    {
+        static bool armed;
+        int value;
+        Fragile( int v = 0 ) : value{v} {}
+        Fragile( const Fragile & other ) : value{other.value}
+        {
+            if( armed and value < 0 )
+                throw std::runtime_error( "negative" );
+        }
+        Fragile & operator=( const Fragile & ) = default;
+    };
+    bool Fragile::armed = false;
+
+    /// Counts its live instances. Its move may throw, so growth copies it.
+    struct Counted
+    {
+        static int live;
+        Counted( ) { ++live; }
+        Counted( const Counted & ) { ++live; }
+        Counted( Counted && ) noexcept(false) { ++live; }
+        ~Counted( ) { --live; }
+    };
+    int Counted::live = 0;
+
+    /// Cannot be copied; its move throws when armed is set, so growth moves it anyway.
+    struct MoveOnly
+    {
+        static bool armed;
+        int value;
+        MoveOnly( int v ) : value{v} {}
+        MoveOnly( const MoveOnly & ) = delete;
+        MoveOnly( MoveOnly && other ) noexcept(false) : value{other.value}
+        {
+            if( armed )
+                throw std::runtime_error( "move" );
+        }
+    };
+    bool MoveOnly::armed = false;
+}
+
+TEST(SoaVector, PushBackAndFields)
+{
+    sc::soa_vector<int, double, std::string> vec;
+    EXPECT_TRUE( vec.empty() );
+
+    for( int i{0} ; i < 1000 ; ++i )
+        vec.push_back( std::make_tuple( i, i * 0.5, std::to_string( i ) ) );
+    vec.emplace_back( -1, -0.5, "last" );
+
+    ASSERT_EQ( vec.size(), 1001u );
+    EXPECT_GE( vec.capacity(), 1001u );
+    EXPECT_EQ( std::get<0>( vec[10] ), 10 );
+    EXPECT_EQ( std::get<2>( vec[999] ), "999" );
+    EXPECT_EQ( vec.get<1>( 4 ), 2.0 );
+    EXPECT_EQ( std::get<2>( vec.back() ), "last" );
+    EXPECT_THROW( vec.at( 1001 ), std::out_of_range );
+
+    // The proxy writes through to the arrays.
+    std::get<1>( vec[3] ) = 42.0;
+    EXPECT_EQ( vec.get<1>( 3 ), 42.0 );
+
+    vec.pop_back();
+    EXPECT_EQ( vec.size(), 1000u );
+}
+
+TEST(SoaVector, ColumnsAreContiguous)
+{
+    sc::soa_vector<char, long> vec;
+    for( int i{0} ; i < 100 ; ++i )
+        vec.emplace_back( char( 'a' + i % 26 ), (long) i );
+
+    auto keys = vec.column<1>();
+    ASSERT_EQ( keys.size(), 100u );
+    EXPECT_EQ( keys.data() + 99, &vec.get<1>( 99 ) );
+    EXPECT_EQ( std::accumulate( keys.begin(), keys.end(), 0L ), 99L * 100 / 2 );
+
+    for( auto & key : vec.column<1>() )
+        key *= 2;
+    EXPECT_EQ( vec.get<1>( 50 ), 100 );
+
+    const auto & view = vec;
+    EXPECT_EQ( view.column<0>()[27], 'b' );
+}
+
+TEST(SoaVector, ProxyIterator)
+{
+    sc::soa_vector<int, std::string> vec{ std::make_tuple( 1, std::string( "one" ) ),
+                                          std::make_tuple( 2, std::string( "two" ) ),
+                                          std::make_tuple( 3, std::string( "three" ) ) };
+
+    int sum{0};
+    for( auto record : vec )
+    {
+        sum += std::get<0>( record );
+        std::get<1>( record ) += "!";
+    }
+    EXPECT_EQ( sum, 6 );
+    EXPECT_EQ( vec.get<1>( 2 ), "three!" );
+
+    sc::soa_vector<int, std::string>::const_iterator it = vec.begin();
+    EXPECT_EQ( std::get<1>( *( it + 1 ) ), "two!" );
+    EXPECT_EQ( vec.end() - vec.begin(), 3 );
+    EXPECT_EQ( std::get<0>( vec.begin()[2] ), 3 );
+}
+
+TEST(SoaVector, ResizeReserveCopy)
+{
+    sc::soa_vector<int, std::string> vec;
+    vec.reserve( 10 );
+    EXPECT_EQ( vec.capacity(), 10u );
+
+    vec.resize( 5, std::make_tuple( 7, std::string( "x" ) ) );
+    vec.resize( 8 );
+    ASSERT_EQ( vec.size(), 8u );
+    EXPECT_EQ( vec.get<0>( 4 ), 7 );
+    EXPECT_EQ( vec.get<1>( 7 ), "" );
+
+    sc::soa_vector<int, std::string> copy( vec );
+    EXPECT_EQ( copy.get<1>( 0 ), "x" );
+
+    vec.resize( 2 );
+    vec.shrink_to_fit();
+    EXPECT_EQ( vec.capacity(), 2u );
+    EXPECT_EQ( copy.size(), 8u );
+
+    sc::soa_vector<int, std::string> moved( std::move( copy ) );
+    EXPECT_EQ( moved.size(), 8u );
+    EXPECT_TRUE( copy.empty() );
+
+    copy = moved;
+    EXPECT_EQ( copy.size(), 8u );
+    vec.clear();
+    EXPECT_TRUE( vec.empty() );
+}
+
+TEST(SoaVector, AppendingItsOwnRecord)
+{
+    sc::soa_vector<std::string, int> vec;
+    vec.emplace_back( std::string( 100, 'a' ), 1 );
+    for( int i{0} ; i < 10 ; ++i )
+        vec.emplace_back( vec.get<0>( 0 ), vec.get<1>( 0 ) );
+
+    EXPECT_EQ( vec.size(), 11u );
+    EXPECT_EQ( vec.get<0>( 10 ), std::string( 100, 'a' ) );
+}
+
+TEST(SoaVector, StrongGuaranteeOnGrowth)
+{
+    sc::soa_vector<std::string, Fragile> vec;
+    vec.emplace_back( "a", Fragile( 1 ) );
+    vec.emplace_back( "b", Fragile( -2 ) );
+    ASSERT_EQ( vec.capacity(), 2u );
+
+    Fragile::armed = true;
+    EXPECT_THROW( vec.emplace_back( "c", Fragile( 3 ) ), std::runtime_error );
+    EXPECT_THROW( vec.emplace_back( "d", Fragile( -4 ) ), std::runtime_error );
+    Fragile::armed = false;
+
+    // The strings were not moved out.
+    ASSERT_EQ( vec.size(), 2u );
+    EXPECT_EQ( vec.get<0>( 0 ), "a" );
+    EXPECT_EQ( vec.get<0>( 1 ), "b" );
+    EXPECT_EQ( vec.get<1>( 1 ).value, -2 );
+}
+
+TEST(SoaVector, ThrowingMoveDestroysTheCopies)
+{
+    {
+        sc::soa_vector<Counted, MoveOnly> vec;
+        vec.emplace_back( Counted(), 1 );
+        vec.emplace_back( Counted(), 2 );
+        ASSERT_EQ( vec.capacity(), 2u );
+        ASSERT_EQ( Counted::live, 2 );
+
+        // The Counted fields are copied before the MoveOnly move throws: the copies go away.
+        MoveOnly::armed = true;
+        EXPECT_THROW( vec.reserve( 10 ), std::runtime_error );
+        MoveOnly::armed = false;
+        EXPECT_EQ( Counted::live, 2 );
+        EXPECT_EQ( vec.size(), 2u );
+        EXPECT_EQ( vec.capacity(), 2u );
+
+        vec.emplace_back( Counted(), 3 );
+        EXPECT_EQ( vec.get<1>( 2 ).value, 3 );
+        EXPECT_EQ( Counted::live, 3 );
+    }
+    EXPECT_EQ( Counted::live, 0 );
+}
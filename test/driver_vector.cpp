@@ -2,6 +2,8 @@
 #include <functional>           // std::function
 #include <algorithm>            // std::min_element
 #include <vector>
+#include <string>
+#include <memory>
 
 #include "gtest/gtest.h"        // gtest lib
 #include "vector.h"   			// header file for tested functions
@@ -264,15 +266,14 @@ TEST(IntVector, AssignCountValue)
         ASSERT_EQ( new_value, vec[i] );
 }
 
-// WITH ERRORS
-// TEST(IntVector, OperatorBracketsRHS)
-// {
-//     const sc::vector<int> vec { 1, 2, 3, 4, 5 };
-//     const sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
+TEST(IntVector, OperatorBracketsRHS)
+{
+    const sc::vector<int> vec { 1, 2, 3, 4, 5 };
+    const sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
 
-//     for ( auto i{0u} ; i < vec.size() ; ++i )
-//         ASSERT_EQ( vec[i], vec2[i]);
-// }
+    for ( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], vec2[i]);
+}
 
 TEST(IntVector, OperatorBracketsLHS)
 {
@@ -285,22 +286,21 @@ TEST(IntVector, OperatorBracketsLHS)
         ASSERT_EQ( vec[i], vec2[i]);
 }
 
-// WITH ERRORS
-// TEST(IntVector, AtRHS)
-// {
-//     const sc::vector<int> vec { 1, 2, 3, 4, 5 };
-//     const sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
+TEST(IntVector, AtRHS)
+{
+    const sc::vector<int> vec { 1, 2, 3, 4, 5 };
+    const sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
 
-//     for ( auto i{0u} ; i < vec.size() ; ++i )
-//         ASSERT_EQ( vec.at(i), vec2.at(i));
+    for ( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec.at(i), vec2.at(i));
 
-//     bool worked{false};
-//     try { vec.at( 40 ); }
-//     catch( std::out_of_range & e )
-//     { worked = true; }
+    bool worked{false};
+    try { vec.at( 40 ); }
+    catch( std::out_of_range & e )
+    { worked = true; }
 
-//     ASSERT_TRUE( worked );
-// }
+    ASSERT_TRUE( worked );
+}
 
 TEST(IntVector, AtLHS)
 {
@@ -351,195 +351,935 @@ TEST(IntVector, ShrinkToFit)
         ASSERT_EQ( e , ++i );
 }
 
-// WITH ERRORS
-// TEST(IntVector, OperatorEqual)
-// {
-//     // #1 From an empty vector.
-//     sc::vector<int> vec { 1, 2, 3, 4, 5 };
-//     sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
-//     sc::vector<int> vec3 { 1, 2, 8, 4, 5 };
-//     sc::vector<int> vec4 { 8, 4, 5 };
-
-//     ASSERT_EQ( vec , vec2 );
-//     ASSERT_TRUE( not ( vec == vec3 ) );
-//     ASSERT_TRUE( not ( vec == vec4 ) );
-// }
-
-// WITH ERRORS
-// TEST(IntVector, OperatorDifferent)
-// {
-//     // #1 From an empty vector.
-//     sc::vector<int> vec { 1, 2, 3, 4, 5 };
-//     sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
-//     sc::vector<int> vec3 { 1, 2, 8, 4, 5 };
-//     sc::vector<int> vec4 { 8, 4, 5 };
-
-//     ASSERT_TRUE( not( vec != vec2 ) );
-//     ASSERT_NE( vec, vec3 );
-//     ASSERT_NE( vec,vec4 );
-// }
-
-// WITH ERRORS
-// TEST(IntVector, InsertSingleValueAtPosition)
-// {
-//     // #1 From an empty vector.
-//     sc::vector<int> vec { 1, 2, 4, 5, 6 };
-
-//     // Insert at front
-//     vec.insert( vec.begin(), 0 );
-//     ASSERT_EQ( vec , ( sc::vector<int>{ 0, 1, 2, 4, 5, 6 } ) );
-//     // Insert in the middle
-//     vec.insert( vec.begin()+3, 3 );
-//     ASSERT_EQ( vec , ( sc::vector<int>{ 0, 1, 2, 3, 4, 5, 6 } ) );
-//     // Insert at the end
-//     vec.insert( vec.end(), 7 );
-//     ASSERT_EQ( vec , ( sc::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 } ) );
-// }
-
-// WITH ERRORS
-// TEST(IntVector, InsertRange)
-// {
-// 	// Aux arrays. 
-// 	sc::vector<int> vec1 { 1, 2, 3, 4, 5 };
-//     sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
-//     sc::vector<int> source { 6, 7, 8, 9, 10 };
-
-//     // Inset at the begining.
-//     vec1.insert( vec1.begin(), source.begin(), source.end() );
-//     ASSERT_EQ( vec1 , ( sc::vector<int>{ 6, 7, 8, 9, 10, 1, 2, 3, 4, 5 } ) );
-
-//     // In the middle
-//     vec1 = vec2;
-//     vec1.insert( vec1.begin()+2, source.begin(), source.end() );
-//     ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 6, 7, 8, 9, 10, 3, 4, 5 } ) );
-
-//     // At the end
-//     vec1 = vec2;
-//     vec1.insert( vec1.end(), source.begin(), source.end() );
-//     ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 } ) );
-
-//     // Outside
-//     vec1 = vec2;
-//     vec1.insert( vec1.end()+2, source.begin(), source.end() );
-//     ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 3, 4, 5 } ) );
-
-// }
-
-// WITH ERRORS
-// TEST(IntVector, InsertInitializarList)
-// {
-//     // Aux arrays.
-//     sc::vector<int> vec1 { 1, 2, 3, 4, 5 };
-//     sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
-//     sc::vector<int> source { 6, 7, 8, 9, 10 };
-
-//     // Inset at the begining.
-//     vec1.insert( vec1.begin(), { 6, 7, 8, 9, 10 } );
-//     ASSERT_EQ( vec1 , ( sc::vector<int>{ 6, 7, 8, 9, 10, 1, 2, 3, 4, 5 } ) );
-
-//     // In the middle
-//     vec1 = vec2;
-//     vec1.insert( vec1.begin()+2, { 6, 7, 8, 9, 10 } );
-//     ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 6, 7, 8, 9, 10, 3, 4, 5 } ) );
-
-//     // At the end
-//     vec1 = vec2;
-//     vec1.insert( vec1.end(), { 6, 7, 8, 9, 10 } );
-//     ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 } ) );
-
-//     // Outside
-//     vec1 = vec2;
-//     vec1.insert( vec1.end()+2, { 6, 7, 8, 9, 10 } );
-//     ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 3, 4, 5 } ) );
-// }
-
-// WITH ERRORS
-// TEST(IntVector, AssignCountValue2)
-// {
-//         // Initial vector.
-//         sc::vector<char> vec { 'a', 'b', 'c', 'd', 'e' };
-
-//         // assigning count values to sc::vector, with count < size().
-//         vec.assign( 3, 'x' );
-//         ASSERT_EQ( vec , ( sc::vector<char>{ 'x', 'x', 'x' } ) );
-//         ASSERT_EQ( vec.size() , 3 );
-//         ASSERT_EQ( vec.capacity() , 5 );
-
-//         // assigning count values to sc::vector, with count , size().
-//         vec = { 'a', 'b', 'c', 'd', 'e' };
-//         vec.assign( 5, 'y' );
-//         ASSERT_EQ( vec , ( sc::vector<char>{ 'y','y','y','y','y' } ) );
-//         ASSERT_EQ( vec.size() , 5 );
-//         ASSERT_EQ( vec.capacity() , 5 );
-
-//         // assigning count values to sc::vector, with count > size().
-//         vec = { 'a', 'b', 'c', 'd', 'e' };
-//         vec.assign( 8, 'z' );
-//         ASSERT_EQ( vec , ( sc::vector<char>{ 'z','z','z','z','z','z','z','z' } ) );
-//         ASSERT_EQ( vec.size() , 8 );
-//         ASSERT_EQ( vec.capacity() , 8 );
-// }
-
-// WITH ERRORS
-// TEST(IntVector, EraseRange)
-// {
-//     // Initial vector.
-//     sc::vector<int> vec { 1, 2, 3, 4, 5 };
-
-//     // removing a segment from the beginning.
-//     auto past_last = vec.erase( vec.begin(), vec.begin()+3 );
-//     ASSERT_EQ( vec.begin() , past_last );
-//     ASSERT_EQ( vec , ( sc::vector<int>{ 4, 5 } ) );
-//     ASSERT_EQ( vec.size() , 2 );
-
-//     // removing at the middle.
-//     vec = { 1, 2, 3, 4, 5 };
-//     past_last = vec.erase( vec.begin()+1, vec.begin()+4 );
-//     ASSERT_EQ( vec.begin()+1, past_last );
-//     ASSERT_EQ( vec , ( sc::vector<int>{ 1, 5 } ) );
-//     ASSERT_EQ( vec.size() , 2 );
-
-//     // removing a segment that reached the end.
-//     vec = { 1, 2, 3, 4, 5 };
-//     past_last = vec.erase( vec.begin()+2, vec.end() );
-//     ASSERT_EQ( vec.end() , past_last );
-//     ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2 } ) );
-//     ASSERT_EQ( vec.size() , 2 );
-
-//     // removing the entire vector.
-//     vec = { 1, 2, 3, 4, 5 };
-//     past_last = vec.erase( vec.begin(), vec.end() );
-//     ASSERT_EQ( vec.end() , past_last );
-//     ASSERT_TRUE( vec.empty() );
-// }
-
-// WITH ERRORS
-// TEST(IntVector, ErasePos)
-// {
-//     // Initial vector.
-//     sc::vector<int> vec { 1, 2, 3, 4, 5 };
-
-//     // removing a single element.
-//     vec = { 1, 2, 3, 4, 5 };
-//     auto past_last = vec.erase( vec.begin() );
-//     ASSERT_EQ( vec , ( sc::vector<int>{ 2, 3, 4, 5 } ) );
-//     ASSERT_EQ( vec.begin() , past_last );
-//     ASSERT_EQ( vec.size() , 4 );
-
-//     // removing a single element in the middle.
-//     vec = { 1, 2, 3, 4, 5 };
-//     past_last = vec.erase( vec.begin()+2 );
-//     ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2, 4, 5 } ) );
-//     ASSERT_EQ( vec.begin()+2 , past_last );
-//     ASSERT_EQ( vec.size() , 4 );
-
-//     // removing a single element at the end.
-//     vec = { 1, 2, 3, 4, 5 };
-//     past_last = vec.erase( vec.begin()+vec.size()-1 );
-//     ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2, 3, 4 } ) );
-//     ASSERT_EQ( vec.end() , past_last );
-//     ASSERT_EQ( vec.size() , 4 );
-// }
+TEST(IntVector, OperatorEqual)
+{
+    // #1 From an empty vector.
+    sc::vector<int> vec { 1, 2, 3, 4, 5 };
+    sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
+    sc::vector<int> vec3 { 1, 2, 8, 4, 5 };
+    sc::vector<int> vec4 { 8, 4, 5 };
+
+    ASSERT_EQ( vec , vec2 );
+    ASSERT_TRUE( not ( vec == vec3 ) );
+    ASSERT_TRUE( not ( vec == vec4 ) );
+}
+
+TEST(IntVector, OperatorDifferent)
+{
+    // #1 From an empty vector.
+    sc::vector<int> vec { 1, 2, 3, 4, 5 };
+    sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
+    sc::vector<int> vec3 { 1, 2, 8, 4, 5 };
+    sc::vector<int> vec4 { 8, 4, 5 };
+
+    ASSERT_TRUE( not( vec != vec2 ) );
+    ASSERT_NE( vec, vec3 );
+    ASSERT_NE( vec,vec4 );
+}
+
+TEST(IntVector, InsertSingleValueAtPosition)
+{
+    // #1 From an empty vector.
+    sc::vector<int> vec { 1, 2, 4, 5, 6 };
+
+    // Insert at front
+    vec.insert( vec.begin(), 0 );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 0, 1, 2, 4, 5, 6 } ) );
+    // Insert in the middle
+    vec.insert( vec.begin()+3, 3 );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 0, 1, 2, 3, 4, 5, 6 } ) );
+    // Insert at the end
+    vec.insert( vec.end(), 7 );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 } ) );
+}
+
+TEST(IntVector, InsertRange)
+{
+	// Aux arrays. 
+	sc::vector<int> vec1 { 1, 2, 3, 4, 5 };
+    sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
+    sc::vector<int> source { 6, 7, 8, 9, 10 };
+
+    // Inset at the begining.
+    vec1.insert( vec1.begin(), source.begin(), source.end() );
+    ASSERT_EQ( vec1 , ( sc::vector<int>{ 6, 7, 8, 9, 10, 1, 2, 3, 4, 5 } ) );
+
+    // In the middle
+    vec1 = vec2;
+    vec1.insert( vec1.begin()+2, source.begin(), source.end() );
+    ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 6, 7, 8, 9, 10, 3, 4, 5 } ) );
+
+    // At the end
+    vec1 = vec2;
+    vec1.insert( vec1.end(), source.begin(), source.end() );
+    ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 } ) );
+
+    // Outside
+    vec1 = vec2;
+    vec1.insert( vec1.end()+2, source.begin(), source.end() );
+    ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 3, 4, 5 } ) );
+
+}
+
+TEST(IntVector, InsertInitializarList)
+{
+    // Aux arrays.
+    sc::vector<int> vec1 { 1, 2, 3, 4, 5 };
+    sc::vector<int> vec2 { 1, 2, 3, 4, 5 };
+    sc::vector<int> source { 6, 7, 8, 9, 10 };
+
+    // Inset at the begining.
+    vec1.insert( vec1.begin(), { 6, 7, 8, 9, 10 } );
+    ASSERT_EQ( vec1 , ( sc::vector<int>{ 6, 7, 8, 9, 10, 1, 2, 3, 4, 5 } ) );
+
+    // In the middle
+    vec1 = vec2;
+    vec1.insert( vec1.begin()+2, { 6, 7, 8, 9, 10 } );
+    ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 6, 7, 8, 9, 10, 3, 4, 5 } ) );
+
+    // At the end
+    vec1 = vec2;
+    vec1.insert( vec1.end(), { 6, 7, 8, 9, 10 } );
+    ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 } ) );
+
+    // Outside
+    vec1 = vec2;
+    vec1.insert( vec1.end()+2, { 6, 7, 8, 9, 10 } );
+    ASSERT_EQ( vec1 , ( sc::vector<int>{ 1, 2, 3, 4, 5 } ) );
+}
+
+TEST(IntVector, AssignCountValue2)
+{
+        // Initial vector.
+        sc::vector<char> vec { 'a', 'b', 'c', 'd', 'e' };
+
+        // assigning count values to sc::vector, with count < size().
+        vec.assign( 3, 'x' );
+        ASSERT_EQ( vec , ( sc::vector<char>{ 'x', 'x', 'x' } ) );
+        ASSERT_EQ( vec.size() , 3 );
+        ASSERT_EQ( vec.capacity() , 5 );
+
+        // assigning count values to sc::vector, with count , size().
+        vec = { 'a', 'b', 'c', 'd', 'e' };
+        vec.assign( 5, 'y' );
+        ASSERT_EQ( vec , ( sc::vector<char>{ 'y','y','y','y','y' } ) );
+        ASSERT_EQ( vec.size() , 5 );
+        ASSERT_EQ( vec.capacity() , 5 );
+
+        // assigning count values to sc::vector, with count > size().
+        vec = { 'a', 'b', 'c', 'd', 'e' };
+        vec.assign( 8, 'z' );
+        ASSERT_EQ( vec , ( sc::vector<char>{ 'z','z','z','z','z','z','z','z' } ) );
+        ASSERT_EQ( vec.size() , 8 );
+        ASSERT_EQ( vec.capacity() , 8 );
+}
+
+TEST(IntVector, EraseRange)
+{
+    // Initial vector.
+    sc::vector<int> vec { 1, 2, 3, 4, 5 };
+
+    // removing a segment from the beginning.
+    auto past_last = vec.erase( vec.begin(), vec.begin()+3 );
+    ASSERT_EQ( vec.begin() , past_last );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 4, 5 } ) );
+    ASSERT_EQ( vec.size() , 2 );
+
+    // removing at the middle.
+    vec = { 1, 2, 3, 4, 5 };
+    past_last = vec.erase( vec.begin()+1, vec.begin()+4 );
+    ASSERT_EQ( vec.begin()+1, past_last );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 5 } ) );
+    ASSERT_EQ( vec.size() , 2 );
+
+    // removing a segment that reached the end.
+    vec = { 1, 2, 3, 4, 5 };
+    past_last = vec.erase( vec.begin()+2, vec.end() );
+    ASSERT_EQ( vec.end() , past_last );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2 } ) );
+    ASSERT_EQ( vec.size() , 2 );
+
+    // removing the entire vector.
+    vec = { 1, 2, 3, 4, 5 };
+    past_last = vec.erase( vec.begin(), vec.end() );
+    ASSERT_EQ( vec.end() , past_last );
+    ASSERT_TRUE( vec.empty() );
+
+    // removing an empty range from a vector that never allocated.
+    sc::vector<int> never;
+    past_last = never.erase( never.begin(), never.end() );
+    ASSERT_EQ( never.end() , past_last );
+    ASSERT_TRUE( never.empty() );
+}
+
+TEST(IntVector, ErasePos)
+{
+    // Initial vector.
+    sc::vector<int> vec { 1, 2, 3, 4, 5 };
+
+    // removing a single element.
+    vec = { 1, 2, 3, 4, 5 };
+    auto past_last = vec.erase( vec.begin() );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 2, 3, 4, 5 } ) );
+    ASSERT_EQ( vec.begin() , past_last );
+    ASSERT_EQ( vec.size() , 4 );
+
+    // removing a single element in the middle.
+    vec = { 1, 2, 3, 4, 5 };
+    past_last = vec.erase( vec.begin()+2 );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2, 4, 5 } ) );
+    ASSERT_EQ( vec.begin()+2 , past_last );
+    ASSERT_EQ( vec.size() , 4 );
+
+    // removing a single element at the end.
+    vec = { 1, 2, 3, 4, 5 };
+    past_last = vec.erase( vec.begin()+vec.size()-1 );
+    ASSERT_EQ( vec , ( sc::vector<int>{ 1, 2, 3, 4 } ) );
+    ASSERT_EQ( vec.end() , past_last );
+    ASSERT_EQ( vec.size() , 4 );
+}
+
+// ============================================================================
+// TESTING VECTOR AS A CONTAINER OF STRINGS (MOVE SEMANTICS)
+// ============================================================================
+
+// Counts how many times an object was copied or moved.
+struct Tracked
+{
+    static int copies;
+    static int moves;
+    int value;
+
+    Tracked( int v = 0 ) : value{v} {}
+    Tracked( const Tracked & o ) : value{o.value} { copies++; }
+    Tracked( Tracked && o ) noexcept : value{o.value} { moves++; }
+    Tracked & operator=( const Tracked & o ) { value = o.value; copies++; return *this; }
+    Tracked & operator=( Tracked && o ) noexcept { value = o.value; moves++; return *this; }
+};
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+TEST(StringVector, MoveConstructor)
+{
+    sc::vector<std::string> vec{ "a", "b", "c" };
+    sc::vector<std::string> vec2( std::move( vec ) );
+
+    ASSERT_EQ( vec2.size(), 3 );
+    EXPECT_EQ( vec2[0], "a" );
+    EXPECT_EQ( vec2[2], "c" );
+    EXPECT_TRUE( vec.empty() );
+    EXPECT_EQ( vec.capacity(), 0 );
+
+    // The moved-from vector must still be usable.
+    vec.push_back( "d" );
+    ASSERT_EQ( vec.size(), 1 );
+    EXPECT_EQ( vec[0], "d" );
+}
+
+TEST(StringVector, MoveAssign)
+{
+    sc::vector<std::string> vec{ "a", "b", "c" };
+    sc::vector<std::string> vec2{ "x" };
+
+    vec2 = std::move( vec );
+    ASSERT_EQ( vec2.size(), 3 );
+    EXPECT_EQ( vec2[1], "b" );
+    EXPECT_TRUE( vec.empty() );
+}
+
+TEST(StringVector, PushBackRvalue)
+{
+    sc::vector<std::string> vec;
+    std::string value( 100, 'x' );
+
+    vec.push_back( std::move( value ) );
+    ASSERT_EQ( vec.size(), 1 );
+    EXPECT_EQ( vec[0], std::string( 100, 'x' ) );
+    EXPECT_TRUE( value.empty() );
+}
+
+TEST(StringVector, EmplaceBack)
+{
+    sc::vector<std::string> vec;
+
+    for( auto i{0} ; i < 10 ; ++i )
+        vec.emplace_back( i+1, 'a' );
+
+    ASSERT_EQ( vec.size(), 10 );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], std::string( i+1, 'a' ) );
+
+    // Emplacing an element of the vector itself must survive the reallocation.
+    vec.shrink_to_fit();
+    vec.emplace_back( vec[0] );
+    ASSERT_EQ( vec.size(), 11 );
+    EXPECT_EQ( vec[10], "a" );
+}
+
+TEST(StringVector, Emplace)
+{
+    sc::vector<std::string> vec{ "b", "d" };
+
+    auto it = vec.emplace( vec.begin(), 1, 'a' );
+    EXPECT_EQ( *it, "a" );
+    it = vec.emplace( vec.begin()+2, "c" );
+    EXPECT_EQ( *it, "c" );
+    vec.emplace( vec.end(), "e" );
+
+    ASSERT_EQ( vec.size(), 5 );
+    const char * expected[] = { "a", "b", "c", "d", "e" };
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], expected[i] );
+}
+
+TEST(StringVector, ReserveMovesElements)
+{
+    sc::vector<Tracked> vec;
+    for( auto i{0} ; i < 5 ; ++i )
+        vec.emplace_back( i );
+
+    Tracked::copies = 0;
+    vec.reserve( 100 );
+    EXPECT_EQ( Tracked::copies, 0 );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i].value, (int) i );
+}
+
+// ============================================================================
+// TESTING VECTOR STORAGE (RAW MEMORY AND ALLOCATORS)
+// ============================================================================
+
+// Counts constructions and destructions of live objects.
+struct Counted
+{
+    static int alive;
+    int value;
+
+    explicit Counted( int v ) : value{v} { alive++; }
+    Counted( const Counted & o ) : value{o.value} { alive++; }
+    ~Counted() { alive--; }
+    Counted & operator=( const Counted & o ) = default;
+};
+int Counted::alive = 0;
+
+// std::allocator that records the bytes it hands out.
+template< typename T >
+struct CountingAllocator
+{
+    typedef T value_type;
+    static long bytes;
+
+    CountingAllocator() = default;
+    template< typename U > CountingAllocator( const CountingAllocator<U> & ) {}
+
+    T * allocate( size_t n ) { bytes += n * sizeof(T); return std::allocator<T>().allocate( n ); }
+    void deallocate( T * p, size_t n ) { bytes -= n * sizeof(T); std::allocator<T>().deallocate( p, n ); }
+
+    bool operator==( const CountingAllocator & ) const { return true; }
+    bool operator!=( const CountingAllocator & ) const { return false; }
+};
+template< typename T > long CountingAllocator<T>::bytes = 0;
+
+TEST(VectorStorage, ReserveConstructsNothing)
+{
+    {
+        sc::vector<Counted> vec( 100 );
+        EXPECT_EQ( Counted::alive, 0 );
+        vec.reserve( 1000 );
+        EXPECT_EQ( Counted::alive, 0 );
+
+        for( auto i{0} ; i < 10 ; ++i )
+            vec.emplace_back( i );
+        EXPECT_EQ( Counted::alive, 10 );
+
+        vec.pop_back();
+        EXPECT_EQ( Counted::alive, 9 );
+        vec.shrink_to_fit();
+        EXPECT_EQ( Counted::alive, 9 );
+        vec.clear();
+        EXPECT_EQ( Counted::alive, 0 );
+
+        vec.assign( 4, Counted( 7 ) );
+        EXPECT_EQ( Counted::alive, 4 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+}
+
+TEST(VectorStorage, NotDefaultConstructible)
+{
+    sc::vector<Counted> vec;
+    vec.push_back( Counted( 2 ) );
+    vec.push_front( Counted( 1 ) );
+    vec.emplace_back( 3 );
+
+    sc::vector<Counted> vec2( vec );
+    vec2 = vec;
+
+    ASSERT_EQ( vec2.size(), 3 );
+    for( auto i{0u} ; i < vec2.size() ; ++i )
+        ASSERT_EQ( (int) i+1, vec2[i].value );
+}
+
+TEST(VectorStorage, Allocator)
+{
+    {
+        sc::vector<int, CountingAllocator<int>> vec;
+        EXPECT_EQ( CountingAllocator<int>::bytes, 0 );
+
+        vec.reserve( 16 );
+        EXPECT_EQ( CountingAllocator<int>::bytes, (long)( 16 * sizeof(int) ) );
+
+        for( auto i{0} ; i < 40 ; ++i )
+            vec.push_back( i );
+        EXPECT_EQ( CountingAllocator<int>::bytes, (long)( vec.capacity() * sizeof(int) ) );
+
+        sc::vector<int, CountingAllocator<int>> vec2( vec );
+        EXPECT_EQ( CountingAllocator<int>::bytes, (long)( ( vec.capacity() + vec2.capacity() ) * sizeof(int) ) );
+    }
+    EXPECT_EQ( CountingAllocator<int>::bytes, 0 );
+}
+
+TEST(VectorStorage, InsertRangeStrings)
+{
+    sc::vector<std::string> source{ "x", "y", "z" };
+
+    // In place, tail longer than the range.
+    sc::vector<std::string> vec{ "a", "b", "c", "d", "e" };
+    vec.reserve( 10 );
+    vec.insert( vec.begin()+1, source.begin(), source.end() );
+    const char * expected1[] = { "a", "x", "y", "z", "b", "c", "d", "e" };
+    ASSERT_EQ( vec.size(), 8 );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], expected1[i] );
+
+    // In place, tail shorter than the range.
+    vec = { "a", "b" };
+    vec.insert( vec.begin()+1, source.begin(), source.end() );
+    const char * expected2[] = { "a", "x", "y", "z", "b" };
+    ASSERT_EQ( vec.size(), 5 );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], expected2[i] );
+
+    // With reallocation.
+    vec.shrink_to_fit();
+    vec.insert( vec.end(), { "1", "2" } );
+    ASSERT_EQ( vec.size(), 7 );
+    EXPECT_EQ( vec[5], "1" );
+    EXPECT_EQ( vec[6], "2" );
+}
+
+// ============================================================================
+// TESTING TRIVIALLY COPYABLE AND RELOCATABLE FAST PATHS
+// ============================================================================
+
+struct Pod
+{
+    long key;
+    double value;
+};
+
+// Owns a heap int: not trivially copyable, but safe to move with memcpy.
+struct Owner
+{
+    std::unique_ptr<int> p;
+    explicit Owner( int v ) : p{ new int(v) } {}
+};
+
+namespace sc {
+    template<> struct is_trivially_relocatable<Owner> : std::true_type {};
+}
+
+TEST(TrivialVector, GrowthKeepsValues)
+{
+    sc::vector<Pod> vec;
+    for( auto i{0} ; i < 1000 ; ++i )
+        vec.push_back( Pod{ i, i * 0.5 } );
+
+    sc::vector<Pod> vec2( vec );
+    vec2.shrink_to_fit();
+    ASSERT_EQ( vec2.size(), 1000 );
+    ASSERT_EQ( vec2.capacity(), 1000 );
+    for( auto i{0u} ; i < vec2.size() ; ++i )
+    {
+        ASSERT_EQ( vec2[i].key, (long) i );
+        ASSERT_EQ( vec2[i].value, i * 0.5 );
+    }
+}
+
+TEST(TrivialVector, InsertErase)
+{
+    sc::vector<long> vec{ 1, 2, 3, 4, 5 };
+    vec.reserve( 20 );
+
+    vec.insert( vec.begin()+2, { 10, 11 } );
+    vec.insert( vec.begin(), 0 );
+    long expected1[] = { 0, 1, 2, 10, 11, 3, 4, 5 };
+    ASSERT_EQ( vec.size(), 8 );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], expected1[i] );
+
+    auto it = vec.erase( vec.begin()+3, vec.begin()+5 );
+    EXPECT_EQ( *it, 3 );
+    it = vec.erase( vec.begin() );
+    EXPECT_EQ( *it, 1 );
+    ASSERT_EQ( vec.size(), 5 );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], (long) i+1 );
+
+    // Assigning a part of the vector onto itself.
+    vec.assign( vec.begin()+1, vec.end() );
+    ASSERT_EQ( vec.size(), 4 );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], (long) i+2 );
+}
+
+TEST(TrivialVector, RelocatableOwner)
+{
+    sc::vector<Owner> vec;
+    for( auto i{0} ; i < 100 ; ++i )
+        vec.emplace_back( i );
+
+    vec.emplace( vec.begin(), -1 );
+    vec.erase( vec.begin()+50 );
+    vec.pop_front();
+    vec.shrink_to_fit();
+
+    ASSERT_EQ( vec.size(), 99 );
+    for( auto i{0} ; i < 49 ; ++i )
+        ASSERT_EQ( *vec[i].p, i );
+    for( auto i{49} ; i < 99 ; ++i )
+        ASSERT_EQ( *vec[i].p, i+1 );
+}
+
+TEST(StringVector, EraseEmptyRange)
+{
+    sc::vector<std::string> vec{ "alpha", "beta", "gamma" };
+
+    auto it = vec.erase( vec.begin()+1, vec.begin()+1 );
+    EXPECT_EQ( *it, "beta" );
+    it = vec.erase( vec.end(), vec.end() );
+    EXPECT_TRUE( it == vec.end() );
+    ASSERT_EQ( vec.size(), 3 );
+    EXPECT_EQ( vec[0], "alpha" );
+    EXPECT_EQ( vec[1], "beta" );
+    EXPECT_EQ( vec[2], "gamma" );
+}
+
+TEST(StringVector, InsertErase)
+{
+    sc::vector<std::string> vec{ "a", "b", "c", "d", "e" };
+
+    auto it = vec.erase( vec.begin()+1, vec.begin()+3 );
+    EXPECT_EQ( *it, "d" );
+    it = vec.erase( vec.end() - 1 );
+    EXPECT_TRUE( it == vec.end() );
+    ASSERT_EQ( vec.size(), 2 );
+    EXPECT_EQ( vec[0], "a" );
+    EXPECT_EQ( vec[1], "d" );
+
+    vec.reserve( 10 );
+    vec.insert( vec.begin()+1, std::string( "x" ) );
+    vec.pop_front();
+    ASSERT_EQ( vec.size(), 2 );
+    EXPECT_EQ( vec[0], "x" );
+    EXPECT_EQ( vec[1], "d" );
+}
+
+// ============================================================================
+// TESTING ITERATORS
+// ============================================================================
+
+TEST(VectorIterator, Traits)
+{
+    typedef std::iterator_traits< sc::vector<int>::iterator > traits;
+    typedef std::iterator_traits< sc::vector<int>::const_iterator > const_traits;
+
+    EXPECT_TRUE(( std::is_same< traits::iterator_category, std::random_access_iterator_tag >::value ));
+    EXPECT_TRUE(( std::is_same< traits::reference, int& >::value ));
+    EXPECT_TRUE(( std::is_same< const_traits::iterator_category, std::random_access_iterator_tag >::value ));
+    EXPECT_TRUE(( std::is_same< const_traits::reference, const int& >::value ));
+    EXPECT_TRUE(( std::is_same< traits::difference_type, std::ptrdiff_t >::value ));
+}
+
+TEST(VectorIterator, Arithmetic)
+{
+    sc::vector<int> vec{ 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    auto it = vec.begin();
+    it += 5;
+    EXPECT_EQ( *it, 6 );
+    it -= 2;
+    EXPECT_EQ( *it, 4 );
+    EXPECT_EQ( it[2], 6 );
+    EXPECT_EQ( *(2 + it), 6 );
+    EXPECT_EQ( *(it - 3), 1 );
+    EXPECT_EQ( vec.end() - vec.begin(), 8 );
+    EXPECT_TRUE( vec.begin() < vec.end() );
+    EXPECT_TRUE( vec.end() >= it );
+    EXPECT_EQ( std::distance( vec.begin(), vec.end() ), 8 );
+
+    // Mixing mutable and constant iterators.
+    sc::vector<int>::const_iterator cit = it;
+    EXPECT_TRUE( cit == it );
+    EXPECT_TRUE( it == cit );
+    EXPECT_TRUE( vec.cbegin() < cit );
+    EXPECT_EQ( vec.cend() - vec.cbegin(), 8 );
+}
+
+TEST(VectorIterator, StandardAlgorithms)
+{
+    sc::vector<int> vec{ 5, 3, 8, 1, 9, 2, 7 };
+
+    std::sort( vec.begin(), vec.end() );
+    EXPECT_TRUE( std::is_sorted( vec.begin(), vec.end() ) );
+
+    auto it = std::lower_bound( vec.begin(), vec.end(), 7 );
+    EXPECT_EQ( it - vec.begin(), 4 );
+    EXPECT_EQ( *it, 7 );
+
+    std::reverse( vec.begin(), vec.end() );
+    EXPECT_EQ( *std::min_element( vec.cbegin(), vec.cend() ), 1 );
+    EXPECT_EQ( vec[0], 9 );
+}
+
+TEST(VectorIterator, ConstVector)
+{
+    const sc::vector<std::string> vec{ "a", "bb", "ccc" };
+
+    auto i{1u};
+    for( const auto & e : vec )
+        ASSERT_EQ( e.size(), i++ );
+
+    EXPECT_EQ( vec.begin()->size(), 1u );
+    EXPECT_EQ( std::count_if( vec.cbegin(), vec.cend(),
+                              []( const std::string & s ){ return s.size() > 1; } ), 2 );
+}
+
+// ============================================================================
+// TESTING FRONT SLACK (DOUBLE ENDED USE)
+// ============================================================================
+
+TEST(FrontSlack, PushFrontOrder)
+{
+    sc::vector<int> vec;
+    for( auto i{0} ; i < 100 ; ++i )
+        vec.push_front( i );
+
+    ASSERT_EQ( vec.size(), 100 );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], (int)( 99 - i ) );
+
+    // Feeding both ends.
+    vec.push_back( -1 );
+    vec.push_front( 100 );
+    EXPECT_EQ( vec.front(), 100 );
+    EXPECT_EQ( vec.back(), -1 );
+    EXPECT_EQ( vec.size(), 102 );
+}
+
+TEST(FrontSlack, PushFrontAmortized)
+{
+    sc::vector<Tracked> vec;
+    const int n = 1024;
+
+    Tracked::moves = 0;
+    for( auto i{0} ; i < n ; ++i )
+        vec.push_front( Tracked( i ) );
+
+    // One move per push plus the relocations of a geometric growth.
+    EXPECT_LE( Tracked::moves, 3 * n );
+    for( auto i{0} ; i < n ; ++i )
+        ASSERT_EQ( vec[i].value, n - 1 - i );
+}
+
+TEST(FrontSlack, QueueDoesNotAllocate)
+{
+    {
+        sc::vector<int, CountingAllocator<int>> queue;
+        for( auto i{0} ; i < 64 ; ++i )
+            queue.push_back( i );
+
+        // After the first growth, the list only slides within its storage.
+        long bytes{0};
+        auto next{64};
+        for( auto round{0} ; round < 10000 ; ++round )
+        {
+            ASSERT_EQ( queue.front(), next - 64 );
+            queue.pop_front();
+            queue.push_back( next++ );
+
+            if( round == 64 )
+                bytes = CountingAllocator<int>::bytes;
+        }
+        EXPECT_EQ( CountingAllocator<int>::bytes, bytes );
+        ASSERT_EQ( queue.size(), 64 );
+        for( auto i{0u} ; i < queue.size() ; ++i )
+            ASSERT_EQ( queue[i], next - 64 + (int) i );
+    }
+    EXPECT_EQ( CountingAllocator<int>::bytes, 0 );
+}
+
+TEST(FrontSlack, PopFrontStrings)
+{
+    {
+        sc::vector<Counted> vec;
+        for( auto i{0} ; i < 10 ; ++i )
+            vec.emplace_back( i );
+
+        vec.pop_front();
+        vec.pop_front();
+        EXPECT_EQ( Counted::alive, 8 );
+        EXPECT_EQ( vec.front().value, 2 );
+
+        vec.emplace_front( 1 );
+        EXPECT_EQ( Counted::alive, 9 );
+        EXPECT_EQ( vec.front().value, 1 );
+
+        vec.shrink_to_fit();
+        EXPECT_EQ( vec.capacity(), 9 );
+        EXPECT_EQ( vec.back().value, 9 );
+    }
+    EXPECT_EQ( Counted::alive, 0 );
+
+    // Growing into the front slack with an element of the list itself.
+    sc::vector<std::string> vec{ "a", "b", "c", "d", "e", "f" };
+    for( auto i{0} ; i < 4 ; ++i )
+        vec.pop_front();
+    vec.push_back( vec[0] );
+    vec.push_back( vec[1] );
+    ASSERT_EQ( vec.size(), 4 );
+    EXPECT_EQ( vec[2], "e" );
+    EXPECT_EQ( vec[3], "f" );
+}
+
+TEST(FrontSlack, PushFrontUsesReservedStorage)
+{
+    // Twice the room needed: the list shifts up into the back half once, then fills the front slack.
+    sc::vector<std::string, CountingAllocator<std::string>> vec;
+    vec.reserve( 200 );
+    long bytes = CountingAllocator<std::string>::bytes;
+
+    for( auto i{0} ; i < 100 ; ++i )
+        vec.push_front( std::string( 1, char( 'a' + i % 26 ) ) );
+
+    EXPECT_EQ( CountingAllocator<std::string>::bytes, bytes );
+    ASSERT_EQ( vec.size(), 100 );
+    for( auto i{0} ; i < 100 ; ++i )
+        ASSERT_EQ( vec[99 - i], std::string( 1, char( 'a' + i % 26 ) ) );
+}
+
+// ============================================================================
+// TESTING BULK INSERT, APPEND AND RESIZE
+// ============================================================================
+
+TEST(BulkInsert, ResizeGrowsAndShrinks)
+{
+    sc::vector<int> vec{ 1, 2, 3 };
+
+    vec.resize( 6 );
+    ASSERT_EQ( vec.size(), 6u );
+    EXPECT_EQ( vec, ( sc::vector<int>{ 1, 2, 3, 0, 0, 0 } ) );
+
+    vec.resize( 8, 7 );
+    EXPECT_EQ( vec, ( sc::vector<int>{ 1, 2, 3, 0, 0, 0, 7, 7 } ) );
+
+    size_t capacity = vec.capacity();
+    vec.resize( 2 );
+    EXPECT_EQ( vec, ( sc::vector<int>{ 1, 2 } ) );
+    EXPECT_EQ( vec.capacity(), capacity );
+
+    // The value may be an element of the list itself.
+    vec.resize( 100, vec[1] );
+    EXPECT_EQ( vec.count( 2 ), 99u );
+}
+
+TEST(BulkInsert, ResizeStrings)
+{
+    sc::vector<std::string> vec{ "a", "b" };
+
+    vec.resize( 40, std::string( 30, 'x' ) );
+    ASSERT_EQ( vec.size(), 40u );
+    EXPECT_EQ( vec[1], "b" );
+    EXPECT_EQ( vec[39], std::string( 30, 'x' ) );
+
+    vec.resize( 1 );
+    ASSERT_EQ( vec.size(), 1u );
+    EXPECT_EQ( vec[0], "a" );
+
+    Counted::alive = 0;
+    sc::vector<Counted> counted;
+    counted.resize( 10, Counted( 5 ) );
+    EXPECT_EQ( Counted::alive, 10 );
+    counted.resize( 3, Counted( 6 ) );
+    EXPECT_EQ( Counted::alive, 3 );
+    EXPECT_EQ( counted[2].value, 5 );
+}
+
+TEST(BulkInsert, AppendGrowsGeometrically)
+{
+    sc::vector<int> vec;
+    std::vector<int> batch( 10 );
+    size_t reallocations{0u};
+
+    for( auto round{0} ; round < 1000 ; ++round )
+    {
+        for( auto i{0u} ; i < batch.size() ; ++i )
+            batch[i] = round * 10 + i;
+
+        size_t capacity = vec.capacity();
+        vec.push_back( batch.data(), batch.data() + batch.size() );
+        if( vec.capacity() != capacity )
+            reallocations++;
+    }
+
+    ASSERT_EQ( vec.size(), 10000u );
+    for( auto i{0u} ; i < vec.size() ; ++i )
+        ASSERT_EQ( vec[i], (int) i );
+    EXPECT_LE( reallocations, 12u );
+}
+
+TEST(BulkInsert, AppendRange)
+{
+    sc::vector<std::string> vec{ "a" };
+    std::vector<std::string> more{ "b", "c", "d" };
+
+    vec.append_range( more );
+    EXPECT_EQ( vec, ( sc::vector<std::string>{ "a", "b", "c", "d" } ) );
+
+    const sc::vector<std::string> copy( vec );
+    vec.append_range( copy );
+    ASSERT_EQ( vec.size(), 8u );
+    EXPECT_EQ( vec[4], "a" );
+    EXPECT_EQ( vec[7], "d" );
+
+    int raw[] = { 4, 5, 6 };
+    sc::vector<int> ints{ 1, 2, 3 };
+    ints.append_range( raw );
+    EXPECT_EQ( ints, ( sc::vector<int>{ 1, 2, 3, 4, 5, 6 } ) );
+}
+
+TEST(BulkInsert, InsertRangeGrowsOnce)
+{
+    sc::vector<int> vec{ 1, 2, 3, 4 };
+    sc::vector<int> source{ 7, 8, 9, 10, 11 };
+
+    vec.insert( vec.begin() + 2, source.begin(), source.end() );
+    EXPECT_EQ( vec, ( sc::vector<int>{ 1, 2, 7, 8, 9, 10, 11, 3, 4 } ) );
+    EXPECT_EQ( vec.capacity(), 9u );
+
+    // The next insert fits in the grown storage.
+    vec.push_back( 5 );
+    vec.insert( vec.begin(), { -1, 0 } );
+    EXPECT_EQ( vec.capacity(), 18u );
+    EXPECT_EQ( vec, ( sc::vector<int>{ -1, 0, 1, 2, 7, 8, 9, 10, 11, 3, 4, 5 } ) );
+}
+
+// ============================================================================
+// TESTING ERASE FAMILY (ONE PASS REMOVAL)
+// ============================================================================
+
+TEST(EraseFamily, RemoveIfKeepsOrder)
+{
+    sc::vector<int> ints;
+    for( auto i{0} ; i < 100 ; ++i )
+        ints.push_back( i );
+
+    EXPECT_EQ( ints.remove_if( []( int v ) { return v % 3 == 0; } ), 34u );
+    ASSERT_EQ( ints.size(), 66u );
+    for( auto i{0u} ; i < ints.size() ; ++i )
+        ASSERT_EQ( ints[i], (int) ( i / 2 * 3 + i % 2 + 1 ) );
+
+    sc::vector<std::string> words{ "a", "bb", "c", "dd", "e" };
+    EXPECT_EQ( sc::erase_if( words, []( const std::string & w ) { return w.size() == 2; } ), 2u );
+    EXPECT_EQ( words, ( sc::vector<std::string>{ "a", "c", "e" } ) );
+    EXPECT_EQ( sc::erase( words, std::string( "z" ) ), 0u );
+
+    // The value may be an element of the list itself.
+    words.push_back( "a" );
+    EXPECT_EQ( words.remove( words[0] ), 2u );
+    EXPECT_EQ( words, ( sc::vector<std::string>{ "c", "e" } ) );
+
+    sc::vector<Owner> owners;
+    for( auto i{0} ; i < 10 ; ++i )
+        owners.emplace_back( i );
+    EXPECT_EQ( owners.remove_if( []( const Owner & o ) { return *o.p < 5; } ), 5u );
+    ASSERT_EQ( owners.size(), 5u );
+    for( auto i{0u} ; i < owners.size() ; ++i )
+        ASSERT_EQ( *owners[i].p, (int) i + 5 );
+}
+
+TEST(EraseFamily, UnorderedErase)
+{
+    sc::vector<std::string> vec{ "a", "b", "c", "d" };
+
+    auto it = vec.unordered_erase( vec.begin() + 1 );
+    EXPECT_EQ( *it, "d" );
+    EXPECT_EQ( vec, ( sc::vector<std::string>{ "a", "d", "c" } ) );
+
+    it = vec.unordered_erase( vec.end() - 1 );
+    EXPECT_TRUE( it == vec.end() );
+    EXPECT_EQ( vec, ( sc::vector<std::string>{ "a", "d" } ) );
+}
+
+TEST(EraseFamily, EraseIndices)
+{
+    sc::vector<long> vec;
+    for( auto i{0} ; i < 10 ; ++i )
+        vec.push_back( i );
+
+    EXPECT_EQ( vec.erase_indices( { 0, 3, 3, 4, 9 } ), 4u );
+    EXPECT_EQ( vec, ( sc::vector<long>{ 1, 2, 5, 6, 7, 8 } ) );
+
+    std::vector<size_t> none;
+    EXPECT_EQ( vec.erase_indices( none ), 0u );
+
+    // Bad indices throw before anything is removed.
+    EXPECT_THROW( vec.erase_indices( { 1, 6 } ), std::invalid_argument );
+    EXPECT_THROW( vec.erase_indices( { 2, 1 } ), std::invalid_argument );
+    EXPECT_EQ( vec.size(), 6u );
+
+    sc::vector<std::string> words{ "a", "b", "c", "d", "e" };
+    sc::vector<size_t> drop{ 1, 2, 4 };
+    EXPECT_EQ( words.erase_indices( drop.begin(), drop.end() ), 3u );
+    EXPECT_EQ( words, ( sc::vector<std::string>{ "a", "d" } ) );
+
+    sc::vector<Owner> owners;
+    for( auto i{0} ; i < 6 ; ++i )
+        owners.emplace_back( i );
+    owners.erase_indices( { 1, 2, 5 } );
+    ASSERT_EQ( owners.size(), 3u );
+    EXPECT_EQ( *owners[0].p, 0 );
+    EXPECT_EQ( *owners[1].p, 3 );
+    EXPECT_EQ( *owners[2].p, 4 );
+}
+
+TEST(EraseFamily, ThrowingPredicateKeepsTheRest)
+{
+    // Removes odd values, and throws on 7: the survivors so far and the unseen elements stay.
+    auto picky = []( const std::string & w ) {
+        if( w == "7" )
+            throw std::runtime_error( "seven" );
+        return std::stoi( w ) % 2 == 1;
+    };
+    sc::vector<std::string> words;
+    for( auto i{0} ; i < 10 ; ++i )
+        words.push_back( std::to_string( i ) );
+    EXPECT_THROW( words.remove_if( picky ), std::runtime_error );
+    EXPECT_EQ( words, ( sc::vector<std::string>{ "0", "2", "4", "6", "7", "8", "9" } ) );
+
+    sc::vector<Owner> owners;
+    for( auto i{0} ; i < 10 ; ++i )
+        owners.emplace_back( i );
+    EXPECT_THROW( owners.remove_if( []( const Owner & o ) {
+        if( *o.p == 7 )
+            throw std::runtime_error( "seven" );
+        return *o.p % 2 == 1;
+    } ), std::runtime_error );
+    int expected[] = { 0, 2, 4, 6, 7, 8, 9 };
+    ASSERT_EQ( owners.size(), 7u );
+    for( auto i{0u} ; i < owners.size() ; ++i )
+        ASSERT_EQ( *owners[i].p, expected[i] );
+}
 
 int main(int argc, char** argv)
 {
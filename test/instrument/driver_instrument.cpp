@@ -0,0 +1,150 @@
+#include <string>
+#include <sstream>
+
+#include "gtest/gtest.h"        // gtest lib
+#include "vector.h"             // header file for tested functions
+#include "small_vector.h"
+
+
+// ============================================================================
+// TESTING THE INSTRUMENTED BUILD OF VECTOR
+//
+// Built with SC_VECTOR_INSTRUMENT defined for the whole target (see CMakeLists.txt).
+// ============================================================================
+
+namespace {
+    // Element whose move may throw: relocations copy it.
+    struct Fragile
+    {
+        int value;
+        Fragile( int v ) : value{v} {}
+        Fragile( const Fragile & other ) : value{other.value} {}
+        Fragile( Fragile && other ) noexcept(false) : value{other.value} {}
+        Fragile & operator=( const Fragile & ) = default;
+    };
+}
+
+TEST(Instrument, CountsGrowth)
+{
+    sc::vector<int> vec;
+    for( auto i{0} ; i < 100 ; ++i )
+        vec.push_back( i );
+
+    // Capacities 1, 2, 4, ..., 128: eight storages, seven of them replaced one.
+    const sc::vector_stats & stats = vec.stats();
+    EXPECT_EQ( stats.allocations, 8u );
+    EXPECT_EQ( stats.reallocations, 7u );
+    EXPECT_EQ( stats.bytes_allocated, 255 * sizeof(int) );
+    EXPECT_EQ( stats.bytes_freed, 127 * sizeof(int) );
+    EXPECT_EQ( stats.elements_moved, 127u );
+    EXPECT_EQ( stats.elements_copied, 0u );
+    EXPECT_EQ( stats.peak_capacity, 128u );
+    EXPECT_EQ( stats.peak_size, 100u );
+
+    vec.reserve( 100 );
+    EXPECT_EQ( vec.stats().reallocations, 7u );
+}
+
+TEST(Instrument, CountsShifts)
+{
+    sc::vector<int> vec;
+    vec.reserve( 16 );
+    vec = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    vec.insert( vec.begin() + 2, 0 );
+    EXPECT_EQ( vec.stats().elements_moved, 6u );
+
+    vec.erase( vec.begin() );
+    EXPECT_EQ( vec.stats().elements_moved, 14u );
+
+    // Front slack after pop_front: push_front moves nothing.
+    vec.pop_front();
+    vec.push_front( 1 );
+    EXPECT_EQ( vec.stats().elements_moved, 14u );
+    EXPECT_EQ( vec.stats().allocations, 1u );
+    EXPECT_EQ( vec.stats().reallocations, 0u );
+}
+
+TEST(Instrument, PushFrontWithLittleBackSlack)
+{
+    // One free slot at the back, refilled by each pop_back: shifting into it would move the whole
+    // list every time, the front slack of one reallocation serves all the calls instead.
+    const size_t n = 100000;
+    sc::vector<int> vec;
+    vec.resize( n );
+    vec.reserve( n + 1 );
+    size_t moved = vec.stats().elements_moved;
+    size_t reallocations = vec.stats().reallocations;
+
+    for( auto i{0} ; i < 20000 ; ++i )
+    {
+        vec.push_front( i );
+        vec.pop_back();
+    }
+
+    EXPECT_EQ( vec.size(), n );
+    EXPECT_EQ( vec.front(), 19999 );
+    EXPECT_EQ( vec.stats().elements_moved - moved, n );
+    EXPECT_EQ( vec.stats().reallocations - reallocations, 1u );
+}
+
+TEST(Instrument, CopiesWhenMoveMayThrow)
+{
+    sc::vector<Fragile> vec;
+    for( auto i{0} ; i < 5 ; ++i )
+        vec.emplace_back( i );
+
+    // Relocations at capacities 1, 2 and 4.
+    EXPECT_EQ( vec.stats().elements_copied, 7u );
+    EXPECT_EQ( vec.stats().elements_moved, 0u );
+}
+
+TEST(Instrument, GlobalTotals)
+{
+    sc::instrument::reset();
+    {
+        sc::vector<int> a{ 1, 2, 3 };
+        sc::vector<std::string> b;
+        b.reserve( 10 );
+        b.emplace_back( "x" );
+        b.reserve( 20 );
+    }
+
+    sc::vector_stats totals = sc::instrument::global();
+    EXPECT_EQ( totals.allocations, 3u );
+    EXPECT_EQ( totals.reallocations, 1u );
+    EXPECT_EQ( totals.bytes_allocated, 3 * sizeof(int) + 30 * sizeof(std::string) );
+    EXPECT_EQ( totals.bytes_freed, totals.bytes_allocated );
+    EXPECT_EQ( totals.elements_moved, 1u );
+    EXPECT_EQ( totals.peak_capacity, 20u );
+    EXPECT_EQ( totals.peak_size, 3u );
+
+    sc::instrument::reset();
+    EXPECT_EQ( sc::instrument::global().allocations, 0u );
+}
+
+TEST(Instrument, SmallVectorInlineBuffer)
+{
+    sc::small_vector<int, 4> vec;
+    for( auto i{0} ; i < 5 ; ++i )
+        vec.push_back( i );
+
+    // The inline buffer counts as the first storage, the heap one replaced it.
+    EXPECT_EQ( vec.stats().allocations, 2u );
+    EXPECT_EQ( vec.stats().reallocations, 1u );
+    EXPECT_EQ( vec.stats().elements_moved, 4u );
+}
+
+TEST(Instrument, DumpJson)
+{
+    sc::instrument::reset();
+    sc::vector<int> vec{ 1, 2 };
+
+    std::string json = sc::instrument::to_json( vec.stats() );
+    EXPECT_EQ( json, "{\"allocations\": 1, \"reallocations\": 0, \"bytes_allocated\": 8, \"bytes_freed\": 0, "
+                     "\"elements_copied\": 0, \"elements_moved\": 0, \"peak_capacity\": 2, \"peak_size\": 2}" );
+
+    std::ostringstream os;
+    sc::instrument::dump_json( os );
+    EXPECT_EQ( os.str(), json );
+}